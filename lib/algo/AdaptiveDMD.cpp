@@ -26,7 +26,7 @@ AdaptiveDMD::AdaptiveDMD(int dim, double desired_dt, std::string rbf,
                          Vector* state_offset) :
     DMD(dim, alt_output_basis, state_offset)
 {
-    CAROM_VERIFY(rbf == "G" || rbf == "IQ" || rbf == "IMQ");
+    CAROM_VERIFY(rbf == "G" || rbf == "IQ" || rbf == "IMQ" || rbf == "W");
     CAROM_VERIFY(interp_method == "LS" || interp_method == "IDW"
                  || interp_method == "LP");
     CAROM_VERIFY(closest_rbf_val >= 0.0 && closest_rbf_val <= 1.0);
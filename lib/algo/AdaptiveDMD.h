@@ -41,7 +41,8 @@ public:
      *                             the different dt's between the samples.
      * @param[in] rbf              The RBF type ("G" == gaussian,
      *                             "IQ" == inverse quadratic,
-     *                             "IMQ" == inverse multiquadric)
+     *                             "IMQ" == inverse multiquadric,
+     *                             "W" == compactly supported Wendland)
      * @param[in] interp_method    The interpolation method type
      *                             ("LS" == linear solve,
      *                             "IDW" == inverse distance weighting,
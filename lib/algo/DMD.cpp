@@ -12,6 +12,7 @@
 
 #include "DMD.h"
 
+#include "linalg/BasisReader.h"
 #include "linalg/Matrix.h"
 #include "linalg/Vector.h"
 #include "linalg/scalapack_wrapper.h"
@@ -20,7 +21,11 @@
 #include "utils/HDFDatabase.h"
 #include "mpi.h"
 
+#include <algorithm>
+#include <cmath>
+#include <climits>
 #include <cstring>
+#include <typeinfo>
 
 /* Use C++11 built-in shared pointers if available; else fallback to Boost. */
 #if __cplusplus >= 201103L
@@ -43,6 +48,29 @@ extern "C" {
 
 namespace CAROM {
 
+namespace {
+
+// Reads snapshots [first, last) of a snapshot file, minus the state offset.
+Matrix*
+readSnapshotBlock(BasisReader& reader, int first, int last,
+                  const Vector* state_offset)
+{
+    Matrix* block = reader.getSnapshotMatrix(first + 1, last);
+    if (state_offset)
+    {
+        for (int i = 0; i < block->numRows(); i++)
+        {
+            for (int j = 0; j < block->numColumns(); j++)
+            {
+                block->item(i, j) -= state_offset->item(i);
+            }
+        }
+    }
+    return block;
+}
+
+}
+
 DMD::DMD(int dim, bool alt_output_basis, Vector* state_offset)
 {
     CAROM_VERIFY(dim > 0);
@@ -223,6 +251,27 @@ void DMD::train(int k, const Matrix* W0, double linearity_tol)
     delete f_snapshots;
 }
 
+void DMD::trainOutOfCore(const std::string& snapshot_file,
+                         double energy_fraction,
+                         int block_size,
+                         Database::formats format)
+{
+    CAROM_VERIFY(energy_fraction > 0 && energy_fraction <= 1);
+    d_energy_fraction = energy_fraction;
+    constructDMDOutOfCore(snapshot_file, block_size, format);
+}
+
+void DMD::trainOutOfCore(const std::string& snapshot_file,
+                         int k,
+                         int block_size,
+                         Database::formats format)
+{
+    CAROM_VERIFY(k > 0);
+    d_energy_fraction = -1.0;
+    d_k = k;
+    constructDMDOutOfCore(snapshot_file, block_size, format);
+}
+
 std::pair<Matrix*, Matrix*>
 DMD::computeDMDSnapshotPair(const Matrix* snapshots)
 {
@@ -295,6 +344,8 @@ DMD::constructDMD(const Matrix* f_snapshots,
     Matrix* f_snapshots_out = f_snapshot_pair.second;
 
     int *row_offset = new int[d_num_procs + 1];
+    // ScaLAPACK indexes the rows with int.
+    CAROM_VERIFY(f_snapshots_in->numDistributedRows() <= INT_MAX);
     row_offset[d_num_procs] = f_snapshots_in->numDistributedRows();
     row_offset[d_rank] = f_snapshots_in->numRows();
 
@@ -339,7 +390,8 @@ DMD::constructDMD(const Matrix* f_snapshots,
 
     // Compute how many basis vectors we will actually use.
     d_num_singular_vectors = std::min(f_snapshots_in->numColumns(),
-                                      f_snapshots_in->numDistributedRows());
+                                      static_cast<int>(
+                                          f_snapshots_in->numDistributedRows()));
     for (int i = 0; i < d_num_singular_vectors; i++)
     {
         d_sv.push_back(d_factorizer->S[i]);
@@ -537,6 +589,189 @@ DMD::constructDMD(const Matrix* f_snapshots,
     release_context(&svd_input);
 }
 
+void
+DMD::constructDMDOutOfCore(const std::string& snapshot_file,
+                           int block_size,
+                           Database::formats format)
+{
+    // The out-of-core path forms the uniform snapshot pair and the modes
+    // itself, so it would bypass the computeDMDSnapshotPair and computePhi
+    // of derived models.
+    CAROM_VERIFY(typeid(*this) == typeid(DMD));
+    CAROM_VERIFY(d_dt > 0.0);
+    CAROM_VERIFY(block_size > 0);
+
+    BasisReader reader(snapshot_file, format, d_dim);
+    CAROM_VERIFY(reader.getDim("snapshot") == d_dim);
+    const int num_snapshots = reader.getNumSamples("snapshot");
+    CAROM_VERIFY(num_snapshots > 1);
+    const int m = num_snapshots - 1;
+    CAROM_VERIFY(d_energy_fraction != -1.0 || d_k <= m);
+
+    // First pass: the Gram matrix of all snapshots, one pair of blocks at a
+    // time.
+    Matrix gram(num_snapshots, num_snapshots, false);
+    for (int i0 = 0; i0 < num_snapshots; i0 += block_size)
+    {
+        const int i1 = std::min(i0 + block_size, num_snapshots);
+        Matrix* block_i = readSnapshotBlock(reader, i0, i1, d_state_offset);
+        for (int j0 = i0; j0 < num_snapshots; j0 += block_size)
+        {
+            const int j1 = std::min(j0 + block_size, num_snapshots);
+            Matrix* block_j = (j0 == i0) ? block_i :
+                              readSnapshotBlock(reader, j0, j1, d_state_offset);
+            Matrix* product = block_i->transposeMult(*block_j);
+            for (int i = i0; i < i1; i++)
+            {
+                for (int j = j0; j < j1; j++)
+                {
+                    gram.item(i, j) = product->item(i - i0, j - j0);
+                    gram.item(j, i) = gram.item(i, j);
+                }
+            }
+            delete product;
+            if (block_j != block_i) delete block_j;
+        }
+        delete block_i;
+    }
+
+    // X^T X and X^T X' of the snapshots_in X and snapshots_out X'.
+    Matrix XtX(m, m, false);
+    Matrix XtXp(m, m, false);
+    for (int i = 0; i < m; i++)
+    {
+        for (int j = 0; j < m; j++)
+        {
+            XtX.item(i, j) = gram.item(i, j);
+            XtXp.item(i, j) = gram.item(i, j + 1);
+        }
+    }
+
+    // X^T X = V S^2 V^T, with eigenvalues in increasing order.
+    EigenPair eigenpair = SymmetricRightEigenSolve(&XtX);
+    std::vector<double> sv(m);
+    for (int i = 0; i < m; i++)
+    {
+        sv[i] = std::sqrt(std::max(eigenpair.eigs[m - 1 - i], 0.0));
+    }
+
+    // Discard directions lost to the squared condition number.
+    d_num_singular_vectors = 0;
+    while (d_num_singular_vectors < m &&
+            sv[d_num_singular_vectors] > 1.0e-7 * sv[0])
+    {
+        d_num_singular_vectors++;
+    }
+    d_sv.assign(sv.begin(), sv.begin() + d_num_singular_vectors);
+
+    if (d_energy_fraction != -1.0)
+    {
+        d_k = d_num_singular_vectors;
+        if (d_energy_fraction < 1.0)
+        {
+            double total_energy = 0.0;
+            for (int i = 0; i < d_num_singular_vectors; i++)
+            {
+                total_energy += sv[i];
+            }
+            double current_energy = 0.0;
+            for (int i = 0; i < d_num_singular_vectors; i++)
+            {
+                current_energy += sv[i];
+                if (current_energy / total_energy >= d_energy_fraction)
+                {
+                    d_k = i + 1;
+                    break;
+                }
+            }
+        }
+    }
+    d_k = std::min(d_k, d_num_singular_vectors);
+    CAROM_VERIFY(d_k > 0);
+
+    if (d_rank == 0) std::cout << "Using " << d_k << " basis vectors out of " <<
+                                   d_num_singular_vectors << "." << std::endl;
+
+    // VS = V S^(-1), so that the left singular vectors are U = X VS.
+    Matrix VS(m, d_k, false);
+    for (int i = 0; i < m; i++)
+    {
+        for (int j = 0; j < d_k; j++)
+        {
+            VS.item(i, j) = eigenpair.ev->item(i, m - 1 - j) / sv[j];
+        }
+    }
+    delete eigenpair.ev;
+
+    // A_tilde = U^T X' V S^(-1) = VS^T X^T X' VS.
+    Matrix* XtXp_VS = XtXp.mult(VS);
+    delete d_A_tilde;
+    d_A_tilde = VS.transposeMult(XtXp_VS);
+    delete XtXp_VS;
+
+    ComplexEigenPair A_tilde_eigenpair = NonSymmetricRightEigenSolve(d_A_tilde);
+    d_eigs = A_tilde_eigenpair.eigs;
+    Matrix* coeffs_real = VS.mult(A_tilde_eigenpair.ev_real);
+    Matrix* coeffs_imaginary = VS.mult(A_tilde_eigenpair.ev_imaginary);
+    delete A_tilde_eigenpair.ev_real;
+    delete A_tilde_eigenpair.ev_imaginary;
+
+    // Second pass: U = X VS and phi = U W = X VS W, or phi = X' VS W with
+    // the alternative output basis.
+    delete d_basis;
+    delete d_phi_real;
+    delete d_phi_imaginary;
+    d_basis = new Matrix(d_dim, d_k, true);
+    d_phi_real = new Matrix(d_dim, d_k, true);
+    d_phi_imaginary = new Matrix(d_dim, d_k, true);
+    *d_basis = 0.0;
+    *d_phi_real = 0.0;
+    *d_phi_imaginary = 0.0;
+    Vector init(d_dim, true);
+    for (int j0 = 0; j0 < num_snapshots; j0 += block_size)
+    {
+        const int j1 = std::min(j0 + block_size, num_snapshots);
+        Matrix* block = readSnapshotBlock(reader, j0, j1, d_state_offset);
+        for (int i = 0; i < d_dim; i++)
+        {
+            for (int j = j0; j < j1; j++)
+            {
+                const double x = block->item(i, j - j0);
+                if (j == 0)
+                {
+                    init.item(i) = x;
+                }
+                if (j < m)
+                {
+                    for (int l = 0; l < d_k; l++)
+                    {
+                        d_basis->item(i, l) += x * VS.item(j, l);
+                    }
+                }
+                const int phi_col = d_alt_output_basis ? j - 1 : j;
+                if (phi_col >= 0 && phi_col < m)
+                {
+                    for (int l = 0; l < d_k; l++)
+                    {
+                        d_phi_real->item(i, l) += x * coeffs_real->item(phi_col, l);
+                        d_phi_imaginary->item(i, l) +=
+                            x * coeffs_imaginary->item(phi_col, l);
+                    }
+                }
+            }
+        }
+        delete block;
+    }
+    delete coeffs_real;
+    delete coeffs_imaginary;
+
+    // The snapshots are sampled every d_dt from t = 0.
+    d_t_offset = 0.0;
+    projectInitialCondition(&init);
+
+    d_trained = true;
+}
+
 void
 DMD::projectInitialCondition(const Vector* init, double t_offset)
 {
@@ -796,8 +1031,11 @@ DMD::load(std::string base_file_name)
     database.close();
 
     full_file_name = base_file_name + "_basis";
-    d_basis = new Matrix();
-    d_basis->read(full_file_name);
+    if (Utilities::file_exist(full_file_name + ".000000"))
+    {
+        d_basis = new Matrix();
+        d_basis->read(full_file_name);
+    }
 
     full_file_name = base_file_name + "_A_tilde";
     d_A_tilde = new Matrix();
@@ -812,12 +1050,15 @@ DMD::load(std::string base_file_name)
     d_phi_imaginary->read(full_file_name);
 
     full_file_name = base_file_name + "_phi_real_squared_inverse";
-    d_phi_real_squared_inverse = new Matrix();
-    d_phi_real_squared_inverse->read(full_file_name);
+    if (Utilities::file_exist(full_file_name + ".000000"))
+    {
+        d_phi_real_squared_inverse = new Matrix();
+        d_phi_real_squared_inverse->read(full_file_name);
 
-    full_file_name = base_file_name + "_phi_imaginary_squared_inverse";
-    d_phi_imaginary_squared_inverse = new Matrix();
-    d_phi_imaginary_squared_inverse->read(full_file_name);
+        full_file_name = base_file_name + "_phi_imaginary_squared_inverse";
+        d_phi_imaginary_squared_inverse = new Matrix();
+        d_phi_imaginary_squared_inverse->read(full_file_name);
+    }
 
     full_file_name = base_file_name + "_projected_init_real";
     d_projected_init_real = new Vector();
@@ -908,11 +1149,14 @@ DMD::save(std::string base_file_name)
     full_file_name = base_file_name + "_phi_imaginary";
     d_phi_imaginary->write(full_file_name);
 
-    full_file_name = base_file_name + "_phi_real_squared_inverse";
-    d_phi_real_squared_inverse->write(full_file_name);
+    if (d_phi_real_squared_inverse != NULL)
+    {
+        full_file_name = base_file_name + "_phi_real_squared_inverse";
+        d_phi_real_squared_inverse->write(full_file_name);
 
-    full_file_name = base_file_name + "_phi_imaginary_squared_inverse";
-    d_phi_imaginary_squared_inverse->write(full_file_name);
+        full_file_name = base_file_name + "_phi_imaginary_squared_inverse";
+        d_phi_imaginary_squared_inverse->write(full_file_name);
+    }
 
     full_file_name = base_file_name + "_projected_init_real";
     d_projected_init_real->write(full_file_name);
@@ -19,8 +19,10 @@
 #define included_DMD_h
 
 #include "ParametricDMD.h"
+#include "utils/Database.h"
 #include <vector>
 #include <complex>
+#include <string>
 
 namespace CAROM {
 
@@ -134,6 +136,53 @@ public:
      */
     virtual void train(int k, const Matrix* W0 = NULL, double linearity_tol = 0.0);
 
+    /**
+     * @brief Train the DMD model with energy fraction criterion from the
+     *        snapshots in a file written by BasisWriter, without holding
+     *        them in memory.
+     *
+     * The snapshots are taken to be sampled every dt starting at t = 0 and
+     * are read in blocks of block_size columns. The first pass accumulates
+     * the Gram matrix of the snapshots, which gives X^T X and X^T X' of
+     * the input and shifted snapshots, block pair by block pair, so that at
+     * most two blocks are in memory and each block is read at most
+     * (number of blocks + 1) / 2 times on average. A second pass forms the
+     * modes. Taking the SVD of X from X^T X squares its condition number,
+     * so singular values below about 1e-7 of the largest are discarded.
+     *
+     * Only plain DMD models can be trained out of core; derived models such
+     * as NonuniformDMD, AdaptiveDMD and KernelDMD are rejected.
+     *
+     * @pre The object is a DMD, not an object of a derived class
+     * @pre dt > 0
+     * @pre block_size > 0
+     *
+     * @param[in] snapshot_file   The snapshot file, as passed to BasisReader.
+     * @param[in] energy_fraction The energy fraction to keep after doing SVD.
+     * @param[in] block_size      The number of snapshots read at a time.
+     * @param[in] format          The format of the snapshot file.
+     */
+    void trainOutOfCore(const std::string& snapshot_file,
+                        double energy_fraction,
+                        int block_size = 64,
+                        Database::formats format = Database::formats::HDF5);
+
+    /**
+     * @brief Train the DMD model with specified reduced dimension from the
+     *        snapshots in a file written by BasisWriter, without holding
+     *        them in memory. See the energy fraction variant, including
+     *        its restriction to plain DMD models.
+     *
+     * @param[in] snapshot_file   The snapshot file, as passed to BasisReader.
+     * @param[in] k               The number of modes to keep after doing SVD.
+     * @param[in] block_size      The number of snapshots read at a time.
+     * @param[in] format          The format of the snapshot file.
+     */
+    void trainOutOfCore(const std::string& snapshot_file,
+                        int k,
+                        int block_size = 64,
+                        Database::formats format = Database::formats::HDF5);
+
     /**
      * @brief Project new initial condition using d_phi.
      *        Calculate pinv(phi) x init, or more precisely,
@@ -142,7 +191,8 @@ public:
      * @param[in] init     The initial condition.
      * @param[in] t_offset The initial time offset.
      */
-    void projectInitialCondition(const Vector* init, double t_offset = -1.0);
+    virtual void projectInitialCondition(const Vector* init,
+                                         double t_offset = -1.0);
 
     /**
      * @brief Predict state given a time. Uses the projected initial condition of the
@@ -173,6 +223,14 @@ public:
         return d_k;
     }
 
+    /**
+     * @brief Returns the DMD eigenvalues.
+     */
+    const std::vector<std::complex<double>>& getEigs() const
+    {
+        return d_eigs;
+    }
+
     /**
      * @brief Get the snapshot matrix contained within d_snapshots.
      */
@@ -227,7 +285,8 @@ protected:
      * @param[in] desired_point     The desired point at which to create a parametric DMD.
      * @param[in] rbf               The RBF type ("G" == gaussian,
      *                              "IQ" == inverse quadratic,
-     *                              "IMQ" == inverse multiquadric)
+     *                              "IMQ" == inverse multiquadric,
+     *                              "W" == compactly supported Wendland)
      * @param[in] interp_method     The interpolation method type
      *                              ("LS" == linear solve,
      *                              "IDW" == inverse distance weighting,
@@ -245,6 +304,15 @@ protected:
                                       double closest_rbf_val,
                                       bool reorthogonalize_W);
 
+    /**
+     * @brief DMDPredictor converts the trained modes and projected initial
+     *        condition to the precision of the online stage.
+     */
+    template <class Scalar>
+    friend class DMDPredictor;
+
+    friend class WindowedDMD;
+
     /**
      * @brief Constructor. Variant of DMD with non-uniform time step size.
      *
@@ -301,6 +369,13 @@ protected:
                       const Matrix* W0,
                       double linearity_tol);
 
+    /**
+     * @brief Construct the DMD object from snapshots streamed from a file.
+     */
+    void constructDMDOutOfCore(const std::string& snapshot_file,
+                               int block_size,
+                               Database::formats format);
+
     /**
      * @brief Returns a pair of pointers to the minus and plus snapshot matrices
      */
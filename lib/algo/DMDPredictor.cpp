@@ -0,0 +1,96 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2013-2024, Lawrence Livermore National Security, LLC
+ * and other libROM project developers. See the top-level COPYRIGHT
+ * file for details.
+ *
+ * SPDX-License-Identifier: (Apache-2.0 OR MIT)
+ *
+ *****************************************************************************/
+
+// Description: Evaluates the predictions of a trained DMD model with its
+//              modes stored in a chosen precision, e.g. single precision.
+
+#include "DMDPredictor.h"
+#include "DMD.h"
+#include "NonuniformDMD.h"
+#include "linalg/Matrix.h"
+#include "linalg/Vector.h"
+#include "utils/Utilities.h"
+
+namespace CAROM {
+
+template <class Scalar>
+DMDPredictor<Scalar>::DMDPredictor(
+    const DMD& dmd) :
+    d_eigs(dmd.d_eigs),
+    d_dt(dmd.d_dt),
+    d_t_offset(dmd.d_t_offset)
+{
+    CAROM_VERIFY(dmd.d_phi_real != NULL && dmd.d_phi_imaginary != NULL);
+    CAROM_VERIFY(dmd.d_trained);
+    CAROM_VERIFY(dmd.d_init_projected);
+    CAROM_VERIFY(dynamic_cast<const NonuniformDMD*>(&dmd) == NULL);
+
+    d_phi_real = OnlineMatrix<Scalar>(*dmd.d_phi_real);
+    d_phi_imaginary = OnlineMatrix<Scalar>(*dmd.d_phi_imaginary);
+
+    const int k = d_eigs.size();
+    CAROM_VERIFY(d_phi_real.numColumns() == k);
+    d_projected_init.resize(k);
+    for (int i = 0; i < k; ++i)
+    {
+        d_projected_init[i] = std::complex<double>(
+                                  dmd.d_projected_init_real->item(i),
+                                  dmd.d_projected_init_imaginary->item(i));
+    }
+    if (dmd.d_state_offset)
+    {
+        d_state_offset = OnlineVector<Scalar>(*dmd.d_state_offset);
+    }
+    d_amplitudes_real.setSize(k);
+    d_amplitudes_imaginary.setSize(k);
+}
+
+template <class Scalar>
+void
+DMDPredictor<Scalar>::predict(
+    double t,
+    OnlineVector<Scalar>& result,
+    int deg)
+{
+    CAROM_VERIFY(t >= 0.0);
+
+    t -= d_t_offset;
+    const int k = d_eigs.size();
+    for (int i = 0; i < k; ++i)
+    {
+        std::complex<double> amplitude = std::pow(d_eigs[i], t / d_dt);
+        for (int d = 0; d < deg; ++d)
+        {
+            amplitude *= d_eigs[i];
+        }
+        amplitude *= d_projected_init[i];
+        d_amplitudes_real(i) = amplitude.real();
+        d_amplitudes_imaginary(i) = amplitude.imag();
+    }
+
+    d_phi_real.mult(d_amplitudes_real, result);
+    d_phi_imaginary.mult(d_amplitudes_imaginary, d_work);
+    Scalar* x = result.getData();
+    const Scalar* w = d_work.getData();
+    for (int i = 0; i < result.dim(); ++i)
+        x[i] -= w[i];
+    if (d_state_offset.dim() > 0)
+    {
+        CAROM_VERIFY(d_state_offset.dim() == result.dim());
+        const Scalar* offset = d_state_offset.getData();
+        for (int i = 0; i < result.dim(); ++i)
+            x[i] += offset[i];
+    }
+}
+
+template class DMDPredictor<float>;
+template class DMDPredictor<double>;
+
+}
@@ -0,0 +1,126 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2013-2024, Lawrence Livermore National Security, LLC
+ * and other libROM project developers. See the top-level COPYRIGHT
+ * file for details.
+ *
+ * SPDX-License-Identifier: (Apache-2.0 OR MIT)
+ *
+ *****************************************************************************/
+
+// Description: Evaluates the predictions of a trained DMD model with its
+//              modes stored in a chosen precision, e.g. single precision.
+
+#ifndef included_DMDPredictor_h
+#define included_DMDPredictor_h
+
+#include "linalg/OnlineLinearAlgebra.h"
+#include <complex>
+#include <vector>
+
+namespace CAROM {
+
+class DMD;
+
+/**
+ * Class DMDPredictor copies the modes, eigenvalues, projected initial
+ * condition and state offset of a trained DMD into Scalar storage and
+ * evaluates
+ *
+ *     x(t) = Re(Phi diag(lambda^((t - t_offset) / dt + deg)) b) + offset.
+ *
+ * The mode amplitudes diag(lambda^(...)) b are k complex numbers and are
+ * computed in double; only the product with the modes, which dominates the
+ * cost and memory traffic, runs in Scalar. With Scalar = float the modes take
+ * half the memory of the trained double model.
+ */
+template <class Scalar>
+class DMDPredictor
+{
+public:
+    /**
+     * @brief Constructor converting a trained DMD.
+     *
+     * @pre The DMD is trained and its initial condition is projected.
+     * @pre The DMD uses discrete eigenvalues, i.e. it is not a
+     *      NonuniformDMD.
+     *
+     * @param[in] dmd The trained DMD model.
+     */
+    explicit DMDPredictor(
+        const DMD& dmd);
+
+    /**
+     * @brief Predicts the state at time t.
+     *
+     * @pre t >= 0.0
+     *
+     * @param[in] t The time of the prediction.
+     * @param[out] result The predicted state, distributed like the modes and
+     *                    resized if needed.
+     * @param[in] deg The derivative degree of the prediction, as in
+     *                DMD::predict.
+     */
+    void
+    predict(
+        double t,
+        OnlineVector<Scalar>& result,
+        int deg = 0);
+
+    /**
+     * @brief Returns the number of modes.
+     */
+    int
+    getDimension() const
+    {
+        return d_eigs.size();
+    }
+
+private:
+    /**
+     * @brief The real part of the modes.
+     */
+    OnlineMatrix<Scalar> d_phi_real;
+
+    /**
+     * @brief The imaginary part of the modes.
+     */
+    OnlineMatrix<Scalar> d_phi_imaginary;
+
+    /**
+     * @brief The eigenvalues.
+     */
+    std::vector<std::complex<double>> d_eigs;
+
+    /**
+     * @brief The projected initial condition.
+     */
+    std::vector<std::complex<double>> d_projected_init;
+
+    /**
+     * @brief The state offset, empty if the DMD has none.
+     */
+    OnlineVector<Scalar> d_state_offset;
+
+    /**
+     * @brief The time step size and the time offset of the first sample.
+     */
+    double d_dt;
+    double d_t_offset;
+
+    /**
+     * @brief The real and imaginary parts of the mode amplitudes at the
+     *        predicted time.
+     */
+    OnlineVector<Scalar> d_amplitudes_real;
+    OnlineVector<Scalar> d_amplitudes_imaginary;
+
+    /**
+     * @brief Work space for the contribution of the imaginary part.
+     */
+    OnlineVector<Scalar> d_work;
+};
+
+}
+
+#endif
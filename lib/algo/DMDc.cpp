@@ -21,6 +21,7 @@
 #include "utils/HDFDatabase.h"
 #include "mpi.h"
 
+#include <climits>
 #include <cstring>
 
 /* Use C++11 built-in shared pointers if available; else fallback to Boost. */
@@ -302,6 +303,8 @@ DMDc::constructDMDc(const Matrix* f_snapshots,
     Matrix* f_snapshots_out = f_snapshot_pair.second;
 
     int *row_offset = new int[d_num_procs + 1];
+    // ScaLAPACK indexes the rows with int.
+    CAROM_VERIFY(f_snapshots_in->numDistributedRows() <= INT_MAX);
     row_offset[d_num_procs] = f_snapshots_in->numDistributedRows();
     row_offset[d_rank] = f_snapshots_in->numRows();
 
@@ -346,7 +349,8 @@ DMDc::constructDMDc(const Matrix* f_snapshots,
 
     // Compute how many basis vectors we will actually use.
     d_num_singular_vectors = std::min(f_snapshots_in->numColumns(),
-                                      f_snapshots_in->numDistributedRows());
+                                      static_cast<int>(
+                                          f_snapshots_in->numDistributedRows()));
     for (int i = 0; i < d_num_singular_vectors; i++)
     {
         d_sv.push_back(d_factorizer_in->S[i]);
@@ -415,6 +419,8 @@ DMDc::constructDMDc(const Matrix* f_snapshots,
     if (B == NULL)
     {
         // SVD on outputs
+        // ScaLAPACK indexes the rows with int.
+        CAROM_VERIFY(f_snapshots_out->numDistributedRows() <= INT_MAX);
         row_offset[d_num_procs] = f_snapshots_out->numDistributedRows();
         row_offset[d_rank] = f_snapshots_out->numRows();
 
@@ -459,7 +465,8 @@ DMDc::constructDMDc(const Matrix* f_snapshots,
 
         // Compute how many basis vectors we will actually use.
         d_num_singular_vectors = std::min(f_snapshots_out->numColumns(),
-                                          f_snapshots_out->numDistributedRows());
+                                          static_cast<int>(
+                                              f_snapshots_out->numDistributedRows()));
         for (int i = 0; i < d_num_singular_vectors; i++)
         {
             d_sv.push_back(d_factorizer_out->S[i]);
@@ -0,0 +1,422 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2013-2024, Lawrence Livermore National Security, LLC
+ * and other libROM project developers. See the top-level COPYRIGHT
+ * file for details.
+ *
+ * SPDX-License-Identifier: (Apache-2.0 OR MIT)
+ *
+ *****************************************************************************/
+
+// Description: Implementation of the kernel DMD algorithm.
+
+#include "KernelDMD.h"
+
+#include "linalg/Matrix.h"
+#include "linalg/Vector.h"
+#include "utils/HDFDatabase.h"
+#include "utils/Utilities.h"
+#include "mpi.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace CAROM {
+
+namespace {
+
+// The kernel types, indexed as they are saved.
+const char* const kernel_names[] = {"LIN", "POLY", "G"};
+const int num_kernels = 3;
+
+}
+
+KernelDMD::KernelDMD(int dim, double dt, std::string kernel,
+                     double kernel_param, int block_size) :
+    DMD(dim, dt),
+    d_kernel(kernel),
+    d_kernel_param(kernel_param),
+    d_block_size(block_size)
+{
+    CAROM_VERIFY(kernel == "LIN" || kernel == "POLY" || kernel == "G");
+    CAROM_VERIFY(kernel == "LIN" || kernel_param > 0.0);
+    CAROM_VERIFY(block_size > 0);
+}
+
+KernelDMD::KernelDMD(std::string base_file_name) : DMD(base_file_name)
+{
+    loadKernelState(base_file_name);
+}
+
+KernelDMD::~KernelDMD()
+{
+    delete d_eigfunc_real;
+    delete d_eigfunc_imaginary;
+}
+
+void KernelDMD::train(double energy_fraction, const Matrix* W0,
+                      double linearity_tol)
+{
+    CAROM_VERIFY(W0 == NULL);
+    CAROM_VERIFY(d_snapshots.size() > 1);
+    CAROM_VERIFY(energy_fraction > 0 && energy_fraction <= 1);
+    d_energy_fraction = energy_fraction;
+    constructKernelDMD();
+}
+
+void KernelDMD::train(int k, const Matrix* W0, double linearity_tol)
+{
+    CAROM_VERIFY(W0 == NULL);
+    CAROM_VERIFY(d_snapshots.size() > 1);
+    CAROM_VERIFY(k > 0 && k <= static_cast<int>(d_snapshots.size()) - 1);
+    d_energy_fraction = -1.0;
+    d_k = k;
+    constructKernelDMD();
+}
+
+double
+KernelDMD::kernel(double xy, double xx, double yy) const
+{
+    if (d_kernel == "LIN")
+    {
+        return xy;
+    }
+    else if (d_kernel == "POLY")
+    {
+        return std::pow(1.0 + xy, d_kernel_param);
+    }
+
+    const double dist2 = std::max(xx + yy - 2.0 * xy, 0.0);
+    return std::exp(-dist2 / (2.0 * d_kernel_param * d_kernel_param));
+}
+
+Matrix*
+KernelDMD::computeInnerProducts() const
+{
+    const int n = d_snapshots.size();
+    Matrix* inner = new Matrix(n, n, false);
+    std::vector<double> block;
+
+    // Column block [j0, j1) of the lower triangle, rows j0 to n - 1.
+    for (int j0 = 0; j0 < n; j0 += d_block_size)
+    {
+        const int j1 = std::min(j0 + d_block_size, n);
+        const int width = j1 - j0;
+        block.assign(static_cast<size_t>(n - j0) * width, 0.0);
+        for (int i = j0; i < n; ++i)
+        {
+            const Vector* xi = d_snapshots[i];
+            for (int j = j0; j < std::min(i + 1, j1); ++j)
+            {
+                const Vector* xj = d_snapshots[j];
+                double sum = 0.0;
+                for (int r = 0; r < d_dim; ++r)
+                    sum += xi->item(r) * xj->item(r);
+                block[static_cast<size_t>(i - j0) * width + j - j0] = sum;
+            }
+        }
+
+        if (d_num_procs > 1)
+        {
+            CAROM_VERIFY(MPI_Allreduce(MPI_IN_PLACE, block.data(),
+                                       static_cast<int>(block.size()),
+                                       MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD)
+                         == MPI_SUCCESS);
+        }
+
+        for (int i = j0; i < n; ++i)
+        {
+            for (int j = j0; j < std::min(i + 1, j1); ++j)
+            {
+                const double v = block[static_cast<size_t>(i - j0) * width + j - j0];
+                inner->item(i, j) = v;
+                inner->item(j, i) = v;
+            }
+        }
+    }
+
+    return inner;
+}
+
+void
+KernelDMD::constructKernelDMD()
+{
+    const int m = d_snapshots.size() - 1;
+
+    // Gram matrices G(i, j) = k(x_i, x_j) and A(i, j) = k(y_i, x_j), where
+    // x_i is snapshot i and y_i = x_{i+1}.
+    Matrix* inner = computeInnerProducts();
+    Matrix G(m, m, false);
+    Matrix A(m, m, false);
+    d_sq_norms.resize(m);
+    for (int i = 0; i < m; ++i)
+    {
+        d_sq_norms[i] = inner->item(i, i);
+        for (int j = 0; j < m; ++j)
+        {
+            G.item(i, j) = kernel(inner->item(i, j), inner->item(i, i),
+                                  inner->item(j, j));
+            A.item(i, j) = kernel(inner->item(i + 1, j),
+                                  inner->item(i + 1, i + 1),
+                                  inner->item(j, j));
+        }
+    }
+    delete inner;
+
+    // G = Q Sigma^2 Q^T, with eigenvalues in decreasing order.
+    EigenPair eigenpair = SymmetricRightEigenSolve(&G);
+    std::vector<double> sv(m);
+    for (int i = 0; i < m; ++i)
+        sv[i] = std::sqrt(std::max(eigenpair.eigs[m - 1 - i], 0.0));
+
+    // Discard directions of numerically zero eigenvalue.
+    d_num_singular_vectors = 0;
+    while (d_num_singular_vectors < m &&
+            sv[d_num_singular_vectors] > 1.0e-7 * sv[0])
+    {
+        ++d_num_singular_vectors;
+    }
+    d_sv.assign(sv.begin(), sv.begin() + d_num_singular_vectors);
+
+    if (d_energy_fraction != -1.0)
+    {
+        d_k = d_num_singular_vectors;
+        if (d_energy_fraction < 1.0)
+        {
+            double total_energy = 0.0;
+            for (int i = 0; i < d_num_singular_vectors; i++)
+                total_energy += sv[i];
+            double current_energy = 0.0;
+            for (int i = 0; i < d_num_singular_vectors; i++)
+            {
+                current_energy += sv[i];
+                if (current_energy / total_energy >= d_energy_fraction)
+                {
+                    d_k = i + 1;
+                    break;
+                }
+            }
+        }
+    }
+    d_k = std::min(d_k, d_num_singular_vectors);
+    CAROM_VERIFY(d_k > 0);
+
+    if (d_rank == 0) std::cout << "Using " << d_k << " basis vectors out of " <<
+                                   d_num_singular_vectors << "." << std::endl;
+
+    // QS = Q Sigma^{-1}.
+    Matrix QS(m, d_k, false);
+    for (int i = 0; i < m; ++i)
+        for (int l = 0; l < d_k; ++l)
+            QS.item(i, l) = eigenpair.ev->item(i, m - 1 - l) / sv[l];
+    delete eigenpair.ev;
+
+    // K = Sigma^{-1} Q^T A Q Sigma^{-1}.
+    Matrix* AQS = A.mult(QS);
+    delete d_A_tilde;
+    d_A_tilde = QS.transposeMult(AQS);
+    delete AQS;
+
+    ComplexEigenPair koopman = NonSymmetricRightEigenSolve(d_A_tilde);
+    d_eigs = koopman.eigs;
+
+    // Eigenfunctions at x: k(x, X) Q Sigma^{-1} V.
+    delete d_eigfunc_real;
+    delete d_eigfunc_imaginary;
+    d_eigfunc_real = QS.mult(koopman.ev_real);
+    d_eigfunc_imaginary = QS.mult(koopman.ev_imaginary);
+
+    // Koopman modes of the state: X Q Sigma^{-1} V^{-T}. Invert V through
+    // the real form [Vr -Vi; Vi Vr] of the complex matrix.
+    const int k = d_k;
+    Matrix Vblock(2 * k, 2 * k, false);
+    for (int i = 0; i < k; ++i)
+    {
+        for (int j = 0; j < k; ++j)
+        {
+            const double vr = koopman.ev_real->item(i, j);
+            const double vi = koopman.ev_imaginary->item(i, j);
+            Vblock.item(i, j) = vr;
+            Vblock.item(i, j + k) = -vi;
+            Vblock.item(i + k, j) = vi;
+            Vblock.item(i + k, j + k) = vr;
+        }
+    }
+    Vblock.inverse();
+    delete koopman.ev_real;
+    delete koopman.ev_imaginary;
+
+    Matrix Vinv_real_T(k, k, false);
+    Matrix Vinv_imaginary_T(k, k, false);
+    for (int i = 0; i < k; ++i)
+    {
+        for (int j = 0; j < k; ++j)
+        {
+            Vinv_real_T.item(j, i) = Vblock.item(i, j);
+            Vinv_imaginary_T.item(j, i) = Vblock.item(i + k, j);
+        }
+    }
+
+    Matrix XQS(d_dim, k, true);
+    for (int r = 0; r < d_dim; ++r)
+    {
+        for (int l = 0; l < k; ++l)
+        {
+            double sum = 0.0;
+            for (int j = 0; j < m; ++j)
+                sum += d_snapshots[j]->item(r) * QS.item(j, l);
+            XQS.item(r, l) = sum;
+        }
+    }
+
+    delete d_phi_real;
+    delete d_phi_imaginary;
+    d_phi_real = XQS.mult(Vinv_real_T);
+    d_phi_imaginary = XQS.mult(Vinv_imaginary_T);
+
+    projectInitialCondition(d_snapshots[0]);
+
+    d_trained = true;
+}
+
+void
+KernelDMD::projectInitialCondition(const Vector* init, double t_offset)
+{
+    CAROM_VERIFY(d_eigfunc_real != NULL);
+    CAROM_VERIFY(init->dim() == d_dim);
+    const int m = d_sq_norms.size();
+
+    // Inner products of init with itself and with the input snapshots.
+    std::vector<double> inner(m + 1, 0.0);
+    for (int j = 0; j < m; ++j)
+        for (int r = 0; r < d_dim; ++r)
+            inner[j] += init->item(r) * d_snapshots[j]->item(r);
+    for (int r = 0; r < d_dim; ++r)
+        inner[m] += init->item(r) * init->item(r);
+
+    if (d_num_procs > 1)
+    {
+        CAROM_VERIFY(MPI_Allreduce(MPI_IN_PLACE, inner.data(), m + 1,
+                                   MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD)
+                     == MPI_SUCCESS);
+    }
+
+    Vector kx(m, false);
+    for (int j = 0; j < m; ++j)
+        kx(j) = kernel(inner[j], inner[m], d_sq_norms[j]);
+
+    delete d_projected_init_real;
+    delete d_projected_init_imaginary;
+    d_projected_init_real = d_eigfunc_real->transposeMult(kx);
+    d_projected_init_imaginary = d_eigfunc_imaginary->transposeMult(kx);
+
+    if (t_offset >= 0.0)
+    {
+        std::cout << "t_offset is updated from " << d_t_offset <<
+                  " to " << t_offset << std::endl;
+        d_t_offset = t_offset;
+    }
+    d_init_projected = true;
+}
+
+void
+KernelDMD::load(std::string base_file_name)
+{
+    DMD::load(base_file_name);
+    loadKernelState(base_file_name);
+}
+
+void
+KernelDMD::loadKernelState(std::string base_file_name)
+{
+    CAROM_ASSERT(!base_file_name.empty());
+
+    std::string full_file_name = base_file_name + "_kernel";
+    HDFDatabase database;
+    database.open(full_file_name, "r");
+    int kernel_index;
+    database.getInteger("kernel", kernel_index);
+    CAROM_VERIFY(0 <= kernel_index && kernel_index < num_kernels);
+    d_kernel = kernel_names[kernel_index];
+    database.getDouble("kernel_param", d_kernel_param);
+    database.getInteger("block_size", d_block_size);
+    int m;
+    database.getInteger("num_snapshots", m);
+    CAROM_VERIFY(m > 0);
+    d_sq_norms.resize(m);
+    database.getDoubleArray("sq_norms", d_sq_norms.data(), m);
+    database.close();
+
+    delete d_eigfunc_real;
+    delete d_eigfunc_imaginary;
+    full_file_name = base_file_name + "_eigfunc_real";
+    d_eigfunc_real = new Matrix();
+    d_eigfunc_real->read(full_file_name);
+
+    full_file_name = base_file_name + "_eigfunc_imaginary";
+    d_eigfunc_imaginary = new Matrix();
+    d_eigfunc_imaginary->read(full_file_name);
+
+    // The eigenfunctions are evaluated at the input snapshots, so these
+    // replace any samples taken before loading.
+    full_file_name = base_file_name + "_snapshots";
+    Matrix snapshots;
+    snapshots.read(full_file_name);
+    CAROM_VERIFY(snapshots.numColumns() == m);
+    for (auto snapshot : d_snapshots)
+    {
+        delete snapshot;
+    }
+    d_snapshots.clear();
+    d_dim = snapshots.numRows();
+    for (int j = 0; j < m; ++j)
+    {
+        Vector* snapshot = new Vector(d_dim, true);
+        for (int r = 0; r < d_dim; ++r)
+            snapshot->item(r) = snapshots.item(r, j);
+        d_snapshots.push_back(snapshot);
+    }
+
+    MPI_Barrier(MPI_COMM_WORLD);
+}
+
+void
+KernelDMD::save(std::string base_file_name)
+{
+    CAROM_ASSERT(!base_file_name.empty());
+    CAROM_VERIFY(d_trained);
+
+    const int m = d_sq_norms.size();
+    if (d_rank == 0)
+    {
+        int kernel_index = 0;
+        while (d_kernel != kernel_names[kernel_index])
+            ++kernel_index;
+
+        HDFDatabase database;
+        database.create(base_file_name + "_kernel");
+        database.putInteger("kernel", kernel_index);
+        database.putDouble("kernel_param", d_kernel_param);
+        database.putInteger("block_size", d_block_size);
+        database.putInteger("num_snapshots", m);
+        database.putDoubleArray("sq_norms", d_sq_norms.data(), m);
+        database.close();
+    }
+
+    std::string full_file_name = base_file_name + "_eigfunc_real";
+    d_eigfunc_real->write(full_file_name);
+
+    full_file_name = base_file_name + "_eigfunc_imaginary";
+    d_eigfunc_imaginary->write(full_file_name);
+
+    // Only the input snapshots, which the eigenfunctions are evaluated at.
+    full_file_name = base_file_name + "_snapshots";
+    std::vector<Vector*> inputs(d_snapshots.begin(), d_snapshots.begin() + m);
+    const Matrix* snapshots = createSnapshotMatrix(inputs);
+    snapshots->write(full_file_name);
+    delete snapshots;
+
+    DMD::save(base_file_name);
+}
+
+}
@@ -0,0 +1,208 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2013-2024, Lawrence Livermore National Security, LLC
+ * and other libROM project developers. See the top-level COPYRIGHT
+ * file for details.
+ *
+ * SPDX-License-Identifier: (Apache-2.0 OR MIT)
+ *
+ *****************************************************************************/
+
+// Description: Computes the kernel DMD algorithm on the given snapshot matrix.
+//              The implemented algorithm is the kernel formulation of extended
+//              DMD from Williams et. al's paper "A kernel-based method for
+//              data-driven Koopman spectral analysis":
+//              https://arxiv.org/abs/1411.2260
+//              Nonlinear observables are represented implicitly through a
+//              kernel, so only Gram matrices of the snapshots are formed.
+
+#ifndef included_KernelDMD_h
+#define included_KernelDMD_h
+
+#include "DMD.h"
+#include <string>
+
+namespace CAROM {
+
+class Matrix;
+class Vector;
+
+/**
+ * Class KernelDMD implements kernel DMD (kernel extended DMD) on a given
+ * snapshot matrix with uniform time step size.
+ *
+ * The Koopman operator is approximated on the feature space of a kernel
+ * k(x, y), without forming the lifted snapshots. Training only needs the
+ * m x m Gram matrices k(X, X) and k(Y, X) of the input and shifted
+ * snapshots. The supported kernels depend on the snapshots only through
+ * their inner products, which are computed in blocks of columns with one
+ * reduction per block. The full state is reconstructed from Koopman modes,
+ * so predict, getEigs and projectInitialCondition behave as in DMD.
+ */
+class KernelDMD : public DMD
+{
+public:
+
+    /**
+     * @brief Constructor.
+     *
+     * @pre kernel is "LIN", "POLY" or "G"
+     * @pre block_size > 0
+     *
+     * @param[in] dim          The full-order state dimension.
+     * @param[in] dt           The dt between samples.
+     * @param[in] kernel       The kernel type ("LIN" == x.y,
+     *                         "POLY" == (1 + x.y)^p,
+     *                         "G" == exp(-|x - y|^2 / (2 sigma^2))).
+     * @param[in] kernel_param The degree p of "POLY", or the width sigma of
+     *                         "G". Unused for "LIN".
+     * @param[in] block_size   The number of Gram matrix columns computed per
+     *                         reduction.
+     */
+    KernelDMD(int dim, double dt, std::string kernel = "G",
+              double kernel_param = 1.0, int block_size = 64);
+
+    /**
+     * @brief Constructor. KernelDMD from saved models.
+     *
+     * @param[in] base_file_name The base part of the filename of the
+     *                           database to load when restarting from a save.
+     */
+    KernelDMD(std::string base_file_name);
+
+    /**
+     * @brief Destroy the KernelDMD object
+     */
+    ~KernelDMD();
+
+    /**
+     * @brief Train the kernel DMD model with energy fraction criterion.
+     *
+     * @param[in] energy_fraction The energy fraction to keep of the square
+     *                            roots of the Gram matrix eigenvalues.
+     * @param[in] W0              Unsupported, must be NULL.
+     * @param[in] linearity_tol   Unused.
+     */
+    void train(double energy_fraction, const Matrix* W0 = NULL,
+               double linearity_tol = 0.0) override;
+
+    /**
+     * @brief Train the kernel DMD model with specified reduced dimension.
+     *
+     * @param[in] k               The number of Gram matrix eigenvectors to
+     *                            keep.
+     * @param[in] W0              Unsupported, must be NULL.
+     * @param[in] linearity_tol   Unused.
+     */
+    void train(int k, const Matrix* W0 = NULL,
+               double linearity_tol = 0.0) override;
+
+    /**
+     * @brief Project a new initial condition by evaluating the Koopman
+     *        eigenfunctions at it through the kernel.
+     *
+     * @param[in] init     The initial condition.
+     * @param[in] t_offset The initial time offset.
+     */
+    void projectInitialCondition(const Vector* init,
+                                 double t_offset = -1.0) override;
+
+    /**
+     * @brief Load the object state from a file, including the kernel, the
+     *        eigenfunction map and the input snapshots it is evaluated at.
+     *
+     * @param[in] base_file_name The base part of the filename to load the
+     *                           database from.
+     */
+    void load(std::string base_file_name) override;
+
+    /**
+     * @brief Save the object state to a file, including the kernel, the
+     *        eigenfunction map and the input snapshots it is evaluated at.
+     *
+     * @param[in] base_file_name The base part of the filename to save the
+     *                           database to.
+     */
+    void save(std::string base_file_name) override;
+
+private:
+    /**
+     * @brief Unimplemented default constructor.
+     */
+    KernelDMD();
+
+    /**
+     * @brief Unimplemented copy constructor.
+     */
+    KernelDMD(const KernelDMD& other);
+
+    /**
+     * @brief Unimplemented assignment operator.
+     */
+    KernelDMD&
+    operator = (
+        const KernelDMD& rhs);
+
+    /**
+     * @brief Evaluates the kernel from the inner product xy of two vectors
+     *        and their squared norms xx and yy.
+     */
+    double kernel(double xy, double xx, double yy) const;
+
+    /**
+     * @brief Computes the inner products of all snapshots, one reduction
+     *        per block of columns.
+     *
+     * @return The symmetric matrix of snapshot inner products.
+     */
+    Matrix* computeInnerProducts() const;
+
+    /**
+     * @brief Construct the kernel DMD object.
+     */
+    void constructKernelDMD();
+
+    /**
+     * @brief Load the state that KernelDMD adds to DMD.
+     *
+     * @param[in] base_file_name The base part of the filename to load the
+     *                           database from.
+     */
+    void loadKernelState(std::string base_file_name);
+
+    /**
+     * @brief The kernel type.
+     */
+    std::string d_kernel;
+
+    /**
+     * @brief The kernel parameter.
+     */
+    double d_kernel_param;
+
+    /**
+     * @brief The number of Gram matrix columns computed per reduction.
+     */
+    int d_block_size;
+
+    /**
+     * @brief The squared norms of the input snapshots.
+     */
+    std::vector<double> d_sq_norms;
+
+    /**
+     * @brief The real part of the map from kernel evaluations at the input
+     *        snapshots to Koopman eigenfunction values.
+     */
+    Matrix* d_eigfunc_real = NULL;
+
+    /**
+     * @brief The imaginary part of the map from kernel evaluations at the
+     *        input snapshots to Koopman eigenfunction values.
+     */
+    Matrix* d_eigfunc_imaginary = NULL;
+};
+
+}
+
+#endif
@@ -39,7 +39,8 @@ namespace CAROM {
  * @param[in] desired_point     The desired point at which to create a parametric DMD.
  * @param[in] rbf               The RBF type ("G" == gaussian,
  *                              "IQ" == inverse quadratic,
- *                              "IMQ" == inverse multiquadric)
+ *                              "IMQ" == inverse multiquadric,
+ *                              "W" == compactly supported Wendland)
  * @param[in] interp_method     The interpolation method type
  *                              ("LS" == linear solve,
  *                              "IDW" == inverse distance weighting,
@@ -128,7 +129,8 @@ void getParametricDMD(T*& parametric_dmd,
  * @param[in] desired_point     The desired point at which to create a parametric DMD.
  * @param[in] rbf               The RBF type ("G" == gaussian,
  *                              "IQ" == inverse quadratic,
- *                              "IMQ" == inverse multiquadric)
+ *                              "IMQ" == inverse multiquadric,
+ *                              "W" == compactly supported Wendland)
  * @param[in] interp_method     The interpolation method type
  *                              ("LS" == linear solve,
  *                              "IDW" == inverse distance weighting,
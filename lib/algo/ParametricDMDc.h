@@ -42,7 +42,8 @@ namespace CAROM {
  * @param[in] desired_point         The desired point at which to create a parametric DMDc.
  * @param[in] rbf                   The RBF type ("G" == gaussian,
  *                                  "IQ" == inverse quadratic,
- *                                  "IMQ" == inverse multiquadric)
+ *                                  "IMQ" == inverse multiquadric,
+ *                                  "W" == compactly supported Wendland)
  * @param[in] interp_method         The interpolation method type
  *                                  ("LS" == linear solve,
  *                                  "IDW" == inverse distance weighting,
@@ -150,7 +151,8 @@ void getParametricDMDc(T*& parametric_dmdc,
  * @param[in] controls_interpolated The interpolated controls.
  * @param[in] rbf                   The RBF type ("G" == gaussian,
  *                                  "IQ" == inverse quadratic,
- *                                  "IMQ" == inverse multiquadric)
+ *                                  "IMQ" == inverse multiquadric,
+ *                                  "W" == compactly supported Wendland)
  * @param[in] interp_method         The interpolation method type
  *                                  ("LS" == linear solve,
  *                                  "IDW" == inverse distance weighting,
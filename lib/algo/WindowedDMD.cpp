@@ -0,0 +1,266 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2013-2024, Lawrence Livermore National Security, LLC
+ * and other libROM project developers. See the top-level COPYRIGHT
+ * file for details.
+ *
+ * SPDX-License-Identifier: (Apache-2.0 OR MIT)
+ *
+ *****************************************************************************/
+
+// Description: Implementation of time-windowed DMD.
+
+#include "WindowedDMD.h"
+#include "DMD.h"
+
+#include "linalg/Matrix.h"
+#include "linalg/Vector.h"
+#include "utils/HDFDatabase.h"
+#include "utils/Utilities.h"
+#include "mpi.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace CAROM {
+
+WindowedDMD::WindowedDMD(int dim, double dt, int window_num_samples,
+                         int window_overlap_samples, Vector* state_offset)
+{
+    CAROM_VERIFY(dim > 0);
+    CAROM_VERIFY(dt > 0.0);
+    CAROM_VERIFY(window_num_samples > 0);
+    CAROM_VERIFY(window_overlap_samples >= 0);
+
+    // Get the rank of this process.
+    int mpi_init;
+    MPI_Initialized(&mpi_init);
+    if (mpi_init == 0) {
+        MPI_Init(nullptr, nullptr);
+    }
+
+    MPI_Comm_rank(MPI_COMM_WORLD, &d_rank);
+    d_dim = dim;
+    d_dt = dt;
+    d_window_num_samples = window_num_samples;
+    d_window_overlap_samples = window_overlap_samples;
+    d_state_offset = state_offset;
+}
+
+WindowedDMD::WindowedDMD(std::string base_file_name)
+{
+    CAROM_VERIFY(!base_file_name.empty());
+
+    // Get the rank of this process.
+    int mpi_init;
+    MPI_Initialized(&mpi_init);
+    if (mpi_init == 0) {
+        MPI_Init(nullptr, nullptr);
+    }
+
+    MPI_Comm_rank(MPI_COMM_WORLD, &d_rank);
+    d_state_offset = NULL;
+
+    HDFDatabase database;
+    database.open(base_file_name, "r");
+    database.getDouble("dt", d_dt);
+    database.getInteger("window_num_samples", d_window_num_samples);
+    database.getInteger("window_overlap_samples", d_window_overlap_samples);
+    int num_windows;
+    database.getInteger("num_windows", num_windows);
+    CAROM_VERIFY(num_windows > 0);
+    d_window_start_times.resize(num_windows);
+    database.getDoubleArray("window_start_times", d_window_start_times.data(),
+                            num_windows);
+    database.close();
+
+    for (int w = 0; w < num_windows; ++w)
+    {
+        d_windows.push_back(new DMD(base_file_name + "_window" +
+                                    std::to_string(w)));
+    }
+    d_dim = d_windows[0]->d_phi_real->numRows();
+    if (d_windows[0]->d_state_offset)
+    {
+        d_state_offset = new Vector(*d_windows[0]->d_state_offset);
+    }
+}
+
+WindowedDMD::~WindowedDMD()
+{
+    clearWindows();
+    for (auto snapshot : d_snapshots)
+    {
+        delete snapshot;
+    }
+    delete d_state_offset;
+}
+
+void
+WindowedDMD::clearWindows()
+{
+    for (auto window : d_windows)
+    {
+        delete window;
+    }
+    d_windows.clear();
+    d_window_start_times.clear();
+}
+
+void
+WindowedDMD::takeSample(double* u_in, double t)
+{
+    CAROM_VERIFY(u_in != 0);
+    CAROM_VERIFY(t >= 0.0);
+    // Each window is a DMD model with uniform time step, so the samples
+    // must be dt apart.
+    CAROM_VERIFY(d_sampled_times.empty() ||
+                 std::abs(t - d_sampled_times.back() - d_dt) <= 1.0e-6 * d_dt);
+
+    d_snapshots.push_back(new Vector(u_in, d_dim, true));
+    d_sampled_times.push_back(t);
+}
+
+void
+WindowedDMD::train(double energy_fraction)
+{
+    CAROM_VERIFY(energy_fraction > 0 && energy_fraction <= 1);
+    constructWindows(energy_fraction, -1);
+}
+
+void
+WindowedDMD::train(int k)
+{
+    CAROM_VERIFY(k > 0);
+    constructWindows(-1.0, k);
+}
+
+void
+WindowedDMD::constructWindows(double energy_fraction, int k)
+{
+    const int num_samples = d_snapshots.size();
+    CAROM_VERIFY(num_samples > 1);
+    clearWindows();
+
+    // Windows start every d_window_num_samples snapshots. The number of
+    // windows is rounded so that the last window, which takes the remaining
+    // snapshots, has between half and one and a half times as many.
+    const double num_intervals = num_samples - 1;
+    const int num_windows = std::max(1, static_cast<int>(
+                                         std::round(num_intervals / d_window_num_samples)));
+
+    for (int w = 0; w < num_windows; ++w)
+    {
+        const int first = w * d_window_num_samples;
+        const int next = (w + 1) * d_window_num_samples;
+        const int last = (w == num_windows - 1) ? num_samples - 1 :
+                         std::min(num_samples - 1, next + d_window_overlap_samples);
+        CAROM_VERIFY(k <= last - first);
+
+        Vector* state_offset = d_state_offset ? new Vector(*d_state_offset) :
+                               NULL;
+        DMD* window = new DMD(d_dim, d_dt, false, state_offset);
+        window->d_t_offset = d_sampled_times[first];
+        window->d_energy_fraction = energy_fraction;
+        window->d_k = k;
+
+        if (d_rank == 0) std::cout << "Training DMD window " << w <<
+                                       " on samples " << first << " to " << last << "." << std::endl;
+
+        // Only the snapshots of the window are copied, for the duration of
+        // its training.
+        const Matrix* f_snapshots = createWindowSnapshotMatrix(first, last);
+        window->constructDMD(f_snapshots, window->d_rank, window->d_num_procs,
+                             NULL, 0.0);
+        delete f_snapshots;
+
+        d_windows.push_back(window);
+        d_window_start_times.push_back(d_sampled_times[first]);
+    }
+}
+
+Matrix*
+WindowedDMD::createWindowSnapshotMatrix(int first, int last) const
+{
+    Matrix* snapshot_mat = new Matrix(d_dim, last - first + 1, true);
+    for (int i = 0; i < d_dim; i++)
+    {
+        for (int j = first; j <= last; j++)
+        {
+            snapshot_mat->item(i, j - first) = d_snapshots[j]->item(i);
+        }
+    }
+    return snapshot_mat;
+}
+
+void
+WindowedDMD::projectInitialCondition(const Vector* init)
+{
+    CAROM_VERIFY(!d_windows.empty());
+
+    d_windows[0]->projectInitialCondition(init);
+    for (size_t w = 1; w < d_windows.size(); ++w)
+    {
+        Vector* window_init = d_windows[w - 1]->predict(d_window_start_times[w]);
+        d_windows[w]->projectInitialCondition(window_init);
+        delete window_init;
+    }
+}
+
+int
+WindowedDMD::getWindowIndex(double t) const
+{
+    CAROM_VERIFY(!d_window_start_times.empty());
+
+    const int w = std::upper_bound(d_window_start_times.begin(),
+                                   d_window_start_times.end(), t) -
+                  d_window_start_times.begin() - 1;
+    return std::max(w, 0);
+}
+
+Vector*
+WindowedDMD::predict(double t, int deg)
+{
+    return d_windows[getWindowIndex(t)]->predict(t, deg);
+}
+
+double
+WindowedDMD::getWindowStartTime(int w) const
+{
+    CAROM_VERIFY(0 <= w && w < getNumWindows());
+    return d_window_start_times[w];
+}
+
+const DMD*
+WindowedDMD::getWindow(int w) const
+{
+    CAROM_VERIFY(0 <= w && w < getNumWindows());
+    return d_windows[w];
+}
+
+void
+WindowedDMD::save(std::string base_file_name)
+{
+    CAROM_VERIFY(!base_file_name.empty());
+    CAROM_VERIFY(!d_windows.empty());
+
+    if (d_rank == 0)
+    {
+        HDFDatabase database;
+        database.create(base_file_name);
+        database.putDouble("dt", d_dt);
+        database.putInteger("window_num_samples", d_window_num_samples);
+        database.putInteger("window_overlap_samples", d_window_overlap_samples);
+        database.putInteger("num_windows", d_windows.size());
+        database.putDoubleArray("window_start_times", d_window_start_times.data(),
+                                d_window_start_times.size());
+        database.close();
+    }
+
+    for (int w = 0; w < getNumWindows(); ++w)
+    {
+        d_windows[w]->save(base_file_name + "_window" + std::to_string(w));
+    }
+}
+
+}
@@ -0,0 +1,263 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2013-2024, Lawrence Livermore National Security, LLC
+ * and other libROM project developers. See the top-level COPYRIGHT
+ * file for details.
+ *
+ * SPDX-License-Identifier: (Apache-2.0 OR MIT)
+ *
+ *****************************************************************************/
+
+// Description: Time-windowed DMD. The sampled time interval is split into
+//              windows of consecutive snapshots, with a local DMD model per
+//              window, so that dynamics which change over a long horizon are
+//              represented by a sequence of low-dimensional models.
+
+#ifndef included_WindowedDMD_h
+#define included_WindowedDMD_h
+
+#include <string>
+#include <vector>
+
+namespace CAROM {
+
+class DMD;
+class Matrix;
+class Vector;
+
+/**
+ * Class WindowedDMD implements time-windowed DMD with uniform time step
+ * size.
+ *
+ * Each snapshot is stored once. Window w is the index range of snapshots
+ * starting at w * window_num_samples and ending at the start of window
+ * w + 1 plus window_overlap_samples, so the snapshots in the overlap of two
+ * windows are shared rather than copied into both. The last window extends
+ * to the last snapshot. Each window is trained as a DMD model from its
+ * range of snapshots, collectively over all processes with the rows of the
+ * snapshots distributed as in DMD. The windows are trained one after
+ * another, not concurrently on sub-communicators or threads: the
+ * distributed Matrix operations and the ScaLAPACK SVD of DMD work on
+ * MPI_COMM_WORLD, and ScaLAPACK is not thread-safe.
+ *
+ * The model of window w predicts the state for times from its start time to
+ * the start time of window w + 1. The window of a time t is found by binary
+ * search of the window start times. The whole model, i.e. all windows and
+ * their start times, is saved and loaded under one base file name.
+ */
+class WindowedDMD
+{
+public:
+
+    /**
+     * @brief Constructor.
+     *
+     * @pre dim > 0
+     * @pre dt > 0.0
+     * @pre window_num_samples > 0
+     * @pre window_overlap_samples >= 0
+     *
+     * @param[in] dim                    The full-order state dimension.
+     * @param[in] dt                     The dt between samples.
+     * @param[in] window_num_samples     The number of snapshot intervals
+     *                                   between the starts of consecutive
+     *                                   windows.
+     * @param[in] window_overlap_samples The number of snapshots past the
+     *                                   start of the next window that are
+     *                                   also used to train a window.
+     * @param[in] state_offset           The state offset, owned by this
+     *                                   object. Each window uses a copy.
+     */
+    WindowedDMD(int dim, double dt, int window_num_samples,
+                int window_overlap_samples = 0,
+                Vector* state_offset = NULL);
+
+    /**
+     * @brief Constructor. Windowed DMD from a saved model.
+     *
+     * @param[in] base_file_name The base part of the filename of the
+     *                           database to load.
+     */
+    WindowedDMD(std::string base_file_name);
+
+    /**
+     * @brief Destroy the WindowedDMD object
+     */
+    ~WindowedDMD();
+
+    /**
+     * @brief Sample the new state, u_in.
+     *
+     * @pre u_in != 0
+     * @pre t is dt after the time of the previous sample
+     *
+     * @param[in] u_in The new state.
+     * @param[in] t    The time of the newly sampled state.
+     */
+    void takeSample(double* u_in, double t);
+
+    /**
+     * @brief Train the model of each window with energy fraction
+     *        criterion.
+     *
+     * @param[in] energy_fraction The energy fraction to keep after doing SVD.
+     */
+    void train(double energy_fraction);
+
+    /**
+     * @brief Train the model of each window with specified reduced
+     *        dimension.
+     *
+     * @pre k is less than the number of snapshots of each window
+     *
+     * @param[in] k The number of modes to keep after doing SVD.
+     */
+    void train(int k);
+
+    /**
+     * @brief Project a new initial condition at the start time of the
+     *        first window. The initial condition of each following window is
+     *        the prediction of the previous window at its start time.
+     *
+     * @param[in] init The initial condition.
+     */
+    void projectInitialCondition(const Vector* init);
+
+    /**
+     * @brief Predict the state at time t with the model of the window
+     *        containing t.
+     *
+     * @param[in] t   The time of the output state.
+     * @param[in] deg The derivative degree of the output state.
+     *
+     * @return The predicted state, owned by the caller.
+     */
+    Vector* predict(double t, int deg = 0);
+
+    /**
+     * @brief Returns the index of the window whose model predicts time t.
+     */
+    int getWindowIndex(double t) const;
+
+    /**
+     * @brief Returns the number of windows.
+     */
+    int getNumWindows() const
+    {
+        return d_windows.size();
+    }
+
+    /**
+     * @brief Returns the start time of window w.
+     */
+    double getWindowStartTime(int w) const;
+
+    /**
+     * @brief Returns the DMD model of window w.
+     */
+    const DMD* getWindow(int w) const;
+
+    /**
+     * @brief Returns the number of samples taken.
+     */
+    int getNumSamples() const
+    {
+        return d_snapshots.size();
+    }
+
+    /**
+     * @brief Save the model to files.
+     *
+     * @param[in] base_file_name The base part of the filename to save the
+     *                           database to.
+     */
+    void save(std::string base_file_name);
+
+private:
+    /**
+     * @brief Unimplemented default constructor.
+     */
+    WindowedDMD();
+
+    /**
+     * @brief Unimplemented copy constructor.
+     */
+    WindowedDMD(
+        const WindowedDMD& other);
+
+    /**
+     * @brief Unimplemented assignment operator.
+     */
+    WindowedDMD&
+    operator = (
+        const WindowedDMD& rhs);
+
+    /**
+     * @brief Splits the snapshots into windows and trains their models.
+     */
+    void constructWindows(double energy_fraction, int k);
+
+    /**
+     * @brief Forms the snapshot matrix of snapshots [first, last].
+     */
+    Matrix* createWindowSnapshotMatrix(int first, int last) const;
+
+    /**
+     * @brief Deletes the window models.
+     */
+    void clearWindows();
+
+    /**
+     * @brief The rank of the process this object belongs to.
+     */
+    int d_rank;
+
+    /**
+     * @brief The full-order state dimension.
+     */
+    int d_dim;
+
+    /**
+     * @brief The dt between samples.
+     */
+    double d_dt;
+
+    /**
+     * @brief The number of snapshot intervals between window starts.
+     */
+    int d_window_num_samples;
+
+    /**
+     * @brief The number of snapshots shared with the next window.
+     */
+    int d_window_overlap_samples;
+
+    /**
+     * @brief The state offset.
+     */
+    Vector* d_state_offset;
+
+    /**
+     * @brief The snapshots, each stored once.
+     */
+    std::vector<Vector*> d_snapshots;
+
+    /**
+     * @brief The times of the snapshots.
+     */
+    std::vector<double> d_sampled_times;
+
+    /**
+     * @brief The DMD model of each window.
+     */
+    std::vector<DMD*> d_windows;
+
+    /**
+     * @brief The start time of each window, in increasing order.
+     */
+    std::vector<double> d_window_start_times;
+};
+
+}
+
+#endif
@@ -13,11 +13,13 @@
 
 #include "GreedySampler.h"
 #include "utils/HDFDatabase.h"
+#include "algo/manifold_interp/Interpolator.h"
 #include "mpi.h"
 #include <cmath>
 #include <algorithm>
 #include <limits.h>
 #include <fstream>
+#include <limits>
 
 namespace CAROM {
 
@@ -668,6 +670,10 @@ GreedySampler::getNextSubsetPointRequiringErrorIndicator()
             std::shuffle(d_parameter_point_random_indices.begin(),
                          d_parameter_point_random_indices.end(), rng);
         }
+        if (d_use_surrogate)
+        {
+            orderSubsetBySurrogate();
+        }
         d_subset_created = true;
     }
 
@@ -713,6 +719,34 @@ GreedySampler::getNextSubsetPointRequiringErrorIndicator()
                         agnosticPrint(str);
                     }
                 }
+                else if (!d_surrogate_predictions.empty() &&
+                         d_surrogate_predictions[d_parameter_point_random_indices[d_counter]] >= 0.0
+                         && d_max_error >= d_error_indicator_tol &&
+                         d_surrogate_safety_factor *
+                         d_surrogate_predictions[d_parameter_point_random_indices[d_counter]] <
+                         d_max_error)
+                {
+                    // a new point will be sampled this iteration regardless,
+                    // and this point is not predicted to be the worst one
+                    d_surrogate_saved_evaluations++;
+                    if (d_rank == 0)
+                    {
+                        std::string str;
+                        str += "Error indicator at [ ";
+                        for (int i = 0 ;
+                                i < d_parameter_points[d_parameter_point_random_indices[d_counter]].dim(); i++)
+                        {
+                            str += std::to_string(
+                                       d_parameter_points[d_parameter_point_random_indices[d_counter]].item(i)) + " ";
+                        }
+                        str += "] skipped.\n";
+                        str += "Surrogate prediction " + std::to_string(
+                                   d_surrogate_predictions[d_parameter_point_random_indices[d_counter]]) +
+                               " is less than current max error " + std::to_string(d_max_error) +
+                               " over the safety factor.\n";
+                        agnosticPrint(str);
+                    }
+                }
                 else
                 {
                     d_next_point_requiring_error_indicator =
@@ -818,6 +852,157 @@ GreedySampler::printSamplingType(std::string sampling_type)
     }
 }
 
+void
+GreedySampler::setSurrogate(std::string rbf,
+                            double closest_rbf_val,
+                            double safety_factor,
+                            int min_training_points)
+{
+    CAROM_VERIFY(rbf == "G" || rbf == "IQ" || rbf == "IMQ");
+    CAROM_VERIFY(closest_rbf_val > 0.0 && closest_rbf_val < 1.0);
+    CAROM_VERIFY(safety_factor >= 1.0);
+    CAROM_VERIFY(min_training_points >= 2);
+
+    d_use_surrogate = true;
+    d_surrogate_rbf = rbf;
+    d_surrogate_closest_rbf_val = closest_rbf_val;
+    d_surrogate_safety_factor = safety_factor;
+    d_surrogate_min_training_points = min_training_points;
+
+    if (d_rank == 0)
+    {
+        std::string str;
+        str += "Surrogate RBF: " + d_surrogate_rbf + "\n";
+        str += "Surrogate safety factor: " + std::to_string(
+                   d_surrogate_safety_factor) + "\n";
+        agnosticPrint(str);
+    }
+}
+
+void
+GreedySampler::orderSubsetBySurrogate()
+{
+    const int num_points = d_parameter_points.size();
+    const int dim = d_parameter_points[0].dim();
+    d_surrogate_predictions.assign(num_points, -1.0);
+
+    // Scale the parameter coordinates to the unit box, so that the RBF
+    // distance does not depend on the units of each parameter.
+    std::vector<double> coord_min(dim, std::numeric_limits<double>::max());
+    std::vector<double> coord_span(dim, -std::numeric_limits<double>::max());
+    for (int i = 0; i < num_points; i++)
+    {
+        for (int j = 0; j < dim; j++)
+        {
+            coord_min[j] = std::min(coord_min[j], d_parameter_points[i].item(j));
+            coord_span[j] = std::max(coord_span[j], d_parameter_points[i].item(j));
+        }
+    }
+    for (int j = 0; j < dim; j++)
+    {
+        coord_span[j] -= coord_min[j];
+        if (coord_span[j] <= 0.0)
+        {
+            coord_span[j] = 1.0;
+        }
+    }
+    std::vector<Vector*> scaled_points(num_points);
+    for (int i = 0; i < num_points; i++)
+    {
+        scaled_points[i] = new Vector(dim, false);
+        for (int j = 0; j < dim; j++)
+        {
+            scaled_points[i]->item(j) = (d_parameter_points[i].item(j) - coord_min[j]) /
+                                        coord_span[j];
+        }
+    }
+
+    // The training data are the error indicators computed so far.
+    std::vector<Vector*> training_points;
+    std::vector<double> training_errors;
+    for (int i = 0; i < num_points; i++)
+    {
+        if (d_parameter_point_errors[i] != INT_MAX)
+        {
+            training_points.push_back(scaled_points[i]);
+            training_errors.push_back(d_parameter_point_errors[i]);
+        }
+    }
+
+    double epsilon = 0.0;
+    if (static_cast<int>(training_points.size()) >=
+            d_surrogate_min_training_points)
+    {
+        epsilon = convertClosestRBFToEpsilon(training_points, d_surrogate_rbf,
+                                             d_surrogate_closest_rbf_val);
+    }
+    if (epsilon <= 0.0 || !std::isfinite(epsilon))
+    {
+        d_surrogate_predictions.clear();
+        for (int i = 0; i < num_points; i++)
+        {
+            delete scaled_points[i];
+        }
+        return;
+    }
+
+    // The subset is the first d_subset_size non-sampled points in the
+    // shuffled order. Points without a prediction, far from every training
+    // point, are visited first.
+    std::vector<int> subset_positions;
+    std::vector<std::pair<double, int>> ranked_points;
+    for (int i = 0; i < num_points &&
+            static_cast<int>(subset_positions.size()) < d_subset_size; i++)
+    {
+        const int index = d_parameter_point_random_indices[i];
+        if (d_parameter_sampled_indices.find(index) !=
+                d_parameter_sampled_indices.end())
+        {
+            continue;
+        }
+        subset_positions.push_back(i);
+
+        std::vector<double> rbf = obtainRBFToTrainingPoints(training_points,
+                                  "IDW", d_surrogate_rbf, epsilon, scaled_points[index]);
+        double sum = rbfWeightedSum(rbf);
+        double rank_key = std::numeric_limits<double>::max();
+        if (sum > 0.0)
+        {
+            double prediction = 0.0;
+            for (size_t j = 0; j < rbf.size(); j++)
+            {
+                prediction += rbf[j] * training_errors[j];
+            }
+            d_surrogate_predictions[index] = prediction / sum;
+            rank_key = d_surrogate_predictions[index];
+        }
+        ranked_points.push_back(std::make_pair(-rank_key, index));
+    }
+    std::stable_sort(ranked_points.begin(), ranked_points.end(),
+                     [](const std::pair<double, int>& a,
+    const std::pair<double, int>& b) {
+        return a.first < b.first;
+    });
+    for (size_t i = 0; i < subset_positions.size(); i++)
+    {
+        d_parameter_point_random_indices[subset_positions[i]] =
+            ranked_points[i].second;
+    }
+
+    for (int i = 0; i < num_points; i++)
+    {
+        delete scaled_points[i];
+    }
+
+    if (d_rank == 0)
+    {
+        std::string str;
+        str += "Subset ordered by the surrogate of " +
+               std::to_string(training_points.size()) + " error indicators.\n";
+        agnosticPrint(str);
+    }
+}
+
 void
 GreedySampler::printConvergenceAchieved()
 {
@@ -825,6 +1010,11 @@ GreedySampler::printConvergenceAchieved()
     {
         std::string str;
         str += "Convergence achieved.\n";
+        if (d_use_surrogate)
+        {
+            str += "Error indicator evaluations saved by the surrogate: " +
+                   std::to_string(d_surrogate_saved_evaluations) + "\n";
+        }
         agnosticPrint(str);
 
         str = "\nSampled Parameter Points\n";
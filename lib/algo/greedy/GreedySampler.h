@@ -350,6 +350,46 @@ public:
     virtual void
     save(std::string base_file_name);
 
+    /**
+     * @brief Order and prune the candidates of each iteration with a cheap
+     *        surrogate of the error indicator.
+     *
+     * The surrogate is an inverse distance weighted RBF regression, using the
+     * Interpolator RBFs, of the error indicators computed so far (zero at the
+     * sampled points), with parameter coordinates scaled to the unit box.
+     * When an iteration's subset is created, its points are visited in
+     * decreasing order of predicted error. A point is skipped without
+     * computing its error indicator when the current max error already
+     * exceeds the error indicator tolerance, so a new point will be sampled
+     * anyway, and safety_factor times its predicted error is below the
+     * current max error. The tolerance test and the convergence subset never
+     * rely on predictions. The surrogate is not saved with the object state.
+     *
+     * @param[in] rbf The RBF type ("G" == gaussian, "IQ" == inverse quadratic,
+     *                "IMQ" == inverse multiquadric).
+     * @param[in] closest_rbf_val The RBF value between the closest two
+     *                            training points, used to compute epsilon.
+     * @param[in] safety_factor The factor applied to predictions before
+     *                          pruning, >= 1.
+     * @param[in] min_training_points The number of computed error indicators
+     *                                required before the surrogate is used.
+     */
+    void
+    setSurrogate(std::string rbf = "G",
+                 double closest_rbf_val = 0.9,
+                 double safety_factor = 2.0,
+                 int min_training_points = 3);
+
+    /**
+     * @brief Returns the number of error indicator evaluations skipped on
+     *        the surrogate's prediction.
+     */
+    int
+    getNumSurrogateSavedEvaluations() const
+    {
+        return d_surrogate_saved_evaluations;
+    }
+
     /**
      * @brief Check if the greedy algorithm procedure is complete.
      *
@@ -469,6 +509,12 @@ protected:
      */
     void printConvergenceAchieved();
 
+    /**
+     * @brief Reorder the points of the current subset by decreasing
+     *        surrogate prediction of the error indicator.
+     */
+    void orderSubsetBySurrogate();
+
     /**
      * @brief Set the error indicator for a subset point.
      *
@@ -691,6 +737,44 @@ protected:
      * @brief Random engine used to generate subsets.
      */
     std::default_random_engine rng;
+
+    /**
+     * @brief Whether the subset is ordered and pruned by a surrogate.
+     */
+    bool d_use_surrogate = false;
+
+    /**
+     * @brief The RBF type of the surrogate.
+     */
+    std::string d_surrogate_rbf;
+
+    /**
+     * @brief The RBF value between the closest two surrogate training points.
+     */
+    double d_surrogate_closest_rbf_val = 0.9;
+
+    /**
+     * @brief The factor applied to surrogate predictions before pruning.
+     */
+    double d_surrogate_safety_factor = 2.0;
+
+    /**
+     * @brief The number of computed error indicators required before the
+     *        surrogate is used.
+     */
+    int d_surrogate_min_training_points = 3;
+
+    /**
+     * @brief The surrogate predictions at the points of the current subset,
+     *        or -1 where no prediction is available.
+     */
+    std::vector<double> d_surrogate_predictions;
+
+    /**
+     * @brief The number of error indicator evaluations skipped on the
+     *        surrogate's prediction.
+     */
+    int d_surrogate_saved_evaluations = 0;
 };
 
 /**
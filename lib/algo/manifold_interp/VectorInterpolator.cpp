@@ -89,19 +89,17 @@ VectorInterpolator::~VectorInterpolator()
         delete v;
 }
 
-void VectorInterpolator::obtainLambda()
+Vector* VectorInterpolator::obtainLogInterpolatedVector(
+    std::vector<double>& rbf)
 {
     if (d_interp_method == "LS")
     {
-        d_lambda_T = solveLinearSystem(d_parameter_points, d_gammas, d_interp_method,
-                                       d_rbf, d_epsilon);
+        // The LS interpolant is the weighted sum of the gammas, as computed
+        // for LP.
+        std::vector<double> weights = obtainRBFWeights(rbf);
+        return obtainInterpolatedVector(d_gammas, NULL, "LP", weights);
     }
-}
-
-Vector* VectorInterpolator::obtainLogInterpolatedVector(
-    std::vector<double>& rbf)
-{
-    return obtainInterpolatedVector(d_gammas, d_lambda_T, d_interp_method, rbf);
+    return obtainInterpolatedVector(d_gammas, NULL, d_interp_method, rbf);
 }
 
 Vector* VectorInterpolator::interpolate(Vector* point)
@@ -127,8 +125,8 @@ Vector* VectorInterpolator::interpolate(Vector* point)
             }
         }
 
-        // Obtain lambda for the P interpolation vector
-        obtainLambda();
+        // Factor the RBF matrix for the LS weights
+        factorRBFMatrix();
     }
 
     // Obtain distances from database points to new point
@@ -211,6 +209,18 @@ Matrix* solveLinearSystem(std::vector<Vector*> parameter_points,
             }
         }
 
+        // The Wendland RBF matrix is sparse. Each row of f_T is a right-hand
+        // side.
+        if (rbf == "W")
+        {
+            SparseRBFCholesky factor(parameter_points, epsilon);
+            for (int i = 0; i < f_T->numRows(); i++)
+            {
+                factor.solve(f_T->getData() + i * f_T->numColumns());
+            }
+            return f_T;
+        }
+
         // Obtain B vector by calculating RBF.
         Matrix* B = new Matrix(data.size(), data.size(), false);
         for (int i = 0; i < B->numRows(); i++)
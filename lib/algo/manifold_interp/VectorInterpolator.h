@@ -45,7 +45,8 @@ public:
      *                              to the reference point
      * @param[in] rbf               The RBF type ("G" == gaussian,
      *                              "IQ" == inverse quadratic,
-     *                              "IMQ" == inverse multiquadric)
+     *                              "IMQ" == inverse multiquadric,
+     *                              "W" == compactly supported Wendland)
      * @param[in] interp_method     The interpolation method type
      *                              ("LS" == linear solve,
      *                              "IDW" == inverse distance weighting,
@@ -90,12 +91,6 @@ private:
     operator = (
         const VectorInterpolator& rhs);
 
-    /**
-     * @brief Solve the system of equations of the gammas to obtain the
-     *        lambda for the P matrix.
-     */
-    void obtainLambda();
-
     /**
      * @brief Obtain the interpolated vector of the unsampled parameter point
      *           in log space.
@@ -18,6 +18,7 @@
 #include <vector>
 #include <map>
 #include <set>
+#include <algorithm>
 
 #include "DEIM.h"
 
@@ -35,15 +36,48 @@ DEIM(const Matrix* f_basis,
      int num_procs)
 {
     CAROM_VERIFY(num_procs == f_sampled_rows_per_proc.size());
-    // This algorithm determines the rows of f that should be sampled, the
-    // processor that owns each sampled row, and fills f_basis_sampled_inv with
-    // the inverse of the sampled rows of the basis of the RHS.
+    CAROM_VERIFY(0 < num_f_basis_vectors_used
+                 && num_f_basis_vectors_used <= f_basis->numColumns());
+    CAROM_VERIFY(num_f_basis_vectors_used ==
+                 static_cast<int>(f_sampled_row.size()));
+
+    // A single basis is the joint algorithm with one member.
+    vector<const Matrix*> f_bases(1, f_basis);
+    vector<int> num_used(1, num_f_basis_vectors_used);
+    vector<vector<int> > sampled_row(1);
+    vector<vector<int> > sampled_rows_per_proc(1);
+    vector<Matrix*> basis_sampled_inv(1, &f_basis_sampled_inv);
+    DEIM(f_bases, num_used, sampled_row, sampled_rows_per_proc,
+         basis_sampled_inv, myid, num_procs);
+
+    f_sampled_row = sampled_row[0];
+    f_sampled_rows_per_proc = sampled_rows_per_proc[0];
+}
+
+void
+DEIM(const std::vector<const Matrix*>& f_bases,
+     const std::vector<int>& num_f_basis_vectors_used,
+     std::vector<std::vector<int> >& f_sampled_row,
+     std::vector<std::vector<int> >& f_sampled_rows_per_proc,
+     const std::vector<Matrix*>& f_basis_sampled_inv,
+     int myid,
+     int num_procs)
+{
+    // This algorithm determines, for each basis, the rows of f that should be
+    // sampled, the processor that owns each sampled row, and fills
+    // f_basis_sampled_inv with the inverse of the sampled rows of the basis.
+    // The greedy selections of all bases advance together so that each step
+    // costs two collectives regardless of the number of bases.
+    const int num_bases = static_cast<int>(f_bases.size());
+    CAROM_VERIFY(num_bases > 0);
+    CAROM_VERIFY(num_bases ==
+                 static_cast<int>(num_f_basis_vectors_used.size()));
+    CAROM_VERIFY(num_bases == static_cast<int>(f_basis_sampled_inv.size()));
 
     // Create an MPI_Datatype for the RowInfo struct.
     MPI_Datatype MaxRowType, oldtypes[2];
     int blockcounts[2];
     MPI_Aint offsets[2], extent, lower_bound;
-    MPI_Status stat;
     offsets[0] = 0;
     oldtypes[0] = MPI_DOUBLE;
     blockcounts[0] = 1;
@@ -77,149 +111,173 @@ DEIM(const Matrix* f_basis,
     MPI_Op RowInfoOp;
     MPI_Op_create((MPI_User_function*)RowInfoMax, true, &RowInfoOp);
 
-    // Get the number of basis vectors and the size of each basis vector.
-    CAROM_VERIFY(0 < num_f_basis_vectors_used
-                 && num_f_basis_vectors_used <= f_basis->numColumns());
-    int num_basis_vectors =
-        std::min(num_f_basis_vectors_used, f_basis->numColumns());
-    CAROM_VERIFY(num_basis_vectors == f_sampled_row.size());
-    CAROM_VERIFY(num_basis_vectors == f_basis_sampled_inv.numRows()
-                 && num_basis_vectors == f_basis_sampled_inv.numColumns());
-    CAROM_VERIFY(!f_basis_sampled_inv.distributed());
-    int basis_size = f_basis->numRows();
+    // Get the number of basis vectors of each basis.
+    vector<int> num_basis_vectors(num_bases);
+    int max_basis_vectors = 0;
+    for (int k = 0; k < num_bases; ++k) {
+        const Matrix* f_basis = f_bases[k];
+        CAROM_VERIFY(0 < num_f_basis_vectors_used[k]
+                     && num_f_basis_vectors_used[k] <= f_basis->numColumns());
+        num_basis_vectors[k] = num_f_basis_vectors_used[k];
+        CAROM_VERIFY(num_basis_vectors[k] == f_basis_sampled_inv[k]->numRows()
+                     && num_basis_vectors[k] == f_basis_sampled_inv[k]->numColumns());
+        CAROM_VERIFY(!f_basis_sampled_inv[k]->distributed());
+        max_basis_vectors = std::max(max_basis_vectors, num_basis_vectors[k]);
+    }
 
     // The small matrix inverted by the algorithm.  We'll allocate the largest
     // matrix we'll need and set its size at each step in the algorithm.
-    Matrix M(num_basis_vectors, num_basis_vectors, false);
-
-    // Scratch space used throughout the algorithm.
-    double* c = new double [num_basis_vectors];
-
-    vector<set<int> > proc_sampled_f_row(num_procs);
-    vector<map<int, int> > proc_f_row_to_tmp_fs_row(num_procs);
-    int num_f_basis_cols = f_basis_sampled_inv.numColumns();
-    Matrix tmp_fs(f_basis_sampled_inv.numRows(),
-                  num_f_basis_cols,
-                  f_basis_sampled_inv.distributed());
-
-    // Figure out the 1st sampled row of the RHS.
-    RowInfo f_bv_max_local, f_bv_max_global;
-    f_bv_max_local.row_val = -1.0;
-    f_bv_max_local.proc = myid;
-    for (int i = 0; i < basis_size; ++i) {
-        double f_bv_val = fabs(f_basis->item(i, 0));
-        if (f_bv_val > f_bv_max_local.row_val) {
-            f_bv_max_local.row_val = f_bv_val;
-            f_bv_max_local.row = i;
-        }
-    }
-    MPI_Allreduce(&f_bv_max_local, &f_bv_max_global, 1,
-                  MaxRowType, RowInfoOp, MPI_COMM_WORLD);
+    Matrix M(max_basis_vectors, max_basis_vectors, false);
 
-    // Now get the first sampled row of the basis of the RHS.
-    if (f_bv_max_global.proc == myid) {
-        for (int j = 0; j < num_basis_vectors; ++j) {
-            c[j] = f_basis->item(f_bv_max_global.row, j);
-        }
+    // Per basis state: the coefficients c, the sampled rows of the basis, and
+    // the bookkeeping to unscramble them.
+    vector<vector<double> > c(num_bases);
+    vector<Matrix*> tmp_fs(num_bases);
+    vector<vector<set<int> > > proc_sampled_f_row(num_bases);
+    vector<vector<map<int, int> > > proc_f_row_to_tmp_fs_row(num_bases);
+    for (int k = 0; k < num_bases; ++k) {
+        c[k].resize(num_basis_vectors[k]);
+        tmp_fs[k] = new Matrix(num_basis_vectors[k], num_basis_vectors[k], false);
+        proc_sampled_f_row[k].resize(num_procs);
+        proc_f_row_to_tmp_fs_row[k].resize(num_procs);
     }
-    MPI_Bcast(c, num_basis_vectors, MPI_DOUBLE,
-              f_bv_max_global.proc, MPI_COMM_WORLD);
-    // Now add the first sampled row of the basis of the RHS to tmp_fs.
-    for (int j = 0; j < num_basis_vectors; ++j) {
-        tmp_fs.item(0, j) = c[j];
-    }
-    proc_sampled_f_row[f_bv_max_global.proc].insert(f_bv_max_global.row);
-    proc_f_row_to_tmp_fs_row[f_bv_max_global.proc][f_bv_max_global.row] = 0;
-
-    // Now repeat the process for the other sampled rows of the basis of the
-    // RHS.
-    for (int i = 1; i < num_basis_vectors; ++i) {
-        // If we currently know about S sampled rows of the basis of the RHS then
-        // M contains the first S columns of those S sampled rows.
-        M.setSize(i, i);
-        for (int row = 0; row < i; ++row) {
-            for (int col = 0; col < i; ++col) {
-                M.item(row, col) = tmp_fs.item(row, col);
-            }
-        }
 
-        // Invert M.
-        M.inverse();
+    // Scratch space for the bases still selecting rows at each step, their
+    // local and global maxima, and the sampled rows gathered in one buffer.
+    vector<int> active;
+    vector<int> row_offset;
+    vector<RowInfo> f_bv_max_local(num_bases), f_bv_max_global(num_bases);
+    vector<double> sampled_rows_buf;
 
-        // Now compute c, the inverse of M times the next column of the sampled
-        // rows of the basis of the RHS.
-        for (int minv_row = 0; minv_row < i; ++minv_row) {
-            double tmp = 0.0;
-            for (int minv_col = 0; minv_col < i; ++minv_col) {
-                tmp += M.item(minv_row, minv_col)*tmp_fs.item(minv_col, i);
+    for (int i = 0; i < max_basis_vectors; ++i) {
+        active.clear();
+        row_offset.assign(1, 0);
+        for (int k = 0; k < num_bases; ++k) {
+            if (i < num_basis_vectors[k]) {
+                active.push_back(k);
+                row_offset.push_back(row_offset.back() + num_basis_vectors[k]);
             }
-            c[minv_row] = tmp;
         }
+        const int num_active = static_cast<int>(active.size());
+
+        for (int a = 0; a < num_active; ++a) {
+            const int k = active[a];
+            const Matrix* f_basis = f_bases[k];
+            const Matrix& fs = *tmp_fs[k];
+
+            if (i > 0) {
+                // If we currently know about S sampled rows of the basis of the
+                // RHS then M contains the first S columns of those S sampled
+                // rows.
+                M.setSize(i, i);
+                for (int row = 0; row < i; ++row) {
+                    for (int col = 0; col < i; ++col) {
+                        M.item(row, col) = fs.item(row, col);
+                    }
+                }
 
-        // Now figure out the next sampled row of the basis of f.
-        // Compute the first S basis vectors of the RHS times c and find the
-        // row of this product have the greatest absolute value.  This is the
-        // next sampled row of the basis of f.
-        f_bv_max_local.row_val = -1.0;
-        f_bv_max_local.proc = myid;
-        for (int F_row = 0; F_row < basis_size; ++F_row) {
-            double tmp = 0.0;
-            for (int F_col = 0; F_col < i; ++F_col) {
-                tmp += f_basis->item(F_row, F_col)*c[F_col];
+                // Invert M.
+                M.inverse();
+
+                // Now compute c, the inverse of M times the next column of the
+                // sampled rows of the basis of the RHS.
+                for (int minv_row = 0; minv_row < i; ++minv_row) {
+                    double tmp = 0.0;
+                    for (int minv_col = 0; minv_col < i; ++minv_col) {
+                        tmp += M.item(minv_row, minv_col)*fs.item(minv_col, i);
+                    }
+                    c[k][minv_row] = tmp;
+                }
             }
-            double r_val = fabs(f_basis->item(F_row, i) - tmp);
-            if (r_val > f_bv_max_local.row_val) {
-                f_bv_max_local.row_val = r_val;
-                f_bv_max_local.row = F_row;
+
+            // Compute the first S basis vectors of the RHS times c and find the
+            // row of this product have the greatest absolute value.  This is
+            // the next sampled row of the basis of f.  The first row is the
+            // largest entry of the first basis vector.
+            RowInfo& local = f_bv_max_local[a];
+            local.row_val = -1.0;
+            local.row = 0;
+            local.proc = myid;
+            const int basis_size = f_basis->numRows();
+            for (int F_row = 0; F_row < basis_size; ++F_row) {
+                double tmp = 0.0;
+                for (int F_col = 0; F_col < i; ++F_col) {
+                    tmp += f_basis->item(F_row, F_col)*c[k][F_col];
+                }
+                double r_val = fabs(f_basis->item(F_row, i) - tmp);
+                if (r_val > local.row_val) {
+                    local.row_val = r_val;
+                    local.row = F_row;
+                }
             }
         }
-        MPI_Allreduce(&f_bv_max_local, &f_bv_max_global, 1,
+        MPI_Allreduce(f_bv_max_local.data(), f_bv_max_global.data(), num_active,
                       MaxRowType, RowInfoOp, MPI_COMM_WORLD);
 
-        // Now get the next sampled row of the basis of f.
-        if (f_bv_max_global.proc == myid) {
-            for (int j = 0; j < num_basis_vectors; ++j) {
-                c[j] = f_basis->item(f_bv_max_global.row, j);
+        // Now get the next sampled row of each basis.  The owners may differ,
+        // so each owner fills its part of a zeroed buffer and a sum delivers
+        // all the rows at once.
+        sampled_rows_buf.assign(row_offset.back(), 0.0);
+        for (int a = 0; a < num_active; ++a) {
+            if (f_bv_max_global[a].proc == myid) {
+                const int k = active[a];
+                for (int j = 0; j < num_basis_vectors[k]; ++j) {
+                    sampled_rows_buf[row_offset[a] + j] =
+                        f_bases[k]->item(f_bv_max_global[a].row, j);
+                }
             }
         }
-        MPI_Bcast(c, num_basis_vectors, MPI_DOUBLE,
-                  f_bv_max_global.proc, MPI_COMM_WORLD);
-        // Now add the ith sampled row of the basis of the RHS to tmp_fs.
-        for (int j = 0; j < num_basis_vectors; ++j) {
-            tmp_fs.item(i, j) = c[j];
+        MPI_Allreduce(MPI_IN_PLACE, sampled_rows_buf.data(), row_offset.back(),
+                      MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+
+        // Now add the ith sampled row of each basis to its tmp_fs.
+        for (int a = 0; a < num_active; ++a) {
+            const int k = active[a];
+            for (int j = 0; j < num_basis_vectors[k]; ++j) {
+                tmp_fs[k]->item(i, j) = sampled_rows_buf[row_offset[a] + j];
+            }
+            const int proc = f_bv_max_global[a].proc;
+            const int row = f_bv_max_global[a].row;
+            proc_sampled_f_row[k][proc].insert(row);
+            proc_f_row_to_tmp_fs_row[k][proc][row] = i;
         }
-        proc_sampled_f_row[f_bv_max_global.proc].insert(f_bv_max_global.row);
-        proc_f_row_to_tmp_fs_row[f_bv_max_global.proc][f_bv_max_global.row] = i;
     }
 
     // Fill f_sampled_row, and f_sampled_rows_per_proc.  Unscramble tmp_fs into
     // f_basis_sampled_inv.
-    int idx = 0;
-    for (int i = 0; i < num_procs; ++i) {
-        set<int>& this_proc_sampled_f_row = proc_sampled_f_row[i];
-        map<int, int>& this_proc_f_row_to_tmp_fs_row =
-            proc_f_row_to_tmp_fs_row[i];
-        f_sampled_rows_per_proc[i] = this_proc_sampled_f_row.size();
-        for (set<int>::iterator j = this_proc_sampled_f_row.begin();
-                j != this_proc_sampled_f_row.end(); ++j) {
-            int this_f_row = *j;
-            f_sampled_row[idx] = this_f_row;
-            int tmp_fs_row = this_proc_f_row_to_tmp_fs_row[this_f_row];
-            for (int col = 0; col < num_f_basis_cols; ++col) {
-                f_basis_sampled_inv.item(idx, col) = tmp_fs.item(tmp_fs_row, col);
+    f_sampled_row.resize(num_bases);
+    f_sampled_rows_per_proc.resize(num_bases);
+    for (int k = 0; k < num_bases; ++k) {
+        f_sampled_row[k].resize(num_basis_vectors[k]);
+        f_sampled_rows_per_proc[k].resize(num_procs);
+        Matrix& basis_sampled_inv = *f_basis_sampled_inv[k];
+        int idx = 0;
+        for (int i = 0; i < num_procs; ++i) {
+            set<int>& this_proc_sampled_f_row = proc_sampled_f_row[k][i];
+            map<int, int>& this_proc_f_row_to_tmp_fs_row =
+                proc_f_row_to_tmp_fs_row[k][i];
+            f_sampled_rows_per_proc[k][i] = this_proc_sampled_f_row.size();
+            for (set<int>::iterator j = this_proc_sampled_f_row.begin();
+                    j != this_proc_sampled_f_row.end(); ++j) {
+                int this_f_row = *j;
+                f_sampled_row[k][idx] = this_f_row;
+                int tmp_fs_row = this_proc_f_row_to_tmp_fs_row[this_f_row];
+                for (int col = 0; col < num_basis_vectors[k]; ++col) {
+                    basis_sampled_inv.item(idx, col) =
+                        tmp_fs[k]->item(tmp_fs_row, col);
+                }
+                ++idx;
             }
-            ++idx;
         }
-    }
 
-    // Now invert f_basis_sampled_inv.
-    f_basis_sampled_inv.inverse();
+        // Now invert f_basis_sampled_inv.
+        basis_sampled_inv.inverse();
+        delete tmp_fs[k];
+    }
 
     // Free the MPI_Datatype and MPI_Op.
     MPI_Type_free(&MaxRowType);
     MPI_Op_free(&RowInfoOp);
-
-    delete [] c;
 }
 
 }
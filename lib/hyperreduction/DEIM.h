@@ -49,6 +49,37 @@ DEIM(const Matrix* f_basis,
      int myid,
      int num_procs);
 
+/**
+ * @brief Computes the DEIM algorithm jointly on several bases.
+ *
+ * The greedy selections of all bases advance together, so each step of the
+ * algorithm performs two collectives for all the bases instead of two per
+ * basis. The results are the same as calling DEIM on each basis in turn.
+ * The bases may have different numbers of rows and basis vectors.
+ *
+ * @param[in] f_bases The bases of the RHS terms.
+ * @param[in] num_f_basis_vectors_used The number of basis vectors of each
+ *                                     basis to use in the algorithm.
+ * @param[out] f_sampled_row The local row ids of each sampled row of each
+ *                           basis, laid out as in DEIM.
+ * @param[out] f_sampled_rows_per_proc The number of sampled rows of each
+ *                                     basis on each processor.
+ * @param[out] f_basis_sampled_inv The inverse of the sampled rows of each
+ *                                 basis, allocated by the caller with
+ *                                 num_f_basis_vectors_used[k] rows and
+ *                                 columns.
+ * @param[in] myid The rank of this process.
+ * @param[in] num_procs The total number of processes.
+ */
+void
+DEIM(const std::vector<const Matrix*>& f_bases,
+     const std::vector<int>& num_f_basis_vectors_used,
+     std::vector<std::vector<int> >& f_sampled_row,
+     std::vector<std::vector<int> >& f_sampled_rows_per_proc,
+     const std::vector<Matrix*>& f_basis_sampled_inv,
+     int myid,
+     int num_procs);
+
 }
 
 #endif
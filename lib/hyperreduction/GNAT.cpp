@@ -93,17 +93,29 @@ void GNAT(const Matrix* f_basis,
                  && num_basis_vectors == f_basis_sampled_inv.numColumns());
     CAROM_VERIFY(!f_basis_sampled_inv.distributed());
     const int basis_size = f_basis->numRows();
+    const int num_f_basis_cols_total = f_basis->numColumns();
+    const double* f_basis_data = f_basis->getData();
 
     const int ns_mod_nr = num_samples % num_basis_vectors;
     int ns = 0;
 
-    // The small matrix inverted by the algorithm. We allocate the largest
-    // size needed and set the size at each step in the algorithm.
-    Matrix M(num_samples, std::max(num_basis_vectors-1, 1), false);
+    // The upper triangular factor R of a QR factorization of the sampled
+    // rows of the basis found so far. Each new sampled row is merged into R
+    // with Givens rotations, so the least squares problem for c at each step
+    // is solved by back substitution on a leading block of R instead of
+    // forming and inverting the normal equations from scratch.
+    Matrix R(num_basis_vectors, num_basis_vectors, false);
+    R = 0.0;
 
     // Scratch space used throughout the algorithm.
     double* c = new double [num_basis_vectors];
     double* sampled_row = new double [num_basis_vectors];
+    double* givens_row = new double [num_basis_vectors];
+
+    // The residual of each local row for the current basis vector, and a
+    // mask marking the local rows that have already been sampled.
+    std::vector<double> residual(basis_size);
+    std::vector<char> is_sampled(basis_size, 0);
 
     std::vector<std::set<int> > proc_sampled_f_row(num_procs);
     std::vector<std::map<int, int> > proc_f_row_to_tmp_fs_row(num_procs);
@@ -134,105 +146,43 @@ void GNAT(const Matrix* f_basis,
         }
     }
 
-    // Figure out the first sampled rows of the RHS.
     RowInfo f_bv_max_local, f_bv_max_global;
 
-    const int ns0 = 0 < ns_mod_nr ? (num_samples / num_basis_vectors) + 1 :
-                    num_samples / num_basis_vectors;
-
-    for (int k=0; k<ns0; ++k)
-    {
-        f_bv_max_local.row_val = -1.0;
-        f_bv_max_local.proc = myid;
-
-        if (k < total_num_init_samples)
-        {
-            // Take sample from init_samples on the corresponding process
-            if (k >= init_sample_offset && k - init_sample_offset < num_init_samples)
-            {
-                f_bv_max_local.row_val = 1.0;  // arbitrary number, ensuring maximum
-                f_bv_max_local.row = (*init_samples)[k - init_sample_offset];
-            }
-        }
-        else
-        {
-            // Compute sample by the greedy algorithm
-            for (int i = 0; i < basis_size; ++i) {
-                // Check whether this row has already been sampled.
-                std::set<int>::const_iterator found = proc_sampled_f_row[myid].find(i);
-                if (found == proc_sampled_f_row[myid].end()) // not found
-                {
-                    double f_bv_val = fabs(f_basis->item(i, 0));
-                    if (f_bv_val > f_bv_max_local.row_val) {
-                        f_bv_max_local.row_val = f_bv_val;
-                        f_bv_max_local.row = i;
-                    }
-                }
-            }
-        }
-
-        MPI_Allreduce(&f_bv_max_local, &f_bv_max_global, 1,
-                      MaxRowType, RowInfoOp, MPI_COMM_WORLD);
-
-        // Now get the first sampled row of the basis of the RHS.
-        if (f_bv_max_global.proc == myid) {
-            for (int j = 0; j < num_basis_vectors; ++j) {
-                sampled_row[j] = f_basis->item(f_bv_max_global.row, j);
-            }
-        }
-        MPI_Bcast(sampled_row, num_basis_vectors, MPI_DOUBLE,
-                  f_bv_max_global.proc, MPI_COMM_WORLD);
-        // Now add the first sampled row of the basis of the RHS to tmp_fs.
-        for (int j = 0; j < num_basis_vectors; ++j) {
-            tmp_fs.item(k, j) = sampled_row[j];
-        }
-        proc_sampled_f_row[f_bv_max_global.proc].insert(f_bv_max_global.row);
-        proc_f_row_to_tmp_fs_row[f_bv_max_global.proc][f_bv_max_global.row] = k;
-    }
-
-    ns += ns0;
-
-    // Now repeat the process for the other sampled rows of the basis of the RHS.
-    for (int i = 1; i < num_basis_vectors; ++i) {
+    for (int i = 0; i < num_basis_vectors; ++i) {
         const int nsi = i < ns_mod_nr ? (num_samples / num_basis_vectors) + 1 :
                         num_samples / num_basis_vectors;
 
-        // If we currently know about S sampled rows of the basis of the RHS then
-        // M contains the first i columns of those S sampled rows.
-        M.setSize(ns, i);
-        for (int row = 0; row < ns; ++row) {
-            for (int col = 0; col < i; ++col) {
-                M.item(row, col) = tmp_fs.item(row, col);
+        if (i > 0) {
+            // If we currently know about S sampled rows of the basis of the
+            // RHS then the leading i x (i+1) block of R holds the QR factor
+            // of the first i columns of those rows, and Q^T times the next
+            // column. Solve for c, the least squares fit of the next column
+            // by the previous ones.
+            for (int row = i - 1; row >= 0; --row) {
+                double tmp = R.item(row, i);
+                for (int col = row + 1; col < i; ++col) {
+                    tmp -= R.item(row, col)*c[col];
+                }
+                c[row] = tmp / R.item(row, row);
             }
         }
 
-        // Compute the pseudo-inverse of M, storing its transpose.
-        M.transposePseudoinverse();
-
-        // Now compute c, the inverse of M times the next column of the sampled
-        // rows of the basis of the RHS.
-        for (int minv_row = 0; minv_row < i; ++minv_row) {
+        // Compute the residual of the basis vector i of the RHS fit by the
+        // first i basis vectors. It does not change while the nsi samples
+        // for this basis vector are taken.
+        for (int F_row = 0; F_row < basis_size; ++F_row) {
+            const double* f_row = &f_basis_data[F_row*num_f_basis_cols_total];
             double tmp = 0.0;
-            for (int minv_col = 0; minv_col < ns; ++minv_col) {
-                if (ns == i)
-                {
-                    tmp += M.item(minv_row, minv_col)*tmp_fs.item(minv_col, i);
-                }
-                else
-                {
-                    // Transposing M^+, which is stored as its transpose.
-                    tmp += M.item(minv_col, minv_row)*tmp_fs.item(minv_col, i);
-                }
+            for (int F_col = 0; F_col < i; ++F_col) {
+                tmp += f_row[F_col]*c[F_col];
             }
-            c[minv_row] = tmp;
+            residual[F_row] = fabs(f_row[i] - tmp);
         }
 
         for (int k=0; k<nsi; ++k)
         {
-            // Now figure out the next sampled row of the basis of f.
-            // Compute the first S basis vectors of the RHS times c and find the
-            // row of this product have the greatest absolute value. This is the
-            // next sampled row of the basis of f.
+            // Now figure out the next sampled row of the basis of f. This is
+            // the unsampled row with the greatest residual.
             f_bv_max_local.row_val = -1.0;
             f_bv_max_local.proc = myid;
 
@@ -250,20 +200,10 @@ void GNAT(const Matrix* f_basis,
             {
                 // Compute sample by the greedy algorithm
                 for (int F_row = 0; F_row < basis_size; ++F_row) {
-                    // Check whether this row has already been sampled.
-                    std::set<int>::const_iterator found = proc_sampled_f_row[myid].find(F_row);
-                    if (found == proc_sampled_f_row[myid].end()) // not found
-                    {
-                        double tmp = 0.0;
-                        for (int F_col = 0; F_col < i; ++F_col) {
-                            tmp += f_basis->item(F_row, F_col)*c[F_col];
-                        }
-                        const double r_val = fabs(f_basis->item(F_row, i) - tmp);
-
-                        if (r_val > f_bv_max_local.row_val) {
-                            f_bv_max_local.row_val = r_val;
-                            f_bv_max_local.row = F_row;
-                        }
+                    if (!is_sampled[F_row] &&
+                            residual[F_row] > f_bv_max_local.row_val) {
+                        f_bv_max_local.row_val = residual[F_row];
+                        f_bv_max_local.row = F_row;
                     }
                 }
             }
@@ -276,15 +216,31 @@ void GNAT(const Matrix* f_basis,
                 for (int j = 0; j < num_basis_vectors; ++j) {
                     sampled_row[j] = f_basis->item(f_bv_max_global.row, j);
                 }
+                is_sampled[f_bv_max_global.row] = 1;
             }
             MPI_Bcast(sampled_row, num_basis_vectors, MPI_DOUBLE,
                       f_bv_max_global.proc, MPI_COMM_WORLD);
-            // Now add the ith sampled row of the basis of the RHS to tmp_fs.
+            // Now add the sampled row of the basis of the RHS to tmp_fs.
             for (int j = 0; j < num_basis_vectors; ++j) {
                 tmp_fs.item(ns+k, j) = sampled_row[j];
+                givens_row[j] = sampled_row[j];
             }
             proc_sampled_f_row[f_bv_max_global.proc].insert(f_bv_max_global.row);
             proc_f_row_to_tmp_fs_row[f_bv_max_global.proc][f_bv_max_global.row] = ns+k;
+
+            // Merge the sampled row into R with Givens rotations.
+            for (int j = 0; j < num_basis_vectors; ++j) {
+                if (givens_row[j] == 0.0) continue;
+                const double r = hypot(R.item(j, j), givens_row[j]);
+                const double cs = R.item(j, j) / r;
+                const double sn = givens_row[j] / r;
+                for (int col = j; col < num_basis_vectors; ++col) {
+                    const double r_val = R.item(j, col);
+                    const double g_val = givens_row[col];
+                    R.item(j, col) = cs*r_val + sn*g_val;
+                    givens_row[col] = cs*g_val - sn*r_val;
+                }
+            }
         }
 
         ns += nsi;
@@ -323,6 +279,7 @@ void GNAT(const Matrix* f_basis,
 
     delete [] c;
     delete [] sampled_row;
+    delete [] givens_row;
 }
 
 }
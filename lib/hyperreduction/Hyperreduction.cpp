@@ -13,6 +13,7 @@
 #include "QDEIM.h"
 #include "GNAT.h"
 #include "S_OPT.h"
+#include "Utilities.h"
 
 #include "linalg/Matrix.h"
 #include "utils/Utilities.h"
@@ -84,4 +85,60 @@ void Hyperreduction::ComputeSamples(const Matrix* f_basis,
     }
 }
 
+
+void Hyperreduction::ComputeSamples(const std::vector<const Matrix*>& f_bases,
+                                    const std::vector<int>& num_f_basis_vectors_used,
+                                    std::vector<std::vector<int> >& f_sampled_row,
+                                    std::vector<std::vector<int> >& f_sampled_rows_per_proc,
+                                    const std::vector<Matrix*>& f_basis_sampled_inv,
+                                    int myid,
+                                    int num_procs,
+                                    std::vector<int> *merged_sampled_row,
+                                    std::vector<int> *merged_rows_per_proc,
+                                    std::vector<std::vector<int> > *merged_index)
+{
+    const int num_bases = f_bases.size();
+    CAROM_VERIFY(num_bases ==
+                 static_cast<int>(num_f_basis_vectors_used.size()));
+    CAROM_VERIFY(num_bases == static_cast<int>(f_basis_sampled_inv.size()));
+
+    if (samplingType == deim)
+    {
+        DEIM(f_bases,
+             num_f_basis_vectors_used,
+             f_sampled_row,
+             f_sampled_rows_per_proc,
+             f_basis_sampled_inv,
+             myid, num_procs);
+    }
+    else
+    {
+        f_sampled_row.resize(num_bases);
+        f_sampled_rows_per_proc.resize(num_bases);
+        for (int k = 0; k < num_bases; ++k)
+        {
+            const int num_samples = f_basis_sampled_inv[k]->numRows();
+            f_sampled_row[k].assign(num_samples, 0);
+            f_sampled_rows_per_proc[k].assign(num_procs, 0);
+            ComputeSamples(f_bases[k],
+                           num_f_basis_vectors_used[k],
+                           f_sampled_row[k],
+                           f_sampled_rows_per_proc[k],
+                           *f_basis_sampled_inv[k],
+                           myid, num_procs,
+                           num_samples);
+        }
+    }
+
+    if (merged_sampled_row != NULL)
+    {
+        CAROM_VERIFY(merged_rows_per_proc != NULL && merged_index != NULL);
+        MergeSampledRows(f_sampled_row,
+                         f_sampled_rows_per_proc,
+                         *merged_sampled_row,
+                         *merged_rows_per_proc,
+                         *merged_index);
+    }
+}
+
 }
@@ -65,6 +65,46 @@ public:
                         std::vector<int> *init_samples=NULL,
                         bool qr_factorize = false);
 
+    /**
+     * @brief Computes the samples of several bases in one pass.
+     *
+     * For DEIM the greedy selections of all bases run jointly, batching
+     * their collectives. The other sampling types sample each basis in
+     * turn. When merged_sampled_row is not NULL, the bases must share the
+     * same row distribution, and the union of their samples is returned in
+     * the layout of a single basis along with the index of each basis sample
+     * in the merged set, ready for registering a sample mesh.
+     *
+     * @param[in] f_bases The bases to sample.
+     * @param[in] num_f_basis_vectors_used The number of basis vectors of
+     *                                     each basis to use.
+     * @param[out] f_sampled_row The sampled rows of each basis.
+     * @param[out] f_sampled_rows_per_proc The number of sampled rows of each
+     *                                     basis on each processor.
+     * @param[in,out] f_basis_sampled_inv The sampled basis inverse of each
+     *                                    basis, allocated by the caller with
+     *                                    as many rows as samples requested.
+     * @param[in] myid The rank of this process.
+     * @param[in] num_procs The total number of processes.
+     * @param[out] merged_sampled_row If not NULL, the merged sampled rows.
+     * @param[out] merged_rows_per_proc The number of merged rows on each
+     *                                  processor. Required if
+     *                                  merged_sampled_row is not NULL.
+     * @param[out] merged_index For each basis, the index of each of its
+     *                          samples in merged_sampled_row. Required if
+     *                          merged_sampled_row is not NULL.
+     */
+    void ComputeSamples(const std::vector<const Matrix*>& f_bases,
+                        const std::vector<int>& num_f_basis_vectors_used,
+                        std::vector<std::vector<int> >& f_sampled_row,
+                        std::vector<std::vector<int> >& f_sampled_rows_per_proc,
+                        const std::vector<Matrix*>& f_basis_sampled_inv,
+                        int myid,
+                        int num_procs,
+                        std::vector<int> *merged_sampled_row = NULL,
+                        std::vector<int> *merged_rows_per_proc = NULL,
+                        std::vector<std::vector<int> > *merged_index = NULL);
+
 private:
     SamplingType samplingType;
 };
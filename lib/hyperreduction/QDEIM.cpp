@@ -13,6 +13,7 @@
 
 #include "linalg/Matrix.h"
 #include "mpi.h"
+#include <climits>
 #include <cmath>
 
 #include <vector>
@@ -29,7 +30,8 @@ QDEIM(const Matrix* f_basis,
       Matrix& f_basis_sampled_inv,
       const int myid,
       const int num_procs,
-      const int num_samples_req)
+      const int num_samples_req,
+      QRCP_pivoting pivoting)
 {
     CAROM_VERIFY(num_procs == f_sampled_rows_per_proc.size());
 
@@ -56,22 +58,34 @@ QDEIM(const Matrix* f_basis,
     std::vector<int> f_sampled_row_owner((myid == 0
                                           && f_basis->distributed()) ? num_samples_req : 0);
 
+    // The global indices of the samples of a distributed basis, on root.
+    // They may exceed the range of int, unlike the local indices returned in
+    // f_sampled_row.
+    std::vector<GlobalIndex> global_sampled_row((myid == 0
+            && f_basis->distributed()) ? num_samples_req : 0);
+
     // QDEIM computes selection/interpolation indices by taking a
     // column-pivoted QR-decomposition of the transpose of its input matrix.
-    f_basis->qrcp_pivots_transpose(f_sampled_row.data(),
-                                   f_sampled_row_owner.data(),
-                                   num_samples_req_QR);
+    if (f_basis->distributed())
+        f_basis->qrcp_pivots_transpose(global_sampled_row.data(),
+                                       f_sampled_row_owner.data(),
+                                       num_samples_req_QR,
+                                       pivoting);
+    else
+        f_basis->qrcp_pivots_transpose(f_sampled_row.data(),
+                                       f_sampled_row_owner.data(),
+                                       num_samples_req_QR,
+                                       pivoting);
 
     if (f_basis->distributed())
     {
         // Gather the sampled rows to root process in sampled_row_data
 
-        // On root, f_sampled_row contains all global pivots.
-        // On non-root processes, it contains the local pivots.
+        // On root, global_sampled_row contains all global pivots.
 
         std::vector<int> ns((myid == 0) ? num_procs : 0);
         std::vector<int> disp((myid == 0) ? num_procs : 0);
-        std::vector<int> all_sampled_rows((myid == 0) ? num_samples_req : 0);
+        std::vector<GlobalIndex> all_sampled_rows((myid == 0) ? num_samples_req : 0);
         if (myid == 0)
         {
             for (int r=0; r<num_procs; ++r)
@@ -95,14 +109,14 @@ QDEIM(const Matrix* f_basis,
             for (int i=0; i<num_samples_req_QR; ++i)
             {
                 const int owner = f_sampled_row_owner[i];
-                all_sampled_rows[disp[owner] + ns[owner]] = f_sampled_row[i];
+                all_sampled_rows[disp[owner] + ns[owner]] = global_sampled_row[i];
                 ns[owner]++;
             }
 
-            // Reorder f_sampled_row and f_sampled_row_owner to match the order
-            // of f_basis_sampled_inv
+            // Reorder global_sampled_row and f_sampled_row_owner to match the
+            // order of f_basis_sampled_inv
             for (int i=0; i<num_samples_req_QR; ++i)
-                f_sampled_row[i] = all_sampled_rows[i];
+                global_sampled_row[i] = all_sampled_rows[i];
 
             int os = 0;
             for (int r=0; r<num_procs; ++r)
@@ -122,30 +136,19 @@ QDEIM(const Matrix* f_basis,
         int count = 0;
         MPI_Scatter(ns.data(), 1, MPI_INT, &count, 1, MPI_INT, 0, MPI_COMM_WORLD);
 
-        std::vector<int> my_sampled_rows(count);
+        std::vector<GlobalIndex> my_sampled_rows(count);
         std::vector<double> my_sampled_row_data(count*numCol);
 
-        MPI_Scatterv(all_sampled_rows.data(), ns.data(), disp.data(), MPI_INT,
-                     my_sampled_rows.data(), count, MPI_INT, 0, MPI_COMM_WORLD);
-
-        std::vector<int> row_offset(num_procs);
-        row_offset[myid] = f_basis->numRows();
+        MPI_Scatterv(all_sampled_rows.data(), ns.data(), disp.data(),
+                     CAROM_MPI_GLOBAL_INDEX, my_sampled_rows.data(), count,
+                     CAROM_MPI_GLOBAL_INDEX, 0, MPI_COMM_WORLD);
 
-        CAROM_VERIFY(MPI_Allgather(MPI_IN_PLACE, 1, MPI_INT, row_offset.data(), 1,
-                                   MPI_INT, MPI_COMM_WORLD) == MPI_SUCCESS);
+        std::vector<GlobalIndex> row_offset;
+        get_global_offsets(f_basis->numRows(), row_offset, MPI_COMM_WORLD);
 
         int os = 0;
-        for (int i=0; i<num_procs; ++i)
-        {
-            os += row_offset[i];
-            row_offset[i] = os - row_offset[i];
-        }
-
         for (int i=0; i<count; ++i)
         {
-            const int msr = my_sampled_rows[i];
-            const bool mycond = my_sampled_rows[i] >= row_offset[myid]
-                                && my_sampled_rows[i] < row_offset[myid] + f_basis->numRows();
             CAROM_VERIFY(my_sampled_rows[i] >= row_offset[myid]
                          && my_sampled_rows[i] < row_offset[myid] + f_basis->numRows());
             const int row = my_sampled_rows[i] - row_offset[myid];
@@ -173,18 +176,19 @@ QDEIM(const Matrix* f_basis,
         std::vector<int> rdsp(num_procs);
         MPI_Gather(&nf, 1, MPI_INT, rcnt.data(), 1, MPI_INT, 0, MPI_COMM_WORLD);
 
-        int nglobal = 0;
+        // Oversampling gathers a value for each row to root, which MPI
+        // addresses with int displacements.
+        const bool oversampling = num_samples_req > numCol;
+        const GlobalIndex nglobal = row_offset[num_procs];
+        CAROM_VERIFY(!oversampling || nglobal <= INT_MAX);
         rdsp[0] = 0;
-        if (myid == 0)
+        if (myid == 0 && oversampling)
         {
-            for (int i=0; i<num_procs; ++i)
-                nglobal += rcnt[i];
-
             for (int i=1; i<num_procs; ++i)
                 rdsp[i] = rdsp[i-1] + rcnt[i-1];
         }
 
-        std::set<int> globalSamples;
+        std::set<GlobalIndex> globalSamples;
         if (myid == 0)
         {
             int count = 0;
@@ -192,20 +196,21 @@ QDEIM(const Matrix* f_basis,
             {
                 for (int j=0; j<f_sampled_rows_per_proc[i]; ++j, ++count)
                 {
-                    globalSamples.insert(f_sampled_row[count]);
+                    globalSamples.insert(global_sampled_row[count]);
                 }
             }
 
             CAROM_VERIFY(count == numCol);
         }
 
-        std::vector<double> rg(myid == 0 ? nglobal : 0);
-        std::vector<int> isort(myid == 0 ? nglobal : 0);
+        std::vector<double> rg(myid == 0 && oversampling ? nglobal : 0);
+        std::vector<int> isort(myid == 0 && oversampling ? nglobal : 0);
+        std::vector<GlobalIndex> sample_of_proc((myid == 0) ? num_procs : 0);
 
         int n = numCol;
         Matrix V(n, n, false);
 
-        // At this point, only the first (numCol) entries of f_sampled_row and
+        // At this point, only the first (numCol) entries of global_sampled_row and
         // rows of sampled_row_data are set by QR. Now set the remaining
         // (num_samples_req - numCol) samples by GappyPOD+E.
 
@@ -279,46 +284,41 @@ QDEIM(const Matrix* f_basis,
                 }
                          );  // descending order
 
-                // Choose sample s as the first entry in isort not already in f_sampled_row
-                f_sampled_row[s] = -1;
+                // Choose sample s as the first entry in isort not already in global_sampled_row
+                global_sampled_row[s] = -1;
                 for (int i=0; i<nglobal; ++i)
                 {
-                    std::set<int>::iterator it = globalSamples.find(isort[i]);
+                    std::set<GlobalIndex>::iterator it = globalSamples.find(isort[i]);
                     if (it == globalSamples.end()) // not found
                     {
-                        CAROM_VERIFY(i <= s && f_sampled_row[s] == -1);
-                        f_sampled_row[s] = isort[i];
+                        CAROM_VERIFY(i <= s && global_sampled_row[s] == -1);
+                        global_sampled_row[s] = isort[i];
                         break;
                     }
                 }
 
-                CAROM_VERIFY(f_sampled_row[s] >= 0);
-                for (int i=num_procs-1; i >= 0; --i)
-                {
-                    if (f_sampled_row[s] >= row_offset[i])
-                    {
-                        owner = i;
-                        break;
-                    }
-                }
+                CAROM_VERIFY(global_sampled_row[s] >= 0);
+                owner = std::upper_bound(row_offset.begin(), row_offset.end(),
+                                         global_sampled_row[s]) - row_offset.begin() - 1;
 
                 CAROM_VERIFY(owner >= 0);
                 f_sampled_rows_per_proc[owner]++;
                 f_sampled_row_owner[s] = owner;
 
                 for (int i=0; i < num_procs; ++i)
-                    ns[i] = -1;
+                    sample_of_proc[i] = -1;
 
-                ns[owner] = f_sampled_row[s];
-                globalSamples.insert(f_sampled_row[s]);
+                sample_of_proc[owner] = global_sampled_row[s];
+                globalSamples.insert(global_sampled_row[s]);
             }
 
             // Send one row of f_basis, corresponding to sample s, to the root
             // process for f_basis_sampled_inv. First, scatter from root to tell
             // the owning process the sample index.
 
-            int sample = -1;
-            MPI_Scatter(ns.data(), 1, MPI_INT, &sample, 1, MPI_INT, 0, MPI_COMM_WORLD);
+            GlobalIndex sample = -1;
+            MPI_Scatter(sample_of_proc.data(), 1, CAROM_MPI_GLOBAL_INDEX, &sample,
+                        1, CAROM_MPI_GLOBAL_INDEX, 0, MPI_COMM_WORLD);
 
             const int tagSendRecv = 111;
             if (sample > -1)
@@ -338,10 +338,11 @@ QDEIM(const Matrix* f_basis,
             delete Ubt;
         }  // loop s over samples
 
-        // Subtract row_offset to convert f_sampled_row from global to local indices.
-        // Also, reorder f_sampled_row by process.
+        // Subtract row_offset to convert the global sample indices to local
+        // indices in f_sampled_row. Also, reorder f_sampled_row by process.
         if (myid == 0)
         {
+            std::vector<int> local_order(num_samples_req);
             ns[0] = 0;
             disp[0] = 0;
             for (int r=1; r<num_procs; ++r)
@@ -353,7 +354,7 @@ QDEIM(const Matrix* f_basis,
             for (int i=0; i<num_samples_req; ++i)
             {
                 const int owner = f_sampled_row_owner[i];
-                f_sampled_row[i] -= row_offset[owner];
+                f_sampled_row[i] = global_sampled_row[i] - row_offset[owner];
 
                 all_sampled_rows[disp[owner] + ns[owner]] = i;
                 ns[owner]++;
@@ -368,10 +369,10 @@ QDEIM(const Matrix* f_basis,
                 // Sort the local indices of f_sampled_row for process r.
                 for (int i=0; i<ns[r]; ++i)
                 {
-                    isort[i] = i;
+                    local_order[i] = i;
                 }
 
-                std::sort(isort.begin(), isort.begin() + ns[r], [&](const int& a,
+                std::sort(local_order.begin(), local_order.begin() + ns[r], [&](const int& a,
                 const int& b) {
                     return (f_sampled_row[all_sampled_rows[disp[r] + a]] <
                             f_sampled_row[all_sampled_rows[disp[r] + b]]);
@@ -380,7 +381,7 @@ QDEIM(const Matrix* f_basis,
 
                 for (int i=0; i<ns[r]; ++i)
                 {
-                    const int ig = all_sampled_rows[disp[r] + isort[i]];
+                    const int ig = all_sampled_rows[disp[r] + local_order[i]];
                     const int s = (disp[r] + i);
                     // Put row ig of sampled_row_data into row s of f_basis_sampled_inv
                     // Put entry ig of f_sampled_row into entry s of sortedRow
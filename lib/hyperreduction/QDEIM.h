@@ -14,12 +14,11 @@
 #ifndef included_QDEIM_h
 #define included_QDEIM_h
 
+#include "linalg/Matrix.h"
 #include <vector>
 
 namespace CAROM {
 
-class Matrix;
-
 /**
  * @brief Computes the QDEIM algorithm on the given basis.
  *
@@ -46,6 +45,9 @@ class Matrix;
  * @param[in] myid The rank of this process.
  * @param[in] num_procs The total number of processes.
  * @param[in] num_samples_req The minimum number of samples required.
+ * @param[in] pivoting The pivoting of the QR factorization selecting the
+ *                     first num_f_basis_vectors_used samples of a
+ *                     distributed basis.
  */
 void
 QDEIM(const Matrix* f_basis,
@@ -55,7 +57,8 @@ QDEIM(const Matrix* f_basis,
       Matrix& f_basis_sampled_inv,
       const int myid,
       const int num_procs,
-      const int num_samples_req);
+      const int num_samples_req,
+      QRCP_pivoting pivoting = QRCP_pivoting::TRUNCATED);
 }
 
 #endif
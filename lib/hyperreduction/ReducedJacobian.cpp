@@ -0,0 +1,194 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2013-2024, Lawrence Livermore National Security, LLC
+ * and other libROM project developers. See the top-level COPYRIGHT
+ * file for details.
+ *
+ * SPDX-License-Identifier: (Apache-2.0 OR MIT)
+ *
+ *****************************************************************************/
+
+// Description: Projects the Jacobian of a hyperreduced model onto the sampled
+//              rows of the reduced bases, reusing the sparsity pattern of the
+//              Jacobian over Newton iterations.
+
+#include "ReducedJacobian.h"
+#include "linalg/Matrix.h"
+#include "utils/Utilities.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace CAROM {
+
+namespace {
+
+// The number of Jacobian rows whose product with the trial basis is formed
+// before it is added to the reduced Jacobian.
+const int ROW_BLOCK_SIZE = 64;
+
+}
+
+ReducedJacobian::ReducedJacobian(
+    int num_dofs,
+    const std::vector<int>& row_ptr,
+    const std::vector<int>& col_ind,
+    const Matrix& Bsp,
+    const std::vector<int>& dof_to_row)
+{
+    analyze(num_dofs, num_dofs, row_ptr, col_ind, Bsp, dof_to_row, Bsp,
+            dof_to_row);
+}
+
+ReducedJacobian::ReducedJacobian(
+    int num_rows,
+    int num_cols,
+    const std::vector<int>& row_ptr,
+    const std::vector<int>& col_ind,
+    const Matrix& Bsp_test,
+    const std::vector<int>& row_to_test,
+    const Matrix& Bsp_trial,
+    const std::vector<int>& col_to_trial)
+{
+    analyze(num_rows, num_cols, row_ptr, col_ind, Bsp_test, row_to_test,
+            Bsp_trial, col_to_trial);
+}
+
+void
+ReducedJacobian::analyze(
+    int num_rows,
+    int num_cols,
+    const std::vector<int>& row_ptr,
+    const std::vector<int>& col_ind,
+    const Matrix& Bsp_test,
+    const std::vector<int>& row_to_test,
+    const Matrix& Bsp_trial,
+    const std::vector<int>& col_to_trial)
+{
+    CAROM_VERIFY(num_rows >= 0 && num_cols >= 0);
+    CAROM_VERIFY(!Bsp_test.distributed() && !Bsp_trial.distributed());
+    CAROM_VERIFY(static_cast<int>(row_ptr.size()) == num_rows + 1);
+    CAROM_VERIFY(row_ptr[0] == 0 &&
+                 row_ptr[num_rows] == static_cast<int>(col_ind.size()));
+    CAROM_VERIFY(row_to_test.empty() ||
+                 static_cast<int>(row_to_test.size()) == num_rows);
+    CAROM_VERIFY(col_to_trial.empty() ||
+                 static_cast<int>(col_to_trial.size()) == num_cols);
+    CAROM_VERIFY(!row_to_test.empty() || Bsp_test.numRows() == num_rows);
+    CAROM_VERIFY(!col_to_trial.empty() || Bsp_trial.numRows() == num_cols);
+
+    d_num_test_cols = Bsp_test.numColumns();
+    d_num_trial_cols = Bsp_trial.numColumns();
+    d_num_nonzeros = col_ind.size();
+
+    // Keep the rows with a test basis row and, within them, the entries whose
+    // column has a trial basis row. Trial basis rows are numbered in order of
+    // first use so that nearby entries read nearby gathered rows.
+    std::vector<int> trial_slot(num_cols, -1);
+    std::vector<int> trial_rows;
+    d_row_ptr.clear();
+    d_row_ptr.push_back(0);
+    d_entry_index.clear();
+    d_entry_col.clear();
+    d_test.clear();
+    for (int i = 0; i < num_rows; ++i)
+    {
+        const int test_row = row_to_test.empty() ? i : row_to_test[i];
+        if (test_row < 0)
+        {
+            continue;
+        }
+        CAROM_VERIFY(test_row < Bsp_test.numRows());
+
+        const size_t num_entries = d_entry_index.size();
+        for (int e = row_ptr[i]; e < row_ptr[i + 1]; ++e)
+        {
+            const int j = col_ind[e];
+            CAROM_VERIFY(0 <= j && j < num_cols);
+            const int trial_row = col_to_trial.empty() ? j : col_to_trial[j];
+            if (trial_row < 0)
+            {
+                continue;
+            }
+            CAROM_VERIFY(trial_row < Bsp_trial.numRows());
+            if (trial_slot[j] < 0)
+            {
+                trial_slot[j] = trial_rows.size();
+                trial_rows.push_back(trial_row);
+            }
+            d_entry_index.push_back(e);
+            d_entry_col.push_back(trial_slot[j]);
+        }
+        if (d_entry_index.size() == num_entries)
+        {
+            continue;
+        }
+        d_row_ptr.push_back(d_entry_index.size());
+        d_test.insert(d_test.end(),
+                      Bsp_test.getData() + test_row * d_num_test_cols,
+                      Bsp_test.getData() + (test_row + 1) * d_num_test_cols);
+    }
+
+    d_trial.resize(trial_rows.size() * d_num_trial_cols);
+    for (size_t r = 0; r < trial_rows.size(); ++r)
+    {
+        const double* src = Bsp_trial.getData() + trial_rows[r] *
+                            d_num_trial_cols;
+        std::copy(src, src + d_num_trial_cols,
+                  d_trial.data() + r * d_num_trial_cols);
+    }
+
+    d_work.resize(ROW_BLOCK_SIZE * d_num_trial_cols);
+}
+
+void
+ReducedJacobian::project(
+    const double* values,
+    Matrix& result)
+{
+    CAROM_VERIFY(!result.distributed());
+    result.setSize(d_num_test_cols, d_num_trial_cols);
+    double* r = result.getData();
+    std::memset(r, 0, sizeof(double) * d_num_test_cols * d_num_trial_cols);
+
+    const int kt = d_num_test_cols;
+    const int kc = d_num_trial_cols;
+    const int num_rows = d_row_ptr.size() - 1;
+    const double* trial = d_trial.data();
+    double* w = d_work.data();
+    for (int block = 0; block < num_rows; block += ROW_BLOCK_SIZE)
+    {
+        const int block_end = std::min(block + ROW_BLOCK_SIZE, num_rows);
+
+        // w = J_s(block, :) Bsp_trial, one row at a time.
+        for (int i = block; i < block_end; ++i)
+        {
+            double* wi = w + (i - block) * kc;
+            for (int b = 0; b < kc; ++b)
+                wi[b] = 0.0;
+            for (int e = d_row_ptr[i]; e < d_row_ptr[i + 1]; ++e)
+            {
+                const double v = values[d_entry_index[e]];
+                const double* t = trial + d_entry_col[e] * kc;
+                for (int b = 0; b < kc; ++b)
+                    wi[b] += v * t[b];
+            }
+        }
+
+        // result += Bsp_test(block, :)^T w, keeping a row of the result in
+        // cache while the rows of the block are added to it.
+        for (int a = 0; a < kt; ++a)
+        {
+            double* ra = r + a * kc;
+            for (int i = block; i < block_end; ++i)
+            {
+                const double s = d_test[i * kt + a];
+                const double* wi = w + (i - block) * kc;
+                for (int b = 0; b < kc; ++b)
+                    ra[b] += s * wi[b];
+            }
+        }
+    }
+}
+
+}
@@ -0,0 +1,236 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2013-2024, Lawrence Livermore National Security, LLC
+ * and other libROM project developers. See the top-level COPYRIGHT
+ * file for details.
+ *
+ * SPDX-License-Identifier: (Apache-2.0 OR MIT)
+ *
+ *****************************************************************************/
+
+// Description: Projects the Jacobian of a hyperreduced model onto the sampled
+//              rows of the reduced bases, reusing the sparsity pattern of the
+//              Jacobian over Newton iterations.
+
+#ifndef included_ReducedJacobian_h
+#define included_ReducedJacobian_h
+
+#include <vector>
+
+namespace CAROM {
+
+class Matrix;
+
+/**
+ * Class ReducedJacobian computes the reduced Jacobian
+ *
+ *     J_r = Bsp_test^T J_s Bsp_trial,
+ *
+ * where J_s is the Jacobian assembled on the sample mesh, stored in
+ * compressed sparse row (CSR) format, and Bsp_test, Bsp_trial are the rows of
+ * the test and trial bases on the sample mesh DOFs, e.g. as returned by
+ * SampleMeshManager::GatherDistributedMatrixRows. In a Newton solve only the
+ * values of J_s change, so the sparsity pattern is analyzed once at
+ * construction: entries whose row or column has no basis row are dropped, the
+ * basis rows that are used are gathered into contiguous storage in the order
+ * they are visited, and the column indices of the remaining entries are
+ * translated to the gathered rows. Each call to project then only reads the
+ * Jacobian values through the cached index maps.
+ *
+ * The product is formed a block of Jacobian rows at a time. J_s Bsp_trial is
+ * computed for the block with contiguous inner loops over the basis columns,
+ * and the block's contribution Bsp_test^T (J_s Bsp_trial) is added to J_r
+ * while it is still in cache, so no temporary of the size of the sample mesh
+ * is formed. The cost is O(nnz k_trial + m k_test k_trial) for nnz retained
+ * entries in m retained rows.
+ *
+ * All data is local to the process; the sample mesh and Bsp live on a single
+ * process in the SampleMeshManager workflow.
+ */
+class ReducedJacobian
+{
+public:
+    /**
+     * @brief Constructor for a Jacobian projected with the same basis on
+     *        both sides.
+     *
+     * @pre !Bsp.distributed()
+     * @pre row_ptr.size() == num_dofs + 1
+     *
+     * @param[in] num_dofs The number of rows and columns of J_s.
+     * @param[in] row_ptr The CSR row offsets of J_s.
+     * @param[in] col_ind The CSR column indices of J_s.
+     * @param[in] Bsp The rows of the basis on the sample mesh DOFs.
+     * @param[in] dof_to_row The row of Bsp of each DOF of J_s, or -1 if the
+     *                       DOF has no basis row, e.g. an essential DOF. If
+     *                       empty, DOF i is row i of Bsp and
+     *                       Bsp.numRows() == num_dofs.
+     */
+    ReducedJacobian(
+        int num_dofs,
+        const std::vector<int>& row_ptr,
+        const std::vector<int>& col_ind,
+        const Matrix& Bsp,
+        const std::vector<int>& dof_to_row = std::vector<int>());
+
+    /**
+     * @brief Constructor for a Jacobian with different test and trial
+     *        bases, e.g. an off-diagonal block of a mixed system.
+     *
+     * @pre !Bsp_test.distributed() && !Bsp_trial.distributed()
+     * @pre row_ptr.size() == num_rows + 1
+     *
+     * @param[in] num_rows The number of rows of J_s.
+     * @param[in] num_cols The number of columns of J_s.
+     * @param[in] row_ptr The CSR row offsets of J_s.
+     * @param[in] col_ind The CSR column indices of J_s.
+     * @param[in] Bsp_test The rows of the test basis on the row DOFs.
+     * @param[in] row_to_test The row of Bsp_test of each row of J_s, or -1.
+     *                        If empty, the identity.
+     * @param[in] Bsp_trial The rows of the trial basis on the column DOFs.
+     * @param[in] col_to_trial The row of Bsp_trial of each column of J_s, or
+     *                         -1. If empty, the identity.
+     */
+    ReducedJacobian(
+        int num_rows,
+        int num_cols,
+        const std::vector<int>& row_ptr,
+        const std::vector<int>& col_ind,
+        const Matrix& Bsp_test,
+        const std::vector<int>& row_to_test,
+        const Matrix& Bsp_trial,
+        const std::vector<int>& col_to_trial);
+
+    /**
+     * @brief Computes Bsp_test^T J_s Bsp_trial.
+     *
+     * @pre values holds the entries of J_s in the CSR order of the pattern
+     *      given at construction.
+     *
+     * @param[in] values The values of J_s.
+     * @param[out] result The undistributed reduced Jacobian, resized to
+     *                    numTestColumns() x numTrialColumns() if needed.
+     */
+    void
+    project(
+        const double* values,
+        Matrix& result);
+
+    /**
+     * @brief Returns the number of columns of the test basis.
+     */
+    int
+    numTestColumns() const
+    {
+        return d_num_test_cols;
+    }
+
+    /**
+     * @brief Returns the number of columns of the trial basis.
+     */
+    int
+    numTrialColumns() const
+    {
+        return d_num_trial_cols;
+    }
+
+    /**
+     * @brief Returns the number of entries of J_s in the pattern given at
+     *        construction.
+     */
+    int
+    numNonzeros() const
+    {
+        return d_num_nonzeros;
+    }
+
+    /**
+     * @brief Returns the number of entries of J_s that contribute to the
+     *        reduced Jacobian.
+     */
+    int
+    numRetainedNonzeros() const
+    {
+        return static_cast<int>(d_entry_index.size());
+    }
+
+private:
+    /**
+     * @brief Unimplemented default constructor.
+     */
+    ReducedJacobian();
+
+    /**
+     * @brief Unimplemented copy constructor.
+     */
+    ReducedJacobian(
+        const ReducedJacobian& other);
+
+    /**
+     * @brief Unimplemented assignment operator.
+     */
+    ReducedJacobian&
+    operator = (
+        const ReducedJacobian& rhs);
+
+    /**
+     * @brief Builds the index maps and gathers the basis rows.
+     */
+    void
+    analyze(
+        int num_rows,
+        int num_cols,
+        const std::vector<int>& row_ptr,
+        const std::vector<int>& col_ind,
+        const Matrix& Bsp_test,
+        const std::vector<int>& row_to_test,
+        const Matrix& Bsp_trial,
+        const std::vector<int>& col_to_trial);
+
+    /**
+     * @brief The number of columns of the test and trial bases.
+     */
+    int d_num_test_cols;
+    int d_num_trial_cols;
+
+    /**
+     * @brief The number of entries of J_s.
+     */
+    int d_num_nonzeros;
+
+    /**
+     * @brief The CSR offsets of the retained entries of each retained row.
+     */
+    std::vector<int> d_row_ptr;
+
+    /**
+     * @brief The index in the values of J_s of each retained entry.
+     */
+    std::vector<int> d_entry_index;
+
+    /**
+     * @brief The row of d_trial of each retained entry.
+     */
+    std::vector<int> d_entry_col;
+
+    /**
+     * @brief The test basis rows of the retained rows, in row order,
+     *        row-major.
+     */
+    std::vector<double> d_test;
+
+    /**
+     * @brief The trial basis rows of the retained columns, in order of first
+     *        use, row-major.
+     */
+    std::vector<double> d_trial;
+
+    /**
+     * @brief Work space for J_s Bsp_trial on a block of rows.
+     */
+    std::vector<double> d_work;
+};
+
+}
+
+#endif
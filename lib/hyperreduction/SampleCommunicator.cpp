@@ -0,0 +1,210 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2013-2024, Lawrence Livermore National Security, LLC
+ * and other libROM project developers. See the top-level COPYRIGHT
+ * file for details.
+ *
+ * SPDX-License-Identifier: (Apache-2.0 OR MIT)
+ *
+ *****************************************************************************/
+
+// Description: A compact communicator holding the samples of a hyperreduced
+//              model, so that online evaluations only involve the processes
+//              that own samples.
+
+#include "SampleCommunicator.h"
+#include "linalg/Matrix.h"
+#include "linalg/Vector.h"
+#include "utils/mpi_utils.h"
+
+#include <algorithm>
+
+namespace CAROM {
+
+SampleCommunicator::SampleCommunicator(
+    int num_local_samples,
+    int samples_per_proc,
+    MPI_Comm comm) :
+    d_parent_comm(comm),
+    d_comm(MPI_COMM_NULL),
+    d_num_original_samples(num_local_samples),
+    d_num_local_samples(0),
+    d_first_sample(0)
+{
+    CAROM_VERIFY(num_local_samples >= 0);
+    CAROM_VERIFY(samples_per_proc > 0);
+
+    int rank, num_procs;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &num_procs);
+
+    // Global sample numbering, rank-major over the original communicator.
+    std::vector<int> offsets;
+    d_num_samples = get_global_offsets(num_local_samples, offsets, comm);
+    CAROM_VERIFY(d_num_samples > 0);
+
+    d_num_active = std::min(num_procs,
+                            (d_num_samples + samples_per_proc - 1) / samples_per_proc);
+
+    // The compact layout splits the global sample numbering into contiguous,
+    // balanced blocks over the first d_num_active ranks.
+    std::vector<int> compact_offsets(num_procs + 1, d_num_samples);
+    const int block = d_num_samples / d_num_active;
+    const int extra = d_num_samples % d_num_active;
+    for (int c = 0; c < d_num_active; ++c) {
+        compact_offsets[c] = c * block + std::min(c, extra);
+    }
+
+    const bool active = rank < d_num_active;
+    if (active) {
+        d_first_sample = compact_offsets[rank];
+        d_num_local_samples = compact_offsets[rank + 1] - d_first_sample;
+    }
+
+    // Both layouts are known everywhere, so the exchange pattern follows from
+    // the overlap of the two partitions without further communication.
+    d_send_counts.assign(num_procs, 0);
+    d_send_displs.assign(num_procs, 0);
+    d_recv_counts.assign(num_procs, 0);
+    d_recv_displs.assign(num_procs, 0);
+    for (int p = 0; p < num_procs; ++p) {
+        const int send_lo = std::max(offsets[rank], compact_offsets[p]);
+        const int send_hi = std::min(offsets[rank + 1], compact_offsets[p + 1]);
+        if (send_hi > send_lo) {
+            d_send_counts[p] = send_hi - send_lo;
+            d_send_displs[p] = send_lo - offsets[rank];
+        }
+
+        const int recv_lo = std::max(offsets[p], compact_offsets[rank]);
+        const int recv_hi = std::min(offsets[p + 1], compact_offsets[rank + 1]);
+        if (recv_hi > recv_lo) {
+            d_recv_counts[p] = recv_hi - recv_lo;
+            d_recv_displs[p] = recv_lo - compact_offsets[rank];
+        }
+    }
+
+    CAROM_VERIFY(MPI_Comm_split(comm, active ? 0 : MPI_UNDEFINED, rank,
+                                &d_comm) == MPI_SUCCESS);
+}
+
+SampleCommunicator::~SampleCommunicator()
+{
+    if (d_comm != MPI_COMM_NULL) {
+        int is_mpi_finalized = 0;
+        MPI_Finalized(&is_mpi_finalized);
+        if (!is_mpi_finalized) {
+            MPI_Comm_free(&d_comm);
+        }
+    }
+}
+
+void
+SampleCommunicator::migrate(
+    const void* send,
+    void* recv,
+    int width,
+    MPI_Datatype type) const
+{
+    const int num_procs = static_cast<int>(d_send_counts.size());
+    std::vector<int> send_counts(num_procs), send_displs(num_procs);
+    std::vector<int> recv_counts(num_procs), recv_displs(num_procs);
+    for (int p = 0; p < num_procs; ++p) {
+        send_counts[p] = width * d_send_counts[p];
+        send_displs[p] = width * d_send_displs[p];
+        recv_counts[p] = width * d_recv_counts[p];
+        recv_displs[p] = width * d_recv_displs[p];
+    }
+
+    CAROM_VERIFY(MPI_Alltoallv(send, send_counts.data(), send_displs.data(), type,
+                               recv, recv_counts.data(), recv_displs.data(), type,
+                               d_parent_comm) == MPI_SUCCESS);
+}
+
+Matrix*
+SampleCommunicator::migrateRows(
+    const Matrix& B,
+    const std::vector<int>& sampled_rows) const
+{
+    CAROM_VERIFY(static_cast<int>(sampled_rows.size()) ==
+                 d_num_original_samples);
+
+    // The number of columns must agree everywhere for the packed rows to line
+    // up.
+    const int num_cols = B.numColumns();
+    CAROM_VERIFY(is_same(num_cols, d_parent_comm));
+
+    std::vector<double> send(static_cast<size_t>(d_num_original_samples) *
+                             num_cols);
+    for (int i = 0; i < d_num_original_samples; ++i) {
+        const int row = sampled_rows[i];
+        CAROM_VERIFY(0 <= row && row < B.numRows());
+        std::copy(B.getData() + static_cast<size_t>(row) * num_cols,
+                  B.getData() + static_cast<size_t>(row + 1) * num_cols,
+                  send.begin() + static_cast<size_t>(i) * num_cols);
+    }
+
+    std::vector<double> recv(static_cast<size_t>(d_num_local_samples) *
+                             num_cols);
+    migrate(send.data(), recv.data(), num_cols, MPI_DOUBLE);
+
+    if (!isActive()) {
+        return NULL;
+    }
+    return new Matrix(recv.data(), d_num_local_samples, num_cols, false, true);
+}
+
+void
+SampleCommunicator::migrateValues(
+    const std::vector<double>& values,
+    std::vector<double>& migrated) const
+{
+    CAROM_VERIFY(static_cast<int>(values.size()) == d_num_original_samples);
+    migrated.resize(d_num_local_samples);
+    migrate(values.data(), migrated.data(), 1, MPI_DOUBLE);
+}
+
+void
+SampleCommunicator::migrateValues(
+    const std::vector<int>& values,
+    std::vector<int>& migrated) const
+{
+    CAROM_VERIFY(static_cast<int>(values.size()) == d_num_original_samples);
+    migrated.resize(d_num_local_samples);
+    migrate(values.data(), migrated.data(), 1, MPI_INT);
+}
+
+void
+SampleCommunicator::sum(Vector& v) const
+{
+    CAROM_VERIFY(isActive());
+    CAROM_VERIFY(!v.distributed());
+    CAROM_VERIFY(MPI_Allreduce(MPI_IN_PLACE, v.getData(), v.dim(), MPI_DOUBLE,
+                               MPI_SUM, d_comm) == MPI_SUCCESS);
+}
+
+void
+SampleCommunicator::transposeMult(
+    const Matrix& B,
+    const Vector& r,
+    Vector& result) const
+{
+    CAROM_VERIFY(isActive());
+    CAROM_VERIFY(B.numRows() == d_num_local_samples);
+    CAROM_VERIFY(r.dim() == d_num_local_samples);
+
+    const int num_cols = B.numColumns();
+    result.setSize(num_cols);
+    for (int j = 0; j < num_cols; ++j) {
+        result(j) = 0.0;
+    }
+    for (int i = 0; i < d_num_local_samples; ++i) {
+        const double ri = r(i);
+        const double* row = B.getData() + static_cast<size_t>(i) * num_cols;
+        for (int j = 0; j < num_cols; ++j) {
+            result(j) += row[j] * ri;
+        }
+    }
+    sum(result);
+}
+
+}
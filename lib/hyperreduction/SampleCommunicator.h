@@ -0,0 +1,285 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2013-2024, Lawrence Livermore National Security, LLC
+ * and other libROM project developers. See the top-level COPYRIGHT
+ * file for details.
+ *
+ * SPDX-License-Identifier: (Apache-2.0 OR MIT)
+ *
+ *****************************************************************************/
+
+// Description: A compact communicator holding the samples of a hyperreduced
+//              model, so that online evaluations only involve the processes
+//              that own samples.
+
+#ifndef included_SampleCommunicator_h
+#define included_SampleCommunicator_h
+
+#include "mpi.h"
+#include <vector>
+
+namespace CAROM {
+
+class Matrix;
+class Vector;
+
+/**
+ * Class SampleCommunicator migrates the samples of a hyperreduced model
+ * (sampled rows from DEIM, GNAT, QDEIM or S_OPT, or EQP points) from the
+ * processes that own them in the full-order layout onto a small
+ * communicator sized to the number of samples.
+ *
+ * Samples are numbered globally in rank-major order on the original
+ * communicator. The first P ranks of the original communicator form the
+ * compact communicator, where P is the number of samples divided by the
+ * requested number of samples per process, rounded up and capped at the
+ * size of the original communicator. Each compact rank receives a
+ * contiguous block of the global sample numbering, and owns at least one
+ * sample. The remaining ranks take no part in the online collectives and
+ * may be released or reused.
+ *
+ * Construction and the migrate methods are collective over the original
+ * communicator. The reduction methods are collective over the compact
+ * communicator only and must only be called on active ranks.
+ */
+class SampleCommunicator
+{
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @pre num_local_samples >= 0
+     * @pre samples_per_proc > 0
+     * @pre The total number of samples over comm is positive.
+     *
+     * @param[in] num_local_samples The number of samples owned by this
+     *                              process in the full-order layout.
+     * @param[in] samples_per_proc The target number of samples per process
+     *                             on the compact communicator.
+     * @param[in] comm The communicator of the full-order layout.
+     */
+    SampleCommunicator(
+        int num_local_samples,
+        int samples_per_proc,
+        MPI_Comm comm = MPI_COMM_WORLD);
+
+    /**
+     * @brief Destructor. Frees the compact communicator.
+     */
+    ~SampleCommunicator();
+
+    /**
+     * @brief Returns true if this process is part of the compact
+     *        communicator.
+     */
+    bool
+    isActive() const
+    {
+        return d_comm != MPI_COMM_NULL;
+    }
+
+    /**
+     * @brief Returns the compact communicator, or MPI_COMM_NULL on processes
+     *        that are not part of it.
+     */
+    MPI_Comm
+    getComm() const
+    {
+        return d_comm;
+    }
+
+    /**
+     * @brief Returns the number of processes in the compact communicator.
+     */
+    int
+    getNumProcs() const
+    {
+        return d_num_active;
+    }
+
+    /**
+     * @brief Returns the total number of samples.
+     */
+    int
+    numSamples() const
+    {
+        return d_num_samples;
+    }
+
+    /**
+     * @brief Returns the number of samples this process owns on the compact
+     *        communicator. Zero on inactive processes.
+     */
+    int
+    numLocalSamples() const
+    {
+        return d_num_local_samples;
+    }
+
+    /**
+     * @brief Returns the global index of the first sample this process owns
+     *        on the compact communicator.
+     */
+    int
+    getFirstSample() const
+    {
+        return d_first_sample;
+    }
+
+    /**
+     * @brief Migrates the sampled rows of a matrix, such as a basis
+     *        distributed in the full-order layout, onto the compact
+     *        communicator.
+     *
+     * @pre sampled_rows.size() is the number of samples this process owns in
+     *      the full-order layout.
+     *
+     * @param[in] B The matrix whose rows are sampled, in the full-order
+     *              layout.
+     * @param[in] sampled_rows The local row indices of B of the samples
+     *                         owned by this process, in sample order.
+     *
+     * @return On active processes, an undistributed Matrix holding the
+     *         sampled rows owned by this process on the compact
+     *         communicator, in global sample order. NULL on inactive
+     *         processes.
+     */
+    Matrix*
+    migrateRows(
+        const Matrix& B,
+        const std::vector<int>& sampled_rows) const;
+
+    /**
+     * @brief Migrates per-sample values, such as EQP weights, onto the
+     *        compact communicator.
+     *
+     * @param[in] values The values of the samples owned by this process in
+     *                   the full-order layout, in sample order.
+     * @param[out] migrated The values of the samples owned by this process
+     *                      on the compact communicator. Empty on inactive
+     *                      processes.
+     */
+    void
+    migrateValues(
+        const std::vector<double>& values,
+        std::vector<double>& migrated) const;
+
+    /**
+     * @brief Migrates per-sample integer data, such as sampled row or
+     *        element indices, onto the compact communicator.
+     *
+     * @param[in] values The values of the samples owned by this process in
+     *                   the full-order layout, in sample order.
+     * @param[out] migrated The values of the samples owned by this process
+     *                      on the compact communicator. Empty on inactive
+     *                      processes.
+     */
+    void
+    migrateValues(
+        const std::vector<int>& values,
+        std::vector<int>& migrated) const;
+
+    /**
+     * @brief Sums v over the compact communicator, in place.
+     *
+     * @pre isActive()
+     * @pre !v.distributed()
+     *
+     * @param[in,out] v The Vector to sum.
+     */
+    void
+    sum(Vector& v) const;
+
+    /**
+     * @brief Computes the reduced quantity B^T r summed over the compact
+     *        communicator, where B holds the sampled rows returned by
+     *        migrateRows and r the sampled values on this process.
+     *
+     * @pre isActive()
+     * @pre B.numRows() == numLocalSamples() == r.dim()
+     *
+     * @param[in] B The migrated sampled rows owned by this process.
+     * @param[in] r The sampled values owned by this process.
+     * @param[out] result The reduced Vector, the same on all active
+     *                    processes.
+     */
+    void
+    transposeMult(
+        const Matrix& B,
+        const Vector& r,
+        Vector& result) const;
+
+private:
+    /**
+     * @brief Unimplemented copy constructor.
+     */
+    SampleCommunicator(
+        const SampleCommunicator& other);
+
+    /**
+     * @brief Unimplemented assignment operator.
+     */
+    SampleCommunicator&
+    operator = (
+        const SampleCommunicator& rhs);
+
+    /**
+     * @brief Sends width entries of type per sample from the full-order
+     *        layout to the compact layout.
+     */
+    void
+    migrate(
+        const void* send,
+        void* recv,
+        int width,
+        MPI_Datatype type) const;
+
+    /**
+     * @brief The communicator of the full-order layout.
+     */
+    MPI_Comm d_parent_comm;
+
+    /**
+     * @brief The compact communicator, MPI_COMM_NULL if inactive.
+     */
+    MPI_Comm d_comm;
+
+    /**
+     * @brief The number of processes in the compact communicator.
+     */
+    int d_num_active;
+
+    /**
+     * @brief The total number of samples.
+     */
+    int d_num_samples;
+
+    /**
+     * @brief The number of samples owned by this process in the full-order
+     *        layout.
+     */
+    int d_num_original_samples;
+
+    /**
+     * @brief The number of samples owned by this process in the compact
+     *        layout.
+     */
+    int d_num_local_samples;
+
+    /**
+     * @brief The global index of the first sample owned by this process in
+     *        the compact layout.
+     */
+    int d_first_sample;
+
+    /**
+     * @brief The number of samples sent to and received from each process
+     *        of the original communicator, with their displacements.
+     */
+    std::vector<int> d_send_counts, d_send_displs;
+    std::vector<int> d_recv_counts, d_recv_displs;
+};
+
+}
+
+#endif
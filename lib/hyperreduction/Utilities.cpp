@@ -11,6 +11,10 @@
 // Description: Holds common utilities used among the different sampling algorithms.
 
 #include "Utilities.h"
+#include "utils/Utilities.h"
+
+#include <algorithm>
+#include <set>
 
 namespace CAROM {
 
@@ -27,4 +31,62 @@ RowInfoMax(RowInfo* a, RowInfo* b, int* len, MPI_Datatype* type)
     }
 }
 
+
+void
+MergeSampledRows(
+    const std::vector<std::vector<int> >& f_sampled_row,
+    const std::vector<std::vector<int> >& f_sampled_rows_per_proc,
+    std::vector<int>& merged_sampled_row,
+    std::vector<int>& merged_rows_per_proc,
+    std::vector<std::vector<int> >& merged_index)
+{
+    const int num_bases = static_cast<int>(f_sampled_row.size());
+    CAROM_VERIFY(num_bases > 0);
+    CAROM_VERIFY(num_bases ==
+                 static_cast<int>(f_sampled_rows_per_proc.size()));
+    const int num_procs = static_cast<int>(f_sampled_rows_per_proc[0].size());
+
+    merged_sampled_row.clear();
+    merged_rows_per_proc.assign(num_procs, 0);
+    merged_index.resize(num_bases);
+
+    // Offset of each processor's rows in the input of each basis.
+    std::vector<int> offset(num_bases, 0);
+    for (int k = 0; k < num_bases; ++k) {
+        CAROM_VERIFY(num_procs ==
+                     static_cast<int>(f_sampled_rows_per_proc[k].size()));
+        merged_index[k].resize(f_sampled_row[k].size());
+    }
+
+    for (int p = 0; p < num_procs; ++p) {
+        std::set<int> rows;
+        for (int k = 0; k < num_bases; ++k) {
+            for (int s = 0; s < f_sampled_rows_per_proc[k][p]; ++s) {
+                rows.insert(f_sampled_row[k][offset[k] + s]);
+            }
+        }
+
+        // The rows are sorted, so each basis row is found by binary search
+        // in the merged rows of this processor.
+        const int first = static_cast<int>(merged_sampled_row.size());
+        merged_sampled_row.insert(merged_sampled_row.end(), rows.begin(),
+                                  rows.end());
+        merged_rows_per_proc[p] = static_cast<int>(rows.size());
+        for (int k = 0; k < num_bases; ++k) {
+            for (int s = 0; s < f_sampled_rows_per_proc[k][p]; ++s) {
+                const int row = f_sampled_row[k][offset[k] + s];
+                merged_index[k][offset[k] + s] = static_cast<int>(
+                    std::lower_bound(merged_sampled_row.begin() + first,
+                                     merged_sampled_row.end(), row) -
+                    merged_sampled_row.begin());
+            }
+            offset[k] += f_sampled_rows_per_proc[k][p];
+        }
+    }
+
+    for (int k = 0; k < num_bases; ++k) {
+        CAROM_VERIFY(offset[k] == static_cast<int>(f_sampled_row[k].size()));
+    }
+}
+
 }
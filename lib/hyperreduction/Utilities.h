@@ -14,6 +14,7 @@
 #define included_Utilities_h
 
 #include "mpi.h"
+#include <vector>
 
 namespace CAROM {
 
@@ -35,6 +36,31 @@ typedef struct
  */
 void RowInfoMax(RowInfo* a, RowInfo* b, int* len, MPI_Datatype* type);
 
+/**
+ * @brief Merges the sampled rows of several bases sharing the same row
+ *        distribution into one sample set.
+ *
+ * The inputs are laid out as returned by the sampling algorithms: the local
+ * row ids of all processors, grouped by processor in ascending order, with
+ * the number of rows of each processor. The merged set uses the same layout,
+ * so it can be passed wherever the samples of a single basis are expected.
+ *
+ * @param[in] f_sampled_row The sampled rows of each basis.
+ * @param[in] f_sampled_rows_per_proc The number of sampled rows of each basis
+ *                                    on each processor.
+ * @param[out] merged_sampled_row The union of the sampled rows.
+ * @param[out] merged_rows_per_proc The number of merged rows on each
+ *                                  processor.
+ * @param[out] merged_index For each basis, the index in merged_sampled_row of
+ *                          each of its sampled rows.
+ */
+void MergeSampledRows(
+    const std::vector<std::vector<int> >& f_sampled_row,
+    const std::vector<std::vector<int> >& f_sampled_rows_per_proc,
+    std::vector<int>& merged_sampled_row,
+    std::vector<int>& merged_rows_per_proc,
+    std::vector<std::vector<int> >& merged_index);
+
 }
 
 #endif
@@ -16,9 +16,16 @@
 #include "linalg/Options.h"
 #include "linalg/Matrix.h"
 #include "linalg/Vector.h"
+#include "linalg/TuckerDecomposition.h"
+#include "linalg/SVDSelection.h"
+#include "linalg/ReducedEnsemble.h"
+#include "linalg/OnlineLinearAlgebra.h"
 #include "algo/DMD.h"
 #include "algo/AdaptiveDMD.h"
 #include "algo/NonuniformDMD.h"
+#include "algo/KernelDMD.h"
+#include "algo/DMDPredictor.h"
+#include "algo/WindowedDMD.h"
 #include "algo/ParametricDMD.h"
 #include "algo/DifferentialEvolution.h"
 #include "algo/greedy/GreedyCustomSampler.h"
@@ -28,8 +35,13 @@
 #include "hyperreduction/DEIM.h"
 #include "hyperreduction/GNAT.h"
 #include "hyperreduction/QDEIM.h"
+#include "hyperreduction/ReducedJacobian.h"
 #include "hyperreduction/S_OPT.h"
+#include "hyperreduction/SampleCommunicator.h"
 #include "hyperreduction/STSampling.h"
+#include "utils/FirstTouch.h"
+#include "utils/AllreducePlan.h"
+#include "utils/SyntheticSnapshots.h"
 #ifdef USEMFEM
 #include "mfem/SampleMesh.hpp"
 #endif
@@ -15,6 +15,7 @@
 //              vector generation.
 
 #include "BasisGenerator.h"
+#include "SVDSelection.h"
 #include "svd/StaticSVD.h"
 #include "svd/RandomizedSVD.h"
 #include "svd/IncrementalSVDStandard.h"
@@ -35,12 +36,30 @@ BasisGenerator::BasisGenerator(
     d_incremental(incremental),
     d_basis_writer(0),
     d_basis_reader(0),
-    d_write_snapshots(options.write_snapshots)
+    d_write_snapshots(options.write_snapshots),
+    d_weighted_basis(NULL),
+    d_weighted_snapshots(NULL)
 {
     CAROM_VERIFY(options.dim > 0);
     CAROM_VERIFY(options.max_num_samples > 0);
     CAROM_VERIFY(options.singular_value_tol >= 0);
     CAROM_VERIFY(options.max_basis_dimension > 0);
+    if (options.auto_svd)
+    {
+        options = selectSVDBackend(options, incremental);
+    }
+    if (!options.inner_product_weight.empty())
+    {
+        CAROM_VERIFY(static_cast<int>(options.inner_product_weight.size()) ==
+                     options.dim);
+        d_sqrt_weight.resize(options.dim);
+        for (int i = 0; i < options.dim; ++i)
+        {
+            CAROM_VERIFY(options.inner_product_weight[i] > 0.0);
+            d_sqrt_weight[i] = sqrt(options.inner_product_weight[i]);
+        }
+        d_weighted_sample.resize(options.dim);
+    }
     if (incremental)
     {
         CAROM_VERIFY(options.linearity_tol > 0.0);
@@ -143,7 +162,74 @@ BasisGenerator::takeSample(
         return false;
     }
 
-    return d_svd->takeSample(u_in, add_without_increase);
+    return takeWeightedSample(u_in, add_without_increase);
+}
+
+bool
+BasisGenerator::takeWeightedSample(
+    double* u_in,
+    bool add_without_increase)
+{
+    clearWeightedCache();
+    if (d_sqrt_weight.empty()) {
+        return d_svd->takeSample(u_in, add_without_increase);
+    }
+
+    for (int i = 0; i < d_dim; ++i) {
+        d_weighted_sample[i] = d_sqrt_weight[i] * u_in[i];
+    }
+    return d_svd->takeSample(d_weighted_sample.data(), add_without_increase);
+}
+
+const Matrix*
+BasisGenerator::getSpatialBasis()
+{
+    if (d_sqrt_weight.empty()) {
+        return d_svd->getSpatialBasis();
+    }
+
+    if (!d_weighted_basis) {
+        d_weighted_basis = unweight(d_svd->getSpatialBasis());
+    }
+    return d_weighted_basis;
+}
+
+const Matrix*
+BasisGenerator::getSnapshotMatrix()
+{
+    if (d_sqrt_weight.empty()) {
+        return d_svd->getSnapshotMatrix();
+    }
+
+    if (!d_weighted_snapshots) {
+        d_weighted_snapshots = unweight(d_svd->getSnapshotMatrix());
+    }
+    return d_weighted_snapshots;
+}
+
+Matrix*
+BasisGenerator::unweight(
+    const Matrix* mat) const
+{
+    CAROM_VERIFY(mat->numRows() == d_dim);
+
+    Matrix* result = new Matrix(*mat);
+    for (int i = 0; i < d_dim; ++i) {
+        const double inv_sqrt_weight = 1.0 / d_sqrt_weight[i];
+        for (int j = 0; j < result->numColumns(); ++j) {
+            result->item(i, j) *= inv_sqrt_weight;
+        }
+    }
+    return result;
+}
+
+void
+BasisGenerator::clearWeightedCache()
+{
+    delete d_weighted_basis;
+    d_weighted_basis = NULL;
+    delete d_weighted_snapshots;
+    d_weighted_snapshots = NULL;
 }
 
 void
@@ -187,7 +273,7 @@ BasisGenerator::loadSampleRange(const std::string& base_file_name,
                 u_in[i] = mat->item(i,j);
             }
         }
-        d_svd->takeSample(u_in, false);
+        takeWeightedSample(u_in, false);
         delete[] u_in;
     }
 }
@@ -220,8 +306,18 @@ BasisGenerator::computeNextSampleTime(
             return d_next_sample_time;
         }
 
+        // With a weighted inner product, project in the weighted space,
+        // where the basis of the SVD is orthonormal.
+        Vector rhs_vec(rhs_in, dim, true);
+        if (!d_sqrt_weight.empty()) {
+            for (int i = 0; i < dim; ++i) {
+                u_vec(i) *= d_sqrt_weight[i];
+                rhs_vec(i) *= d_sqrt_weight[i];
+            }
+        }
+
         // Get the current basis vectors.
-        const Matrix* basis = getSpatialBasis();
+        const Matrix* basis = d_svd->getSpatialBasis();
 
         // Compute l = basis' * u
         Vector* l = basis->transposeMult(u_vec);
@@ -236,7 +332,6 @@ BasisGenerator::computeNextSampleTime(
         delete basisl;
 
         // Compute l = basis' * rhs
-        Vector rhs_vec(rhs_in, dim, true);
         l = basis->transposeMult(rhs_vec);
 
         // basisl = basis * l
@@ -253,6 +348,9 @@ BasisGenerator::computeNextSampleTime(
         double local_norm = 0.0;
         for (int i = 0; i < dim; ++i) {
             double val = fabs(eta->item(i) + d_dt*eta_dot->item(i));
+            if (!d_sqrt_weight.empty()) {
+                val /= d_sqrt_weight[i];
+            }
             if (val > local_norm) {
                 local_norm = val;
             }
@@ -388,6 +486,7 @@ BasisGenerator::~BasisGenerator()
     if (d_basis_reader) {
         delete d_basis_reader;
     }
+    clearWeightedCache();
 }
 
 }
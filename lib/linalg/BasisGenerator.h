@@ -194,13 +194,13 @@ public:
      * @brief Returns the basis vectors for the current time interval as a
      * Matrix.
      *
+     * If an inner product weight was set in the Options, the basis is
+     * orthonormal in that weighted inner product.
+     *
      * @return The basis vectors for the current time interval.
      */
     const Matrix*
-    getSpatialBasis()
-    {
-        return d_svd->getSpatialBasis();
-    }
+    getSpatialBasis();
 
     /**
      * @brief Returns the temporal basis vectors for the current time interval as a
@@ -232,10 +232,7 @@ public:
      * @return The snapshot matrix for the current time interval.
      */
     const Matrix*
-    getSnapshotMatrix()
-    {
-        return d_svd->getSnapshotMatrix();
-    }
+    getSnapshotMatrix();
 
     /**
      * @brief Returns the number of samples taken.
@@ -314,6 +311,38 @@ private:
     resetDt(
         double new_dt);
 
+    /**
+     * @brief Passes a sample to the SVD, scaling it by the square root of the
+     *        inner product weight if one is set.
+     *
+     * @param[in] u_in The sample.
+     * @param[in] add_without_increase Passed on to SVD::takeSample.
+     *
+     * @return True if the sampling was successful.
+     */
+    bool
+    takeWeightedSample(
+        double* u_in,
+        bool add_without_increase);
+
+    /**
+     * @brief Returns a copy of a matrix from the SVD with its rows divided by
+     *        the square root of the inner product weight.
+     *
+     * @param[in] mat The matrix in the weighted space.
+     *
+     * @return The unweighted copy, owned by the caller.
+     */
+    Matrix*
+    unweight(
+        const Matrix* mat) const;
+
+    /**
+     * @brief Deletes the cached unweighted basis and snapshot matrix.
+     */
+    void
+    clearWeightedCache();
+
     /**
      * @brief Returns the dimension of the system on this processor.
      *
@@ -383,6 +412,27 @@ private:
      * Equivalent to d_svd->getDim().
      */
     const int d_dim;
+
+    /**
+     * @brief Square root of the inner product weight. Empty if the Euclidean
+     *        inner product is used.
+     */
+    std::vector<double> d_sqrt_weight;
+
+    /**
+     * @brief Scratch space holding a sample scaled by d_sqrt_weight.
+     */
+    std::vector<double> d_weighted_sample;
+
+    /**
+     * @brief The basis returned by getSpatialBasis when weighted.
+     */
+    Matrix* d_weighted_basis;
+
+    /**
+     * @brief The snapshot matrix returned by getSnapshotMatrix when weighted.
+     */
+    Matrix* d_weighted_snapshots;
 };
 
 }
@@ -54,7 +54,7 @@ BasisReader::BasisReader(
             For MPIO case, local dimension needs to be specified.
             We allow 0 local dimension. (global dimension still needs to be positive)
         */
-        std::vector<int> tmp;
+        std::vector<GlobalIndex> tmp;
         d_global_dim = get_global_offsets(d_dim, tmp, MPI_COMM_WORLD);
         CAROM_VERIFY(d_dim >= 0);
         CAROM_VERIFY(d_global_dim > 0);
@@ -278,14 +278,14 @@ BasisReader::getDim(
                  (kind == "temporal_basis"));
 
     char tmp[100];
-    int num_rows;
+    GlobalIndex num_rows;
 
     if (kind == "basis") sprintf(tmp, "spatial_basis_num_rows");
     else if (kind == "snapshot") sprintf(tmp, "snapshot_matrix_num_rows");
     else if (kind == "temporal_basis") sprintf(tmp,
                 "temporal_basis_num_rows");
 
-    d_database->getInteger(tmp, num_rows);
+    d_database->getInteger64(tmp, num_rows);
     /* only basis and snapshot are stored as distributed matrices */
     if ((kind != "temporal_basis") && (d_format == Database::formats::HDF5_MPIO))
     {
@@ -297,7 +297,7 @@ BasisReader::getDim(
         return d_dim;
     }
     else
-        return num_rows;
+        return static_cast<int>(num_rows);
 }
 
 int
@@ -15,6 +15,7 @@
 
 #include "utils/Utilities.h"
 #include "utils/Database.h"
+#include "utils/mpi_utils.h"
 #include <string>
 #include <vector>
 
@@ -308,11 +309,11 @@ private:
     const int d_dim;
 
     /**
-     * @brief Dimension of the basis on this processor.
+     * @brief Dimension of the basis over all processors.
      *
      * If negative, use the dimension from the rank-specific local file.
      */
-    int d_global_dim;
+    GlobalIndex d_global_dim;
 };
 
 }
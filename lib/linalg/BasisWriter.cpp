@@ -17,6 +17,7 @@
 #include "Vector.h"
 #include "BasisGenerator.h"
 #include "utils/Utilities.h"
+#include "utils/mpi_utils.h"
 
 #include "mpi.h"
 
@@ -84,11 +85,12 @@ BasisWriter::writeBasis(const std::string& kind)
         /* spatial basis is always distributed */
         CAROM_VERIFY(basis->distributed());
         int num_rows = basis->numRows();
-        int nrows_infile = num_rows;
+        GlobalIndex nrows_infile = num_rows;
         if (db_format_ == Database::formats::HDF5_MPIO)
-            MPI_Allreduce(MPI_IN_PLACE, &nrows_infile, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+            MPI_Allreduce(MPI_IN_PLACE, &nrows_infile, 1, CAROM_MPI_GLOBAL_INDEX,
+                          MPI_SUM, MPI_COMM_WORLD);
         sprintf(tmp, "spatial_basis_num_rows");
-        d_database->putInteger(tmp, nrows_infile);
+        d_database->putInteger64(tmp, nrows_infile);
         int num_cols = basis->numColumns();
         sprintf(tmp, "spatial_basis_num_cols");
         d_database->putInteger(tmp, num_cols);
@@ -128,11 +130,12 @@ BasisWriter::writeBasis(const std::string& kind)
         /* snapshot matrix is always distributed */
         CAROM_VERIFY(snapshots->distributed());
         int num_rows = snapshots->numRows(); // d_dim
-        int nrows_infile = num_rows;
+        GlobalIndex nrows_infile = num_rows;
         if (db_format_ == Database::formats::HDF5_MPIO)
-            MPI_Allreduce(MPI_IN_PLACE, &nrows_infile, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+            MPI_Allreduce(MPI_IN_PLACE, &nrows_infile, 1, CAROM_MPI_GLOBAL_INDEX,
+                          MPI_SUM, MPI_COMM_WORLD);
         sprintf(tmp, "snapshot_matrix_num_rows");
-        d_snap_database->putInteger(tmp, nrows_infile);
+        d_snap_database->putInteger64(tmp, nrows_infile);
         int num_cols = snapshots->numColumns(); // d_num_samples
         sprintf(tmp, "snapshot_matrix_num_cols");
         d_snap_database->putInteger(tmp, num_cols);
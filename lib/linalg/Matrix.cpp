@@ -15,11 +15,14 @@
 #include "Matrix.h"
 #include "utils/HDFDatabase.h"
 #include "utils/mpi_utils.h"
+#include "utils/AllreducePlan.h"
 
 #include "mpi.h"
 #include <string.h>
 #include <vector>
 #include <random>
+#include <algorithm>
+#include <climits>
 
 #ifdef CAROM_HAS_ELEMENTAL
 #include <El.hpp>
@@ -60,6 +63,91 @@ extern "C" {
 
 namespace CAROM {
 
+namespace {
+
+// Removes from each unselected row of the row-major residual its component
+// along pivot_row, of squared norm pivot_norm2, and recomputes the squared
+// norms of these rows. Selected rows have a negative squared norm and are
+// skipped. q is work space of length num_cols.
+void
+project_out_pivot(double* residual,
+                  double* norm2,
+                  int num_rows,
+                  int num_cols,
+                  const double* pivot_row,
+                  double pivot_norm2,
+                  double* q)
+{
+    // Past the rank of the rows there is nothing left to project out.
+    if (pivot_norm2 <= 0.0) {
+        return;
+    }
+
+    const double scale = 1.0 / sqrt(pivot_norm2);
+    for (int j = 0; j < num_cols; ++j) {
+        q[j] = scale * pivot_row[j];
+    }
+    for (int i = 0; i < num_rows; ++i) {
+        if (norm2[i] < 0.0) {
+            continue;
+        }
+        double* r = residual + static_cast<size_t>(i) * num_cols;
+        double c = 0.0;
+        for (int j = 0; j < num_cols; ++j) {
+            c += r[j] * q[j];
+        }
+        double s = 0.0;
+        for (int j = 0; j < num_cols; ++j) {
+            r[j] -= c * q[j];
+            s += r[j] * r[j];
+        }
+        norm2[i] = s;
+    }
+}
+
+// Computes the leading num_pivots column pivots of a QRCP of the transpose of
+// the row-major num_rows x num_cols matrix rows, as local row indices. Fewer
+// pivots are returned if there are fewer rows.
+void
+local_row_pivots(const double* rows,
+                 int num_rows,
+                 int num_cols,
+                 int num_pivots,
+                 std::vector<int>& pivots)
+{
+    std::vector<double> residual(rows,
+                                 rows + static_cast<size_t>(num_rows) * num_cols);
+    std::vector<double> norm2(num_rows);
+    std::vector<double> pivot_row(num_cols);
+    std::vector<double> q(num_cols);
+    for (int i = 0; i < num_rows; ++i) {
+        double s = 0.0;
+        for (int j = 0; j < num_cols; ++j) {
+            s += rows[i * num_cols + j] * rows[i * num_cols + j];
+        }
+        norm2[i] = s;
+    }
+
+    pivots.clear();
+    for (int p = 0; p < std::min(num_pivots, num_rows); ++p) {
+        int best = 0;
+        for (int i = 1; i < num_rows; ++i) {
+            if (norm2[i] > norm2[best]) {
+                best = i;
+            }
+        }
+        pivots.push_back(best);
+        std::copy(residual.begin() + best * num_cols,
+                  residual.begin() + (best + 1) * num_cols,
+                  pivot_row.begin());
+        project_out_pivot(residual.data(), norm2.data(), num_rows, num_cols,
+                          pivot_row.data(), norm2[best], q.data());
+        norm2[best] = -1.0;
+    }
+}
+
+}
+
 Matrix::Matrix() :
     d_mat(NULL),
     d_alloc_size(0),
@@ -77,7 +165,7 @@ Matrix::Matrix(
     d_distributed(distributed),
     d_owns_data(true)
 {
-    CAROM_VERIFY(num_rows > 0);
+    CAROM_VERIFY(num_rows > 0 || (distributed && num_rows == 0));
     CAROM_VERIFY(num_cols > 0);
     int mpi_init;
     MPI_Initialized(&mpi_init);
@@ -127,7 +215,7 @@ Matrix::Matrix(
     }
     if (copy_data) {
         setSize(num_rows, num_cols);
-        memcpy(d_mat, mat, d_alloc_size*sizeof(double));
+        first_touch_copy(d_mat, mat, d_alloc_size);
     }
     else {
         d_mat = mat;
@@ -158,7 +246,7 @@ Matrix::Matrix(
         d_rank = 0;
     }
     setSize(other.d_num_rows, other.d_num_cols);
-    memcpy(d_mat, other.d_mat, d_alloc_size*sizeof(double));
+    first_touch_copy(d_mat, other.d_mat, d_alloc_size);
 }
 
 Matrix::~Matrix()
@@ -175,7 +263,7 @@ Matrix::operator = (
     d_distributed = rhs.d_distributed;
     d_num_procs = rhs.d_num_procs;
     setSize(rhs.d_num_rows, rhs.d_num_cols);
-    memcpy(d_mat, rhs.d_mat, d_num_rows*d_num_cols*sizeof(double));
+    first_touch_copy(d_mat, rhs.d_mat, d_num_rows*d_num_cols);
     return *this;
 }
 
@@ -218,15 +306,15 @@ Matrix::balanced() const
     const MPI_Comm comm = MPI_COMM_WORLD;
 
     // Otherwise, get the total number of rows of the matrix.
-    int num_total_rows = numDistributedRows();
+    const GlobalIndex num_total_rows = numDistributedRows();
 
     const int first_rank_with_fewer = num_total_rows % d_num_procs;
     int my_rank;
     CAROM_VERIFY(MPI_Comm_rank(comm, &my_rank) == MPI_SUCCESS);
 
-    const int  min_rows_per_rank = num_total_rows / d_num_procs;
+    const GlobalIndex min_rows_per_rank = num_total_rows / d_num_procs;
     const bool has_extra_row     = my_rank < first_rank_with_fewer;
-    const int  max_rows_on_rank  = min_rows_per_rank + has_extra_row;
+    const GlobalIndex max_rows_on_rank  = min_rows_per_rank + has_extra_row;
     const bool has_enough_rows   = (d_num_rows >= min_rows_per_rank);
     const bool has_too_many_rows = (d_num_rows > max_rows_on_rank);
 
@@ -316,8 +404,7 @@ Matrix::mult(
     Matrix*& result) const
 {
     CAROM_VERIFY(result == 0 || result->distributed() == distributed());
-    CAROM_VERIFY(!other.distributed());
-    CAROM_VERIFY(numColumns() == other.numRows());
+    CAROM_VERIFY(numColumns() == other.numDistributedRows());
 
     // If the result has not been allocated then do so.  Otherwise size it
     // correctly.
@@ -328,6 +415,11 @@ Matrix::mult(
         result->setSize(d_num_rows, other.d_num_cols);
     }
 
+    if (other.distributed()) {
+        mult_distributed_other(other, *result);
+        return;
+    }
+
     // Do the multiplication.
     for (int this_row = 0; this_row < d_num_rows; ++this_row) {
         for (int other_col = 0; other_col < other.d_num_cols; ++other_col) {
@@ -346,12 +438,16 @@ Matrix::mult(
     Matrix& result) const
 {
     CAROM_VERIFY(result.distributed() == distributed());
-    CAROM_VERIFY(!other.distributed());
-    CAROM_VERIFY(numColumns() == other.numRows());
+    CAROM_VERIFY(numColumns() == other.numDistributedRows());
 
     // Size result correctly.
     result.setSize(d_num_rows, other.d_num_cols);
 
+    if (other.distributed()) {
+        mult_distributed_other(other, result);
+        return;
+    }
+
     // Do the multiplication.
     for (int this_row = 0; this_row < d_num_rows; ++this_row) {
         for (int other_col = 0; other_col < other.d_num_cols; ++other_col) {
@@ -364,6 +460,91 @@ Matrix::mult(
     }
 }
 
+void
+Matrix::mult_distributed_other(
+    const Matrix& other,
+    Matrix& result) const
+{
+    CAROM_VERIFY(other.distributed());
+    CAROM_VERIFY(numColumns() == other.numDistributedRows());
+    CAROM_VERIFY(result.numRows() == d_num_rows);
+    CAROM_VERIFY(result.numColumns() == other.d_num_cols);
+
+    const int num_cols = other.d_num_cols;
+    std::vector<int> panel_offsets;
+    get_global_offsets(other.d_num_rows, panel_offsets, MPI_COMM_WORLD);
+
+    for (int i = 0; i < d_num_rows*num_cols; ++i) {
+        result.d_mat[i] = 0.0;
+    }
+
+    if (!d_distributed) {
+        // Every process holds all rows of this, so each one multiplies the
+        // column block of this matching its own panel of other and the
+        // partial products are summed.
+        const int offset = panel_offsets[d_rank];
+        for (int this_row = 0; this_row < d_num_rows; ++this_row) {
+            double* result_row = &result.d_mat[this_row*num_cols];
+            for (int entry = 0; entry < other.d_num_rows; ++entry) {
+                const double a = item(this_row, offset + entry);
+                const double* other_row = &other.d_mat[entry*num_cols];
+                for (int other_col = 0; other_col < num_cols; ++other_col) {
+                    result_row[other_col] += a*other_row[other_col];
+                }
+            }
+        }
+        if (d_num_procs > 1) {
+            CAROM_VERIFY(MPI_Allreduce(MPI_IN_PLACE,
+                                       result.d_mat,
+                                       d_num_rows*num_cols,
+                                       MPI_DOUBLE,
+                                       MPI_SUM,
+                                       MPI_COMM_WORLD) == MPI_SUCCESS);
+        }
+        return;
+    }
+
+    // Both operands are distributed. Broadcast the row panels of other one
+    // process at a time so that only the largest panel is ever held in
+    // addition to the local data.
+    int max_panel_rows = 0;
+    for (int rank = 0; rank < d_num_procs; ++rank) {
+        max_panel_rows = std::max(max_panel_rows,
+                                  panel_offsets[rank+1] - panel_offsets[rank]);
+    }
+    std::vector<double> panel(max_panel_rows*num_cols);
+
+    for (int rank = 0; rank < d_num_procs; ++rank) {
+        const int panel_rows = panel_offsets[rank+1] - panel_offsets[rank];
+        if (panel_rows == 0) continue;
+
+        const double* panel_data;
+        if (rank == d_rank) {
+            panel_data = other.d_mat;
+        }
+        else {
+            panel_data = panel.data();
+        }
+        CAROM_VERIFY(MPI_Bcast(const_cast<double*>(panel_data),
+                               panel_rows*num_cols,
+                               MPI_DOUBLE,
+                               rank,
+                               MPI_COMM_WORLD) == MPI_SUCCESS);
+
+        const int offset = panel_offsets[rank];
+        for (int this_row = 0; this_row < d_num_rows; ++this_row) {
+            double* result_row = &result.d_mat[this_row*num_cols];
+            for (int entry = 0; entry < panel_rows; ++entry) {
+                const double a = item(this_row, offset + entry);
+                const double* panel_row = &panel_data[entry*num_cols];
+                for (int other_col = 0; other_col < num_cols; ++other_col) {
+                    result_row[other_col] += a*panel_row[other_col];
+                }
+            }
+        }
+    }
+}
+
 void
 Matrix::mult(
     const Vector& other,
@@ -585,12 +766,7 @@ Matrix::transposeMult(
     }
     if (d_distributed && d_num_procs > 1) {
         int new_mat_size = d_num_cols*other.d_num_cols;
-        MPI_Allreduce(MPI_IN_PLACE,
-                      &result->item(0, 0),
-                      new_mat_size,
-                      MPI_DOUBLE,
-                      MPI_SUM,
-                      MPI_COMM_WORLD);
+        allreduce_sum(&result->item(0, 0), new_mat_size);
     }
 }
 
@@ -618,12 +794,83 @@ Matrix::transposeMult(
     }
     if (d_distributed && d_num_procs > 1) {
         int new_mat_size = d_num_cols*other.d_num_cols;
-        MPI_Allreduce(MPI_IN_PLACE,
-                      &result.item(0, 0),
-                      new_mat_size,
-                      MPI_DOUBLE,
-                      MPI_SUM,
-                      MPI_COMM_WORLD);
+        allreduce_sum(&result.item(0, 0), new_mat_size);
+    }
+}
+
+Matrix*
+Matrix::transposeMultDistributed(
+    const Matrix& other) const
+{
+    Matrix* result = new Matrix(split_dimension(d_num_cols, MPI_COMM_WORLD),
+                                other.d_num_cols, true);
+    transposeMultDistributed(other, *result);
+    return result;
+}
+
+void
+Matrix::transposeMultDistributed(
+    const Matrix& other,
+    Matrix& result) const
+{
+    CAROM_VERIFY(result.distributed());
+    CAROM_VERIFY(distributed() == other.distributed());
+    CAROM_VERIFY(numRows() == other.numRows());
+
+    // The rows of the product are split evenly over all processes.
+    const int num_cols = other.d_num_cols;
+    const int num_local_rows = split_dimension(d_num_cols, MPI_COMM_WORLD);
+    std::vector<int> row_offsets;
+    get_global_offsets(num_local_rows, row_offsets, MPI_COMM_WORLD);
+    result.setSize(num_local_rows, num_cols);
+
+    if (!d_distributed) {
+        // Every process already holds all of the data, so just compute the
+        // local block of rows.
+        const int offset = row_offsets[d_rank];
+        for (int this_col = 0; this_col < num_local_rows; ++this_col) {
+            for (int other_col = 0; other_col < num_cols; ++other_col) {
+                double result_val = 0.0;
+                for (int entry = 0; entry < d_num_rows; ++entry) {
+                    result_val += item(entry, offset + this_col)*
+                                  other.item(entry, other_col);
+                }
+                result.item(this_col, other_col) = result_val;
+            }
+        }
+        return;
+    }
+
+    // Form the local partial product one block of rows at a time and sum
+    // it onto the owner of the block, so only one block is stored besides
+    // the result.
+    int max_block_rows = 0;
+    for (int rank = 0; rank < d_num_procs; ++rank) {
+        max_block_rows = std::max(max_block_rows,
+                                  row_offsets[rank+1] - row_offsets[rank]);
+    }
+    std::vector<double> partial(max_block_rows*num_cols);
+    for (int rank = 0; rank < d_num_procs; ++rank) {
+        const int offset = row_offsets[rank];
+        const int block_rows = row_offsets[rank+1] - offset;
+        std::fill(partial.begin(), partial.begin() + block_rows*num_cols, 0.0);
+        for (int entry = 0; entry < d_num_rows; ++entry) {
+            const double* other_row = &other.d_mat[entry*num_cols];
+            for (int this_col = 0; this_col < block_rows; ++this_col) {
+                const double a = item(entry, offset + this_col);
+                double* partial_row = &partial[this_col*num_cols];
+                for (int other_col = 0; other_col < num_cols; ++other_col) {
+                    partial_row[other_col] += a*other_row[other_col];
+                }
+            }
+        }
+        CAROM_VERIFY(MPI_Reduce(partial.data(),
+                                rank == d_rank ? result.d_mat : NULL,
+                                block_rows*num_cols,
+                                MPI_DOUBLE,
+                                MPI_SUM,
+                                rank,
+                                MPI_COMM_WORLD) == MPI_SUCCESS);
     }
 }
 
@@ -654,12 +901,7 @@ Matrix::transposeMult(
         result->item(this_col) = result_val;
     }
     if (d_distributed && d_num_procs > 1) {
-        MPI_Allreduce(MPI_IN_PLACE,
-                      &result->item(0),
-                      d_num_cols,
-                      MPI_DOUBLE,
-                      MPI_SUM,
-                      MPI_COMM_WORLD);
+        allreduce_sum(&result->item(0), d_num_cols);
     }
 }
 
@@ -685,12 +927,7 @@ Matrix::transposeMult(
         result.item(this_col) = result_val;
     }
     if (d_distributed && d_num_procs > 1) {
-        MPI_Allreduce(MPI_IN_PLACE,
-                      &result.item(0),
-                      d_num_cols,
-                      MPI_DOUBLE,
-                      MPI_SUM,
-                      MPI_COMM_WORLD);
+        allreduce_sum(&result.item(0), d_num_cols);
     }
 }
 
@@ -1056,8 +1293,7 @@ Matrix::distribute(const int &local_num_rows)
     const int new_size = local_num_rows * d_num_cols;
 
     double *d_new_mat = new double [new_size];
-    if (new_size > 0)
-        memcpy(d_new_mat, &d_mat[local_offset], 8 * new_size);
+    first_touch_copy(d_new_mat, &d_mat[local_offset], new_size);
 
     delete [] d_mat;
     d_mat = d_new_mat;
@@ -1079,6 +1315,8 @@ Matrix::gather()
     const int num_total_rows = get_global_offsets(d_num_rows, row_offsets,
                                MPI_COMM_WORLD);
     CAROM_VERIFY(num_total_rows == d_num_distributed_rows);
+    // The gathered matrix is stored, and communicated, with int sizes.
+    CAROM_VERIFY(d_num_distributed_rows * d_num_cols <= INT_MAX);
     const int new_size = d_num_distributed_rows * d_num_cols;
 
     int *data_offsets = new int[row_offsets.size() - 1];
@@ -1107,11 +1345,11 @@ Matrix::gather()
 void
 Matrix::calculateNumDistributedRows() {
     if (d_distributed && d_num_procs > 1) {
-        int num_total_rows = d_num_rows;
+        GlobalIndex num_total_rows = d_num_rows;
         CAROM_VERIFY(MPI_Allreduce(MPI_IN_PLACE,
                                    &num_total_rows,
                                    1,
-                                   MPI_INT,
+                                   CAROM_MPI_GLOBAL_INDEX,
                                    MPI_SUM,
                                    MPI_COMM_WORLD) == MPI_SUCCESS);
         d_num_distributed_rows = num_total_rows;
@@ -1127,6 +1365,8 @@ Matrix::qr_factorize() const
     int myid;
     MPI_Comm_rank(MPI_COMM_WORLD, &myid);
 
+    // ScaLAPACK indexes the rows with int.
+    CAROM_VERIFY(numDistributedRows() <= INT_MAX);
     std::vector<int> row_offset(d_num_procs + 1);
     row_offset[d_num_procs] = numDistributedRows();
     row_offset[myid] = numRows();
@@ -1197,18 +1437,59 @@ Matrix::qr_factorize() const
 void
 Matrix::qrcp_pivots_transpose(int* row_pivot,
                               int* row_pivot_owner,
-                              int  pivots_requested) const
+                              int  pivots_requested,
+                              QRCP_pivoting pivoting) const
 {
     if(!distributed()) {
         return qrcp_pivots_transpose_serial(row_pivot,
                                             row_pivot_owner,
                                             pivots_requested);
     }
-    else {
+    else if (pivoting == QRCP_pivoting::FULL) {
         return qrcp_pivots_transpose_distributed(row_pivot,
                 row_pivot_owner,
                 pivots_requested);
     }
+    else {
+        // Compute global pivots and narrow them on rank 0, where they are
+        // returned.
+        std::vector<GlobalIndex> global_pivot(pivots_requested);
+        qrcp_pivots_transpose(global_pivot.data(), row_pivot_owner,
+                              pivots_requested, pivoting);
+        if (d_rank == 0) {
+            for (int i = 0; i < pivots_requested; i++) {
+                CAROM_VERIFY(global_pivot[i] <= INT_MAX);
+                row_pivot[i] = static_cast<int>(global_pivot[i]);
+            }
+        }
+    }
+}
+
+void
+Matrix::qrcp_pivots_transpose(GlobalIndex* row_pivot,
+                              int* row_pivot_owner,
+                              int  pivots_requested,
+                              QRCP_pivoting pivoting) const
+{
+    if (distributed() && pivoting == QRCP_pivoting::TRUNCATED) {
+        return qrcp_pivots_transpose_distributed_truncated(row_pivot,
+                row_pivot_owner,
+                pivots_requested);
+    }
+    else if (distributed() && pivoting == QRCP_pivoting::TOURNAMENT) {
+        return qrcp_pivots_transpose_distributed_tournament(row_pivot,
+                row_pivot_owner,
+                pivots_requested);
+    }
+    else {
+        // LAPACK and ScaLAPACK compute int pivots, which are widened.
+        std::vector<int> pivot(pivots_requested);
+        qrcp_pivots_transpose(pivot.data(), row_pivot_owner, pivots_requested,
+                              pivoting);
+        if (!distributed() || d_rank == 0) {
+            std::copy(pivot.begin(), pivot.end(), row_pivot);
+        }
+    }
 }
 
 void
@@ -1325,6 +1606,8 @@ Matrix::qrcp_pivots_transpose_distributed_scalapack
     // Check if distributed; otherwise, use serial implementation
     CAROM_VERIFY(distributed());
 
+    // ScaLAPACK indexes the rows with int.
+    CAROM_VERIFY(numDistributedRows() <= INT_MAX);
     int num_total_rows = d_num_rows;
     CAROM_VERIFY(MPI_Allreduce(MPI_IN_PLACE,
                                &num_total_rows,
@@ -1443,6 +1726,187 @@ Matrix::qrcp_pivots_transpose_distributed_scalapack
     delete [] row_offset;
 }
 
+void
+Matrix::qrcp_pivots_transpose_distributed_truncated
+(GlobalIndex* row_pivot, int* row_pivot_owner, int pivots_requested) const
+{
+    CAROM_VERIFY(distributed());
+    CAROM_VERIFY(pivots_requested > 0);
+
+    int my_rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+
+    std::vector<GlobalIndex> row_offset;
+    const GlobalIndex num_total_rows = get_global_offsets(d_num_rows,
+                                       row_offset, MPI_COMM_WORLD);
+    CAROM_VERIFY(pivots_requested <= num_total_rows);
+    if (my_rank == 0) {
+        CAROM_VERIFY(row_pivot != NULL);
+        CAROM_VERIFY(row_pivot_owner != NULL);
+    }
+
+    std::vector<double> residual(d_mat,
+                                 d_mat + static_cast<size_t>(d_num_rows) * d_num_cols);
+    std::vector<double> norm2(d_num_rows);
+    for (int i = 0; i < d_num_rows; ++i) {
+        double s = 0.0;
+        for (int j = 0; j < d_num_cols; ++j) {
+            s += item(i, j) * item(i, j);
+        }
+        norm2[i] = s;
+    }
+
+    // The pivot row followed by its local index on the owner, which is exact
+    // in a double.
+    std::vector<double> pivot_row(d_num_cols + 1);
+    std::vector<double> q(d_num_cols);
+
+    // Layout of MPI_DOUBLE_INT. The largest norm is located by rank, so that
+    // global row indices need not fit in an int.
+    struct {
+        double norm2;
+        int rank;
+    } local, global;
+
+    for (int p = 0; p < pivots_requested; ++p) {
+        // Ties go to the lowest rank and then to the lowest local row, i.e.
+        // to the lowest global row, as in LAPACK.
+        int local_pivot = -1;
+        local.norm2 = -1.0;
+        local.rank = my_rank;
+        for (int i = 0; i < d_num_rows; ++i) {
+            if (norm2[i] > local.norm2) {
+                local.norm2 = norm2[i];
+                local_pivot = i;
+            }
+        }
+        CAROM_VERIFY(MPI_Allreduce(&local, &global, 1, MPI_DOUBLE_INT,
+                                   MPI_MAXLOC, MPI_COMM_WORLD) == MPI_SUCCESS);
+
+        const int owner = global.rank;
+        if (my_rank == owner) {
+            std::copy(residual.begin() + local_pivot * d_num_cols,
+                      residual.begin() + (local_pivot + 1) * d_num_cols,
+                      pivot_row.begin());
+            pivot_row[d_num_cols] = local_pivot;
+        }
+        CAROM_VERIFY(MPI_Bcast(pivot_row.data(), d_num_cols + 1, MPI_DOUBLE,
+                               owner, MPI_COMM_WORLD) == MPI_SUCCESS);
+
+        project_out_pivot(residual.data(), norm2.data(), d_num_rows, d_num_cols,
+                          pivot_row.data(), global.norm2, q.data());
+        if (my_rank == owner) {
+            norm2[local_pivot] = -1.0;
+        }
+
+        if (my_rank == 0) {
+            row_pivot[p] = row_offset[owner] +
+                           static_cast<GlobalIndex>(pivot_row[d_num_cols]);
+            row_pivot_owner[p] = owner;
+        }
+    }
+}
+
+void
+Matrix::qrcp_pivots_transpose_distributed_tournament
+(GlobalIndex* row_pivot, int* row_pivot_owner, int pivots_requested) const
+{
+    CAROM_VERIFY(distributed());
+    CAROM_VERIFY(pivots_requested > 0);
+
+    int my_rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+    const GlobalIndex num_local_rows = d_num_rows;
+    GlobalIndex first_row = 0;
+    CAROM_VERIFY(MPI_Exscan(&num_local_rows, &first_row, 1,
+                            CAROM_MPI_GLOBAL_INDEX, MPI_SUM,
+                            MPI_COMM_WORLD) == MPI_SUCCESS);
+    if (my_rank == 0) {
+        first_row = 0;
+    }
+
+    // The candidates of this process: global row, owner and row entries.
+    std::vector<GlobalIndex> candidate_row;
+    std::vector<int> candidate_owner;
+    std::vector<double> candidate_data;
+    std::vector<int> pivots;
+    local_row_pivots(d_mat, d_num_rows, d_num_cols, pivots_requested, pivots);
+    for (int i = 0; i < static_cast<int>(pivots.size()); ++i) {
+        candidate_row.push_back(first_row + pivots[i]);
+        candidate_owner.push_back(my_rank);
+        candidate_data.insert(candidate_data.end(),
+                              d_mat + pivots[i] * d_num_cols,
+                              d_mat + (pivots[i] + 1) * d_num_cols);
+    }
+
+    // At each level of the binary tree, the odd process of each pair sends
+    // its candidates to the even one, which keeps the leading pivots of a
+    // QRCP of the union of both sets.
+    for (int step = 1; step < d_num_procs; step *= 2) {
+        if (my_rank % (2 * step) != 0) {
+            const int dest = my_rank - step;
+            int num_candidates = candidate_row.size();
+            MPI_Send(&num_candidates, 1, MPI_INT, dest, 0, MPI_COMM_WORLD);
+            MPI_Send(candidate_row.data(), num_candidates,
+                     CAROM_MPI_GLOBAL_INDEX, dest, 1, MPI_COMM_WORLD);
+            MPI_Send(candidate_owner.data(), num_candidates, MPI_INT, dest, 2,
+                     MPI_COMM_WORLD);
+            MPI_Send(candidate_data.data(), num_candidates * d_num_cols,
+                     MPI_DOUBLE, dest, 3, MPI_COMM_WORLD);
+            break;
+        }
+
+        const int source = my_rank + step;
+        if (source >= d_num_procs) {
+            continue;
+        }
+        int num_received;
+        MPI_Recv(&num_received, 1, MPI_INT, source, 0, MPI_COMM_WORLD,
+                 MPI_STATUS_IGNORE);
+        const int num_own = candidate_row.size();
+        const int num_candidates = num_own + num_received;
+        candidate_row.resize(num_candidates);
+        candidate_owner.resize(num_candidates);
+        candidate_data.resize(num_candidates * d_num_cols);
+        MPI_Recv(candidate_row.data() + num_own, num_received,
+                 CAROM_MPI_GLOBAL_INDEX, source, 1, MPI_COMM_WORLD,
+                 MPI_STATUS_IGNORE);
+        MPI_Recv(candidate_owner.data() + num_own, num_received, MPI_INT,
+                 source, 2, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        MPI_Recv(candidate_data.data() + num_own * d_num_cols,
+                 num_received * d_num_cols, MPI_DOUBLE, source, 3,
+                 MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+
+        local_row_pivots(candidate_data.data(), num_candidates, d_num_cols,
+                         pivots_requested, pivots);
+        std::vector<GlobalIndex> selected_row(pivots.size());
+        std::vector<int> selected_owner(pivots.size());
+        std::vector<double> selected_data(pivots.size() * d_num_cols);
+        for (int i = 0; i < static_cast<int>(pivots.size()); ++i) {
+            selected_row[i] = candidate_row[pivots[i]];
+            selected_owner[i] = candidate_owner[pivots[i]];
+            std::copy(candidate_data.begin() + pivots[i] * d_num_cols,
+                      candidate_data.begin() + (pivots[i] + 1) * d_num_cols,
+                      selected_data.begin() + i * d_num_cols);
+        }
+        candidate_row.swap(selected_row);
+        candidate_owner.swap(selected_owner);
+        candidate_data.swap(selected_data);
+    }
+
+    // Rank 0 holds the winners, ordered by the QRCP of the last merge.
+    if (my_rank == 0) {
+        CAROM_VERIFY(static_cast<int>(candidate_row.size()) ==
+                     pivots_requested);
+        CAROM_VERIFY(row_pivot != NULL);
+        CAROM_VERIFY(row_pivot_owner != NULL);
+        for (int i = 0; i < pivots_requested; ++i) {
+            row_pivot[i] = candidate_row[i];
+            row_pivot_owner[i] = candidate_owner[i];
+        }
+    }
+}
+
 void
 Matrix::qrcp_pivots_transpose_distributed_elemental
 (int* row_pivot, int* row_pivot_owner, int pivots_requested)
@@ -1849,6 +2313,89 @@ Matrix::orthogonalize(bool double_pass, double zero_tol)
     }
 }
 
+void
+Matrix::orthogonalize(const std::function<void(const Vector&, Vector&)>&
+                      apply_M,
+                      bool double_pass,
+                      double zero_tol)
+{
+    int const num_passes = double_pass ? 2 : 1;
+
+    // M applied to each finished column, stored column by column.
+    std::vector<double> MQ(static_cast<size_t>(d_num_rows) * d_num_cols);
+    Vector v(d_num_rows, d_distributed);
+    Vector Mv(d_num_rows, d_distributed);
+
+    for (int work = 0; work < d_num_cols; ++work)
+    {
+        // Orthogonalize the column (twice if double_pass == true).
+        for (int k = 0; k < num_passes; k++)
+        {
+            for (int col = 0; col < work; ++col)
+            {
+                const double* Mq = MQ.data() +
+                                   static_cast<size_t>(col) * d_num_rows;
+                double factor = 0.0;
+
+                for (int i = 0; i < d_num_rows; ++i)
+                    factor += Mq[i] * item(i, work);
+
+                if (d_distributed && d_num_procs > 1)
+                {
+                    CAROM_VERIFY( MPI_Allreduce(MPI_IN_PLACE, &factor, 1,
+                                                MPI_DOUBLE, MPI_SUM,
+                                                MPI_COMM_WORLD)
+                                  == MPI_SUCCESS );
+                }
+                for (int i = 0; i < d_num_rows; ++i)
+                    item(i, work) -= factor * item(i, col);
+            }
+        }
+
+        // Normalize the column in the M inner product.
+        for (int i = 0; i < d_num_rows; ++i)
+            v(i) = item(i, work);
+        apply_M(v, Mv);
+        CAROM_VERIFY(Mv.dim() == d_num_rows);
+
+        double norm = 0.0;
+
+        for (int i = 0; i < d_num_rows; ++i)
+            norm += v(i) * Mv(i);
+
+        if (d_distributed && d_num_procs > 1)
+        {
+            CAROM_VERIFY( MPI_Allreduce(MPI_IN_PLACE, &norm, 1, MPI_DOUBLE,
+                                        MPI_SUM, MPI_COMM_WORLD)
+                          == MPI_SUCCESS );
+        }
+
+        double scale = 1.0;
+        if (norm > zero_tol)
+        {
+            scale = 1.0 / sqrt(norm);
+            for (int i = 0; i < d_num_rows; ++i)
+                item(i, work) *= scale;
+        }
+
+        double* Mq = MQ.data() + static_cast<size_t>(work) * d_num_rows;
+        for (int i = 0; i < d_num_rows; ++i)
+            Mq[i] = scale * Mv(i);
+    }
+}
+
+void
+Matrix::orthogonalize(const Vector& weight, bool double_pass, double zero_tol)
+{
+    CAROM_VERIFY(weight.dim() == d_num_rows);
+
+    orthogonalize([&weight](const Vector & v, Vector & Mv)
+    {
+        for (int i = 0; i < v.dim(); ++i)
+            Mv(i) = weight(i) * v(i);
+    }, double_pass, zero_tol);
+}
+
 void
 Matrix::orthogonalize_last(int ncols, bool double_pass, double zero_tol)
 {
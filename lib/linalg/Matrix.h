@@ -16,12 +16,28 @@
 #define included_Matrix_h
 
 #include "Vector.h"
+#include "utils/mpi_utils.h"
 #include <vector>
 #include <complex>
 #include <string>
+#include <functional>
 
 namespace CAROM {
 
+/**
+ * @brief Pivoting used by Matrix::qrcp_pivots_transpose on a distributed
+ *        Matrix:
+ *        FULL: complete QRCP of the transpose with ScaLAPACK (or Elemental)
+ *        TRUNCATED: QRCP of the transpose stopped after the requested pivots
+ *        TOURNAMENT: communication-avoiding tournament pivoting, merging
+ *                    locally selected candidate rows up a reduction tree
+ */
+enum class QRCP_pivoting {
+    FULL,
+    TRUNCATED,
+    TOURNAMENT
+};
+
 /**
  * Class Matrix is a simple matrix class in which the rows may be distributed
  * across multiple processes. This class supports only the basic operations that
@@ -35,13 +51,13 @@ public:
 
     /** Constructor creating a Matrix with uninitialized values.
      *
-     * @pre num_rows > 0
+     * @pre num_rows > 0, or num_rows >= 0 if distributed
      * @pre num_cols > 0
      *
      * @param[in] num_rows When undistributed, the total number of rows of
      *                     the Matrix.  When distributed, the part of the
      *                     total number of rows of the Matrix on this
-     *                     processor.
+     *                     processor, which may be zero.
      * @param[in] num_cols The total number of columns of the Matrix.
      * @param[in] distributed If true the rows of the Matrix are spread over
      *                        all processors.
@@ -157,8 +173,9 @@ public:
                 delete [] d_mat;
             }
 
-            // Allocate new array and initialize all values to zero.
-            d_mat = new double [new_size] {0.0};
+            // Allocate new array and initialize all values to zero, in
+            // parallel for large arrays.
+            d_mat = first_touch_allocate(new_size);
             d_alloc_size = new_size;
         }
         d_num_rows = num_rows;
@@ -201,7 +218,7 @@ public:
      *
      * @return The number of rows of the Matrix across all processors.
      */
-    int
+    GlobalIndex
     numDistributedRows() const
     {
         if (!d_distributed) {
@@ -269,11 +286,12 @@ public:
      * reference version.
      *
      * Supports multiplication of two undistributed matrices returning an
-     * undistributed Matrix, and multiplication of a distributed Matrix with
-     * an undistributed Matrix returning a distributed Matrix.
+     * undistributed Matrix, multiplication of a distributed Matrix with
+     * an undistributed Matrix returning a distributed Matrix, and
+     * multiplication of a distributed or undistributed Matrix with a
+     * distributed Matrix returning a Matrix distributed like this.
      *
-     * @pre !other.distributed()
-     * @pre numColumns() == other.numRows()
+     * @pre numColumns() == other.numDistributedRows()
      *
      * @param[in] other The Matrix to multiply with this.
      *
@@ -293,12 +311,13 @@ public:
      * pointer version.
      *
      * Supports multiplication of two undistributed matrices returning an
-     * undistributed Matrix, and multiplication of a distributed Matrix with
-     * an undistributed Matrix returning a distributed Matrix.
+     * undistributed Matrix, multiplication of a distributed Matrix with
+     * an undistributed Matrix returning a distributed Matrix, and
+     * multiplication of a distributed or undistributed Matrix with a
+     * distributed Matrix returning a Matrix distributed like this.
      *
      * @pre other != 0
-     * @pre !other->distributed()
-     * @pre numColumns() == other->numRows()
+     * @pre numColumns() == other->numDistributedRows()
      *
      * @param[in] other The Matrix to multiply with this.
      *
@@ -322,9 +341,13 @@ public:
      * has not been allocated it will be, otherwise it will be sized
      * accordingly.
      *
+     * If other is distributed, its row panels are broadcast one process at
+     * a time and accumulated into the local rows of result (a 1D SUMMA), so
+     * other is never gathered in full on any process.  If this is
+     * undistributed, the partial products are summed over all processes.
+     *
      * @pre result == 0 || result->distributed() == distributed()
-     * @pre !other.distributed()
-     * @pre numColumns() == other.numRows()
+     * @pre numColumns() == other.numDistributedRows()
      *
      * @param[in] other The Matrix to multiply with this.
      * @param[out] result The product Matrix.
@@ -343,9 +366,13 @@ public:
      * an undistributed Matrix resulting in a distributed Matrix.  Result
      * will be sized accordingly.
      *
+     * If other is distributed, its row panels are broadcast one process at
+     * a time and accumulated into the local rows of result (a 1D SUMMA), so
+     * other is never gathered in full on any process.  If this is
+     * undistributed, the partial products are summed over all processes.
+     *
      * @pre result.distributed() == distributed()
-     * @pre !other.distributed()
-     * @pre numColumns() == other.numRows()
+     * @pre numColumns() == other.numDistributedRows()
      *
      * @param[in] other The Matrix to multiply with this.
      * @param[out] result The product Matrix.
@@ -712,6 +739,44 @@ public:
         const Matrix& other,
         Matrix& result) const;
 
+    /**
+     * @brief Multiplies the transpose of this Matrix with other and returns
+     * the product with its rows distributed over all processes.
+     *
+     * Unlike transposeMult, the partial products of each block of rows are
+     * reduced onto the process that owns the block, one block at a time, so
+     * each process stores only its own block of rows of the result and one
+     * block of partial products instead of a full copy.  The rows are split
+     * as by split_dimension(numColumns()).
+     *
+     * @pre distributed() == other.distributed()
+     * @pre numRows() == other.numRows()
+     *
+     * @param[in] other The Matrix to multiply with this.
+     *
+     * @return The distributed product Matrix.
+     */
+    Matrix*
+    transposeMultDistributed(
+        const Matrix& other) const;
+
+    /**
+     * @brief Multiplies the transpose of this Matrix with other and fills
+     * result with the product, with its rows distributed over all
+     * processes.  Result will be sized accordingly.
+     *
+     * @pre result.distributed()
+     * @pre distributed() == other.distributed()
+     * @pre numRows() == other.numRows()
+     *
+     * @param[in] other The Matrix to multiply with this.
+     * @param[out] result The distributed product Matrix.
+     */
+    void
+    transposeMultDistributed(
+        const Matrix& other,
+        Matrix& result) const;
+
     /**
      * @brief Multiplies the transpose of this Matrix with other and returns
      * the product, reference version.
@@ -925,7 +990,11 @@ public:
      * QR decomposition with column pivots (QRCP) of the transpose
      * of this.
      *
-     * @pre !distributed()
+     * If this Matrix is distributed, the pivots are global row indices and
+     * are returned on rank 0 only. TRUNCATED selects the same pivots as FULL,
+     * in exact arithmetic, with one reduction and one broadcast per pivot.
+     * TOURNAMENT selects a different, still rank-revealing, set of rows with
+     * O(log P) messages. A serial Matrix always uses LAPACK.
      *
      * @param[out] row_pivot Array of leading column pivots
      * from QRCP of transpose of this Matrix, has length pivots_requested
@@ -934,11 +1003,31 @@ public:
      * @param[in] pivots_requested The number of pivots requested, must be less
      *                             than or equal to the number of rows of this
      *                             Matrix.
+     * @param[in] pivoting The pivoting used if this Matrix is distributed.
      */
     void
     qrcp_pivots_transpose(int* row_pivot,
                           int* row_pivot_owner,
-                          int  pivots_requested) const;
+                          int  pivots_requested,
+                          QRCP_pivoting pivoting = QRCP_pivoting::TRUNCATED) const;
+
+    /**
+     * @brief As above, returning the pivots of a distributed Matrix as
+     * GlobalIndex, for matrices with more than INT_MAX distributed rows.
+     * FULL is limited to int global indices by ScaLAPACK.
+     *
+     * @param[out] row_pivot Array of leading column pivots
+     * from QRCP of transpose of this Matrix, has length pivots_requested
+     * @param[out] row_pivot_owner Array of process rank that owns
+     * each pivot on the communicator owned by this Matrix.
+     * @param[in] pivots_requested The number of pivots requested.
+     * @param[in] pivoting The pivoting used if this Matrix is distributed.
+     */
+    void
+    qrcp_pivots_transpose(GlobalIndex* row_pivot,
+                          int* row_pivot_owner,
+                          int  pivots_requested,
+                          QRCP_pivoting pivoting = QRCP_pivoting::TRUNCATED) const;
 
     /**
      * @brief Orthonormalizes the matrix.
@@ -957,6 +1046,42 @@ public:
     void
     orthogonalize(bool double_pass = false, double zero_tol = 1.0e-15);
 
+    /**
+     * @brief Orthonormalizes the matrix in the inner product weighted by a
+     *        symmetric positive definite operator M, so that Q^T M Q = I.
+     *
+     * The method uses the modified Gram-Schmidt algorithm, keeping M applied
+     * to each finished column so that M is applied once per column. The
+     * options double_pass and zero_tol have the same meaning as in the
+     * unweighted orthogonalize, with norms measured in the M inner product.
+     *
+     * @param[in] apply_M Callback computing Mv = M v. Both Vectors have
+     *                    numRows() entries on this processor and are
+     *                    distributed if this Matrix is distributed.
+     * @param[in] double_pass If true, orthogonalize each column twice.
+     * @param[in] zero_tol Tolerance below which a column is treated as zero.
+     */
+    void
+    orthogonalize(const std::function<void(const Vector& v, Vector& Mv)>&
+                  apply_M,
+                  bool double_pass = false,
+                  double zero_tol = 1.0e-15);
+
+    /**
+     * @brief Orthonormalizes the matrix in the inner product weighted by the
+     *        diagonal operator diag(weight), e.g. a lumped mass matrix.
+     *
+     * @pre weight.dim() == numRows()
+     *
+     * @param[in] weight The positive local diagonal entries of M.
+     * @param[in] double_pass If true, orthogonalize each column twice.
+     * @param[in] zero_tol Tolerance below which a column is treated as zero.
+     */
+    void
+    orthogonalize(const Vector& weight,
+                  bool double_pass = false,
+                  double zero_tol = 1.0e-15);
+
     /**
      * @brief Orthonormalizes the matrix's last column, assuming the previous
      * columns are already orthonormal.
@@ -1139,6 +1264,29 @@ private:
     void
     calculateNumDistributedRows();
 
+    /**
+     * @brief Multiplies this Matrix with the distributed Matrix other and
+     * stores the product in result, which must already be sized.
+     *
+     * Each process in turn broadcasts its row panel of other, and every
+     * process accumulates the product of the matching column block of this
+     * with that panel.  Only one panel of other is held at a time.  If this
+     * is undistributed, each process instead multiplies its own panel and
+     * the partial products are summed over all processes.
+     *
+     * @pre other.distributed()
+     * @pre numColumns() == other.numDistributedRows()
+     * @pre result.numRows() == numRows()
+     * @pre result.numColumns() == other.numColumns()
+     *
+     * @param[in] other The distributed Matrix to multiply with this.
+     * @param[out] result The product Matrix.
+     */
+    void
+    mult_distributed_other(
+        const Matrix& other,
+        Matrix& result) const;
+
     /**
      * @brief Compute the leading numColumns() column pivots from a
      * QR decomposition with column pivots (QRCP) of the transpose
@@ -1182,6 +1330,47 @@ private:
             int* row_pivot_owner,
             int  pivots_requested) const;
 
+    /**
+     * @brief Compute the leading column pivots from a QRCP of the
+     * transpose of this Matrix, stopping after pivots_requested pivots.
+     * Each pivot is the row with the largest norm after projecting out the
+     * previous pivots; its owner broadcasts it so that all processes can
+     * update their rows.
+     *
+     * @pre distributed()
+     *
+     * @param[out] row_pivot Array of global row indices of the pivots, set on
+     * rank 0 only.
+     * @param[out] row_pivot_owner Array of process rank that owns
+     * each pivot, set on rank 0 only.
+     * @param[in] pivots_requested The number of pivots requested, must be
+     * less than or equal to the number of distributed rows of this Matrix.
+     */
+    void
+    qrcp_pivots_transpose_distributed_truncated(GlobalIndex* row_pivot,
+            int* row_pivot_owner,
+            int  pivots_requested) const;
+
+    /**
+     * @brief Compute pivots_requested rows of this Matrix by tournament
+     * pivoting. Each process selects candidate rows by a local QRCP, and
+     * pairs of candidate sets are merged up a binary reduction tree by a
+     * QRCP of their union, until rank 0 holds the pivots.
+     *
+     * @pre distributed()
+     *
+     * @param[out] row_pivot Array of global row indices of the pivots, set on
+     * rank 0 only.
+     * @param[out] row_pivot_owner Array of process rank that owns
+     * each pivot, set on rank 0 only.
+     * @param[in] pivots_requested The number of pivots requested, must be
+     * less than or equal to the number of distributed rows of this Matrix.
+     */
+    void
+    qrcp_pivots_transpose_distributed_tournament(GlobalIndex* row_pivot,
+            int* row_pivot_owner,
+            int  pivots_requested) const;
+
     /**
      * @brief Compute the leading column pivots from a QR
      * decomposition with column pivots (QRCP) of the transpose of
@@ -1253,7 +1442,7 @@ private:
     /**
      * @brief The rows in the Matrix across all processors.
      */
-    int d_num_distributed_rows;
+    GlobalIndex d_num_distributed_rows;
 
     /**
      * @brief The number of columns in the Matrix.
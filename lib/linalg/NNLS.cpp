@@ -11,7 +11,13 @@
 #include "mpi.h"
 #include "NNLS.h"
 #include "scalapack_wrapper.h"
+#include "utils/AllreducePlan.h"
+#include "utils/SyntheticSnapshots.h"
 
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <random>
 #include <set>
 
 using namespace std;
@@ -66,7 +72,9 @@ NNLSSolver::NNLSSolver(double const_tol, int min_nnz, int max_nnz,
       zero_tol_(zero_tol), n_outer_(n_outer), n_inner_(n_inner),
       NNLS_qrres_on_(false),
       qr_residual_mode_(QRresidualMode::hybrid),
-      d_criterion(criterion)
+      d_criterion(criterion),
+      d_sketch(NNLS_sketch::NONE), d_sketch_rows(0), d_sketch_max_passes(0),
+      d_sketch_seed(0), d_num_solved_constraints(0)
 {
     CAROM_VERIFY((d_criterion == NNLS_termination::L2)
                  || (d_criterion == NNLS_termination::LINF));
@@ -92,6 +100,17 @@ void NNLSSolver::set_qrresidual_mode(const QRresidualMode qr_residual_mode)
     }
 }
 
+void NNLSSolver::set_sketch(const NNLS_sketch sketch, const int sketch_rows,
+                            const int max_passes, const unsigned int seed)
+{
+    CAROM_VERIFY(sketch == NNLS_sketch::NONE || sketch_rows > 0);
+    CAROM_VERIFY(max_passes >= 0);
+    d_sketch = sketch;
+    d_sketch_rows = sketch_rows;
+    d_sketch_max_passes = max_passes;
+    d_sketch_seed = seed;
+}
+
 void NNLSSolver::normalize_constraints(Matrix& matTrans, Vector& rhs_lb,
                                        Vector& rhs_ub)
 {
@@ -132,14 +151,28 @@ void NNLSSolver::solve_parallel_with_scalapack(const Matrix& matTrans,
 {
     CAROM_VERIFY(matTrans.distributed());
 
+    if (d_sketch != NNLS_sketch::NONE && d_sketch_rows < matTrans.numColumns())
+        solve_sketched(matTrans, rhs_lb, rhs_ub, soln);
+    else
+        solve_unsketched(matTrans, rhs_lb, rhs_ub, soln);
+}
+
+void NNLSSolver::solve_unsketched(const Matrix& matTrans,
+                                  const Vector& rhs_lb, const Vector& rhs_ub, Vector& soln)
+{
     int n = matTrans.numRows();
     int m = matTrans.numColumns();
     int n_tot = n;
     MPI_Allreduce(MPI_IN_PLACE, &n_tot, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
 
     CAROM_VERIFY(rhs_lb.dim() == m && rhs_lb.dim() == m && soln.dim() == n);
+    d_num_solved_constraints = m;
     if (max_nnz_ == 0)
-        max_nnz_ = matTrans.numDistributedRows();
+    {
+        const GlobalIndex num_rows = matTrans.numDistributedRows();
+        CAROM_VERIFY(num_rows <= INT_MAX);
+        max_nnz_ = static_cast<int>(num_rows);
+    }
 
     // prepare right hand side
     Vector rhs_avg(rhs_ub);
@@ -266,6 +299,10 @@ void NNLSSolver::solve_parallel_with_scalapack(const Matrix& matTrans,
     double rmax;
     bool tolerance_met;
 
+    // The maximum Lagrange multiplier is reduced at least once per outer
+    // iteration.
+    AllreducePlan mumax_plan(1, MPI_DOUBLE, MPI_MAX);
+
     for (unsigned int oiter = 0; oiter < n_outer_; ++oiter) {
         stalledFlag = 0;
 
@@ -354,8 +391,7 @@ void NNLSSolver::solve_parallel_with_scalapack(const Matrix& matTrans,
 
         mumax_glob = mumax;
 
-        MPI_Allreduce(MPI_IN_PLACE, &mumax_glob, 1, MPI_DOUBLE, MPI_MAX,
-                      MPI_COMM_WORLD);
+        mumax_plan.allreduce(&mumax_glob);
         if (mumax_glob < mu_tol) {
             num_stalled = stalled_indices.size();
             MPI_Allreduce(&num_stalled, &num_stalled_glob, 1, MPI_INT, MPI_SUM,
@@ -381,8 +417,7 @@ void NNLSSolver::solve_parallel_with_scalapack(const Matrix& matTrans,
                     mumax = std::max(mumax, mu(i));
 
                 mumax_glob = mumax;
-                MPI_Allreduce(MPI_IN_PLACE, &mumax_glob, 1, MPI_DOUBLE, MPI_MAX,
-                              MPI_COMM_WORLD);
+                mumax_plan.allreduce(&mumax_glob);
             }
         }
 
@@ -920,4 +955,264 @@ void NNLSSolver::solve_parallel_with_scalapack(const Matrix& matTrans,
     }
 }
 
+void NNLSSolver::solve_sketched(const Matrix& matTrans,
+                                const Vector& rhs_lb, const Vector& rhs_ub, Vector& soln)
+{
+    const int n = matTrans.numRows();
+    const int m = matTrans.numColumns();
+    const int k = d_sketch_rows;
+    CAROM_VERIFY(rhs_lb.dim() == m && rhs_ub.dim() == m && soln.dim() == n);
+
+    Vector rhs_avg(rhs_ub);
+    rhs_avg += rhs_lb;
+    rhs_avg *= 0.5;
+
+    Vector rhs_halfgap(rhs_ub);
+    rhs_halfgap -= rhs_lb;
+    rhs_halfgap *= 0.5;
+
+    // The sketch S is k x m. The generators are seeded identically on all
+    // processes, so S needs no communication.
+    Vector sketch_avg(k, false);
+    Vector sketch_halfgap(k, false);
+    sketch_avg = 0.0;
+    sketch_halfgap = 0.0;
+    Matrix sketchedTrans(n, k, true);
+    sketchedTrans = 0.0;
+    if (d_sketch == NNLS_sketch::GAUSSIAN)
+    {
+        // The Gaussian sketch is dense, so it is not stored. Entry (r, j) is
+        // counter_normal(seed, 0, j*k + r) / sqrt(k), and the columns are
+        // generated and applied a block of constraints at a time.
+        const int block_cols = 64;
+        const double scale = 1.0 / std::sqrt(k);
+        std::vector<double> block(static_cast<size_t>(block_cols) * k);
+        for (int j0 = 0; j0 < m; j0 += block_cols)
+        {
+            const int nb = std::min(block_cols, m - j0);
+            for (int jj = 0; jj < nb; ++jj)
+            {
+                const int j = j0 + jj;
+                double* col = block.data() + static_cast<size_t>(jj) * k;
+                for (int r = 0; r < k; ++r)
+                {
+                    col[r] = scale * counter_normal(d_sketch_seed, 0,
+                                                    static_cast<uint64_t>(j) * k + r);
+                    sketch_avg(r) += col[r] * rhs_avg(j);
+                    sketch_halfgap(r) += col[r] * col[r] * rhs_halfgap(j) *
+                                         rhs_halfgap(j);
+                }
+            }
+
+            // Sketch the local rows of the transposed constraint matrix.
+            for (int i = 0; i < n; ++i)
+            {
+                const double* a = matTrans.getData() + static_cast<size_t>(i) * m
+                                  + j0;
+                double* b = sketchedTrans.getData() + static_cast<size_t>(i) * k;
+                for (int jj = 0; jj < nb; ++jj)
+                {
+                    const double* col = block.data() + static_cast<size_t>(jj) * k;
+                    for (int r = 0; r < k; ++r)
+                    {
+                        b[r] += a[jj] * col[r];
+                    }
+                }
+            }
+        }
+    }
+    else
+    {
+        // The sparse sign sketch is stored by constraint: column j of S has
+        // nnz_per_col entries, in rows sketch_row and with values sketch_val.
+        const int nnz_per_col = std::min(k, 8);
+        std::vector<int> sketch_row(static_cast<size_t>(m) * nnz_per_col);
+        std::vector<double> sketch_val(sketch_row.size());
+        std::mt19937 generator(d_sketch_seed);
+        std::uniform_int_distribution<int> pick_row(0, k - 1);
+        const double val = 1.0 / std::sqrt(nnz_per_col);
+        for (int j = 0; j < m; ++j)
+        {
+            int* rows = sketch_row.data() + j*nnz_per_col;
+            for (int s = 0; s < nnz_per_col; ++s)
+            {
+                // Draw distinct rows for this constraint.
+                int r;
+                do {
+                    r = pick_row(generator);
+                } while (std::find(rows, rows + s, r) != rows + s);
+                rows[s] = r;
+                sketch_val[j*nnz_per_col + s] = (generator() & 1) ? val : -val;
+            }
+        }
+
+        // Sketch the bounds once.
+        for (int j = 0; j < m; ++j)
+        {
+            for (int s = 0; s < nnz_per_col; ++s)
+            {
+                const int r = sketch_row[j*nnz_per_col + s];
+                const double v = sketch_val[j*nnz_per_col + s];
+                sketch_avg(r) += v * rhs_avg(j);
+                sketch_halfgap(r) += v * v * rhs_halfgap(j) * rhs_halfgap(j);
+            }
+        }
+
+        // Sketch the local rows of the transposed constraint matrix once.
+        for (int i = 0; i < n; ++i)
+        {
+            const double* a = matTrans.getData() + static_cast<size_t>(i) * m;
+            double* b = sketchedTrans.getData() + static_cast<size_t>(i) * k;
+            for (int j = 0; j < m; ++j)
+            {
+                for (int s = 0; s < nnz_per_col; ++s)
+                {
+                    b[sketch_row[j*nnz_per_col + s]] += a[j] * sketch_val[j*nnz_per_col + s];
+                }
+            }
+        }
+    }
+    for (int r = 0; r < k; ++r)
+    {
+        sketch_halfgap(r) = std::sqrt(sketch_halfgap(r));
+    }
+
+    // Constraints appended unsketched after failing verification.
+    std::vector<int> appended;
+    std::vector<char> is_appended(m, 0);
+
+    Vector Ax(m, false);
+    for (int pass = 0; pass <= d_sketch_max_passes; ++pass)
+    {
+        const int m_s = k + appended.size();
+        Matrix sketchTrans(n, m_s, true);
+        for (int i = 0; i < n; ++i)
+        {
+            const double* a = matTrans.getData() + static_cast<size_t>(i) * m;
+            double* b = sketchTrans.getData() + static_cast<size_t>(i) * m_s;
+            std::copy(sketchedTrans.getData() + static_cast<size_t>(i) * k,
+                      sketchedTrans.getData() + static_cast<size_t>(i + 1) * k, b);
+            for (size_t r = 0; r < appended.size(); ++r)
+            {
+                b[k + r] = a[appended[r]];
+            }
+        }
+
+        Vector sketch_lb(m_s, false);
+        Vector sketch_ub(m_s, false);
+        for (int r = 0; r < m_s; ++r)
+        {
+            const double avg = (r < k) ? sketch_avg(r) : rhs_avg(appended[r - k]);
+            const double gap = (r < k) ? sketch_halfgap(r) :
+                               rhs_halfgap(appended[r - k]);
+            sketch_lb(r) = avg - gap;
+            sketch_ub(r) = avg + gap;
+        }
+
+        solve_unsketched(sketchTrans, sketch_lb, sketch_ub, soln);
+
+        // Verify on the full system. The residual is identical on all
+        // processes, hence so are the violated constraints.
+        matTrans.transposeMult(soln, Ax);
+        Ax -= rhs_avg;
+
+        bool satisfied = true;
+        if (d_criterion == NNLS_termination::LINF)
+        {
+            for (int j = 0; j < m; ++j)
+                satisfied = satisfied && (std::abs(Ax(j)) - rhs_halfgap(j) <= const_tol_);
+        }
+        else if (d_criterion == NNLS_termination::L2)
+        {
+            satisfied = (Ax.norm() <= rhs_halfgap.norm());
+        }
+
+        if (satisfied)
+        {
+            if (d_rank == 0 && verbosity_ > 0)
+            {
+                printf("Sketched NNLS verified with %d sketched and %d appended "
+                       "constraints\n", k, (int) appended.size());
+                fflush(stdout);
+            }
+            return;
+        }
+
+        // Append the constraints outside their bounds. Under the L2 criterion
+        // the norm may be exceeded with every constraint within its bounds,
+        // in which case the worst constraint is appended.
+        std::vector<int> violated;
+        int worst = -1;
+        for (int j = 0; j < m; ++j)
+        {
+            if (is_appended[j])
+                continue;
+
+            const double violation = std::abs(Ax(j)) - rhs_halfgap(j);
+            if (violation > const_tol_)
+                violated.push_back(j);
+            if (worst < 0 || violation > std::abs(Ax(worst)) - rhs_halfgap(worst))
+                worst = j;
+        }
+        if (violated.empty() && d_criterion == NNLS_termination::L2 && worst >= 0)
+            violated.push_back(worst);
+
+        if (violated.empty())
+        {
+            // Every violated constraint is already in the system, so the
+            // solver itself stopped short of its tolerance.
+            if (d_rank == 0 && verbosity_ > 0)
+            {
+                printf("Warning: sketched NNLS unverified with all violated "
+                       "constraints appended\n");
+                fflush(stdout);
+            }
+            return;
+        }
+
+        // Append at most k of the worst violations per pass, so that the
+        // system grows with the number of constraints that matter.
+        if (violated.size() > static_cast<size_t>(k))
+        {
+            std::vector<double> violation(m);
+            for (size_t i = 0; i < violated.size(); ++i)
+            {
+                const int j = violated[i];
+                violation[j] = std::abs(Ax(j)) - rhs_halfgap(j);
+            }
+            std::nth_element(violated.begin(), violated.begin() + k, violated.end(),
+                             [&violation](int a, int b) {
+                                 return violation[a] > violation[b];
+                             });
+            violated.resize(k);
+        }
+
+        if (d_rank == 0 && verbosity_ > 0)
+        {
+            printf("Sketched NNLS pass %d: appending %d of the violated constraints\n",
+                   pass, (int) violated.size());
+            fflush(stdout);
+        }
+
+        for (size_t i = 0; i < violated.size(); ++i)
+        {
+            appended.push_back(violated[i]);
+            is_appended[violated[i]] = 1;
+        }
+
+        if (k + static_cast<int>(appended.size()) >= m)
+        {
+            break;
+        }
+    }
+
+    // Fall back to the full system.
+    if (d_rank == 0 && verbosity_ > 0)
+    {
+        printf("Sketched NNLS unverified, solving the full system\n");
+        fflush(stdout);
+    }
+    solve_unsketched(matTrans, rhs_lb, rhs_ub, soln);
+}
+
 } // namespace CAROM
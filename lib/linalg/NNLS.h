@@ -29,6 +29,18 @@ enum class NNLS_termination {
     L2
 };
 
+/**
+ * @brief Row sketch applied to the constraints before the NNLS solve:
+ *        NONE: the full constraint system is solved
+ *        GAUSSIAN: dense sketch with Gaussian entries
+ *        SPARSE_SIGN: sparse sketch with a few random signs per constraint
+ */
+enum class NNLS_sketch {
+    NONE,
+    GAUSSIAN,
+    SPARSE_SIGN
+};
+
 /**
  * \class NNLSSolver
  * Class for solving non-negative least-squares problems, cf. T. Chapman et al,
@@ -74,6 +86,20 @@ public:
      */
     void set_qrresidual_mode(const QRresidualMode qr_residual_mode);
 
+    /**
+     * Solve a sketched system in solve_parallel_with_scalapack. The m
+     * constraints are compressed to sketch_rows random combinations, the
+     * half gap of each combination being the root sum of squares of the
+     * weighted original half gaps. The solution is then verified on the
+     * full system, and up to sketch_rows of the worst violated constraints
+     * are appended unsketched before solving again. If max_passes
+     * verifications fail, the full system is solved. The sketch is generated
+     * from seed identically on all processes. Has no effect if
+     * sketch_rows >= m.
+     */
+    void set_sketch(const NNLS_sketch sketch, const int sketch_rows,
+                    const int max_passes=10, const unsigned int seed=0);
+
     /**
      * Solve the NNLS problem. Specifically, we find a vector soln, such that
      * rhs_lb < mat*soln < rhs_ub is satisfied. The matrix should hold a column
@@ -111,7 +137,32 @@ public:
         return d_num_procs;
     };
 
+    /**
+     * Return the number of constraints of the system whose solution was
+     * returned by the last solve, which is less than the number of
+     * constraints of the full system if a sketched system was verified.
+     */
+    inline int getNumSolvedConstraints() const {
+        return d_num_solved_constraints;
+    };
+
 private:
+    /**
+     * Solve the given system with the active-set method, without sketching.
+     * This is solve_parallel_with_scalapack when no sketch is selected, and
+     * the solver of each sketched system and of the fallback to the full
+     * system.
+     */
+    void solve_unsketched(const Matrix& matTrans, const Vector& rhs_lb,
+                          const Vector& rhs_ub, Vector& soln);
+
+    /**
+     * Solve the sketched system selected by set_sketch, with verification
+     * passes on the full system.
+     */
+    void solve_sketched(const Matrix& matTrans, const Vector& rhs_lb,
+                        const Vector& rhs_ub, Vector& soln);
+
     unsigned int n_outer_;
     unsigned int n_inner_;
     double zero_tol_;
@@ -135,6 +186,13 @@ private:
     int d_rank;
 
     NNLS_termination d_criterion;
+
+    NNLS_sketch d_sketch;
+    int d_sketch_rows;
+    int d_sketch_max_passes;
+    unsigned int d_sketch_seed;
+
+    int d_num_solved_constraints;
 };
 
 }
@@ -0,0 +1,196 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2013-2024, Lawrence Livermore National Security, LLC
+ * and other libROM project developers. See the top-level COPYRIGHT
+ * file for details.
+ *
+ * SPDX-License-Identifier: (Apache-2.0 OR MIT)
+ *
+ *****************************************************************************/
+
+// Description: Scalar-templated copies of trained vectors and matrices for
+//              the online stage, e.g. in single precision.
+
+#include "OnlineLinearAlgebra.h"
+#include "Matrix.h"
+#include "Vector.h"
+#include "utils/Utilities.h"
+
+#include "mpi.h"
+
+#include <cmath>
+
+namespace CAROM {
+
+namespace {
+
+template <class Scalar>
+MPI_Datatype
+mpiType();
+
+template <>
+MPI_Datatype
+mpiType<float>()
+{
+    return MPI_FLOAT;
+}
+
+template <>
+MPI_Datatype
+mpiType<double>()
+{
+    return MPI_DOUBLE;
+}
+
+}
+
+template <class Scalar>
+OnlineVector<Scalar>::OnlineVector(
+    int dim,
+    bool distributed) :
+    d_vec(dim, Scalar(0)),
+    d_distributed(distributed)
+{
+    CAROM_VERIFY(dim >= 0);
+}
+
+template <class Scalar>
+OnlineVector<Scalar>::OnlineVector(
+    const Vector& other) :
+    d_vec(other.getData(), other.getData() + other.dim()),
+    d_distributed(other.distributed())
+{
+}
+
+template <class Scalar>
+double
+OnlineVector<Scalar>::inner_product(
+    const OnlineVector& other) const
+{
+    CAROM_VERIFY(dim() == other.dim());
+    CAROM_VERIFY(distributed() == other.distributed());
+
+    double ip = 0.0;
+    for (int i = 0; i < dim(); ++i)
+        ip += static_cast<double>(d_vec[i]) * other.d_vec[i];
+    if (d_distributed)
+    {
+        CAROM_VERIFY(MPI_Allreduce(MPI_IN_PLACE, &ip, 1, MPI_DOUBLE, MPI_SUM,
+                                   MPI_COMM_WORLD) == MPI_SUCCESS);
+    }
+    return ip;
+}
+
+template <class Scalar>
+double
+OnlineVector<Scalar>::norm() const
+{
+    return std::sqrt(inner_product(*this));
+}
+
+template <class Scalar>
+void
+OnlineVector<Scalar>::copyTo(
+    Vector& result) const
+{
+    CAROM_VERIFY(result.dim() == dim());
+
+    for (int i = 0; i < dim(); ++i)
+        result(i) = d_vec[i];
+}
+
+template <class Scalar>
+OnlineMatrix<Scalar>::OnlineMatrix() :
+    d_num_rows(0),
+    d_num_cols(0),
+    d_distributed(false)
+{
+}
+
+template <class Scalar>
+OnlineMatrix<Scalar>::OnlineMatrix(
+    const Matrix& other) :
+    d_mat(other.getData(),
+          other.getData() + static_cast<size_t>(other.numRows()) *
+          other.numColumns()),
+    d_num_rows(other.numRows()),
+    d_num_cols(other.numColumns()),
+    d_distributed(other.distributed())
+{
+}
+
+template <class Scalar>
+void
+OnlineMatrix<Scalar>::mult(
+    const OnlineVector<Scalar>& other,
+    OnlineVector<Scalar>& result) const
+{
+    CAROM_VERIFY(!other.distributed());
+    CAROM_VERIFY(d_num_cols == other.dim());
+
+    if (result.dim() != d_num_rows || result.distributed() != d_distributed)
+    {
+        result = OnlineVector<Scalar>(d_num_rows, d_distributed);
+    }
+    const Scalar* x = other.getData();
+    Scalar* y = result.getData();
+    for (int i = 0; i < d_num_rows; ++i)
+    {
+        const Scalar* row = &d_mat[static_cast<size_t>(i) * d_num_cols];
+        Scalar sum = 0;
+        for (int j = 0; j < d_num_cols; ++j)
+            sum += row[j] * x[j];
+        y[i] = sum;
+    }
+}
+
+template <class Scalar>
+void
+OnlineMatrix<Scalar>::transposeMult(
+    const OnlineVector<Scalar>& other,
+    OnlineVector<Scalar>& result) const
+{
+    CAROM_VERIFY(d_distributed == other.distributed());
+    CAROM_VERIFY(d_num_rows == other.dim());
+
+    if (result.dim() != d_num_cols || result.distributed())
+    {
+        result = OnlineVector<Scalar>(d_num_cols, false);
+    }
+    const Scalar* x = other.getData();
+    Scalar* y = result.getData();
+    for (int j = 0; j < d_num_cols; ++j)
+        y[j] = 0;
+    for (int i = 0; i < d_num_rows; ++i)
+    {
+        const Scalar* row = &d_mat[static_cast<size_t>(i) * d_num_cols];
+        const Scalar xi = x[i];
+        for (int j = 0; j < d_num_cols; ++j)
+            y[j] += row[j] * xi;
+    }
+    if (d_distributed)
+    {
+        CAROM_VERIFY(MPI_Allreduce(MPI_IN_PLACE, y, d_num_cols,
+                                   mpiType<Scalar>(), MPI_SUM,
+                                   MPI_COMM_WORLD) == MPI_SUCCESS);
+    }
+}
+
+template <class Scalar>
+void
+OnlineMatrix<Scalar>::copyTo(
+    Matrix& result) const
+{
+    CAROM_VERIFY(result.numRows() == d_num_rows);
+    CAROM_VERIFY(result.numColumns() == d_num_cols);
+
+    for (size_t n = 0; n < d_mat.size(); ++n)
+        result.getData()[n] = d_mat[n];
+}
+
+template class OnlineVector<float>;
+template class OnlineVector<double>;
+template class OnlineMatrix<float>;
+template class OnlineMatrix<double>;
+
+}
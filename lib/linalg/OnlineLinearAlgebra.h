@@ -0,0 +1,294 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2013-2024, Lawrence Livermore National Security, LLC
+ * and other libROM project developers. See the top-level COPYRIGHT
+ * file for details.
+ *
+ * SPDX-License-Identifier: (Apache-2.0 OR MIT)
+ *
+ *****************************************************************************/
+
+// Description: Scalar-templated copies of trained vectors and matrices for
+//              the online stage, e.g. in single precision.
+
+#ifndef included_OnlineLinearAlgebra_h
+#define included_OnlineLinearAlgebra_h
+
+#include <cstddef>
+#include <vector>
+
+namespace CAROM {
+
+class Matrix;
+class Vector;
+
+/**
+ * Class OnlineVector is a vector of Scalar entries, float or double,
+ * distributed like Vector. It is built from a trained double Vector and
+ * supports the few operations needed to evaluate a reduced model online.
+ */
+template <class Scalar>
+class OnlineVector
+{
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @pre dim >= 0
+     *
+     * @param[in] dim The local dimension of the vector.
+     * @param[in] distributed If true the vector is distributed.
+     */
+    OnlineVector(
+        int dim = 0,
+        bool distributed = false);
+
+    /**
+     * @brief Constructor converting a double vector to Scalar.
+     *
+     * @param[in] other The vector to convert.
+     */
+    explicit OnlineVector(
+        const Vector& other);
+
+    /**
+     * @brief Resizes the vector. The entries are not preserved.
+     */
+    void
+    setSize(
+        int dim)
+    {
+        d_vec.resize(dim);
+    }
+
+    /**
+     * @brief Returns the local dimension of the vector.
+     */
+    int
+    dim() const
+    {
+        return d_vec.size();
+    }
+
+    /**
+     * @brief Returns true if the vector is distributed.
+     */
+    bool
+    distributed() const
+    {
+        return d_distributed;
+    }
+
+    /**
+     * @brief Returns a reference to the local entry i.
+     */
+    Scalar&
+    operator() (
+        int i)
+    {
+        return d_vec[i];
+    }
+
+    /**
+     * @brief Returns a const reference to the local entry i.
+     */
+    const Scalar&
+    operator() (
+        int i) const
+    {
+        return d_vec[i];
+    }
+
+    /**
+     * @brief Returns the local entries.
+     */
+    Scalar*
+    getData()
+    {
+        return d_vec.data();
+    }
+
+    /**
+     * @brief Returns the local entries.
+     */
+    const Scalar*
+    getData() const
+    {
+        return d_vec.data();
+    }
+
+    /**
+     * @brief Returns the inner product with other, accumulated in double
+     *        and summed over all processors if the vectors are distributed.
+     *
+     * @pre dim() == other.dim()
+     * @pre distributed() == other.distributed()
+     */
+    double
+    inner_product(
+        const OnlineVector& other) const;
+
+    /**
+     * @brief Returns the 2-norm of the vector.
+     */
+    double
+    norm() const;
+
+    /**
+     * @brief Copies the vector into a double Vector.
+     *
+     * @pre result.dim() == dim()
+     */
+    void
+    copyTo(
+        Vector& result) const;
+
+private:
+    /**
+     * @brief The local entries.
+     */
+    std::vector<Scalar> d_vec;
+
+    /**
+     * @brief Whether the vector is distributed.
+     */
+    bool d_distributed;
+};
+
+/**
+ * Class OnlineMatrix is a row-major matrix of Scalar entries, float or
+ * double, whose rows are distributed like Matrix. It is built from a trained
+ * double Matrix, e.g. a reduced operator, a basis, or the inverse of the
+ * sampled rows of a hyperreduction basis. A distributed basis lifts reduced
+ * coordinates to the full space with mult and restricts full states to the
+ * reduced space with transposeMult.
+ */
+template <class Scalar>
+class OnlineMatrix
+{
+public:
+    /**
+     * @brief Constructor of an empty matrix.
+     */
+    OnlineMatrix();
+
+    /**
+     * @brief Constructor converting a double matrix to Scalar.
+     *
+     * @param[in] other The matrix to convert.
+     */
+    explicit OnlineMatrix(
+        const Matrix& other);
+
+    /**
+     * @brief Returns the number of local rows.
+     */
+    int
+    numRows() const
+    {
+        return d_num_rows;
+    }
+
+    /**
+     * @brief Returns the number of columns.
+     */
+    int
+    numColumns() const
+    {
+        return d_num_cols;
+    }
+
+    /**
+     * @brief Returns true if the rows are distributed.
+     */
+    bool
+    distributed() const
+    {
+        return d_distributed;
+    }
+
+    /**
+     * @brief Returns a const reference to the local entry (row, col).
+     */
+    const Scalar&
+    operator() (
+        int row,
+        int col) const
+    {
+        return d_mat[static_cast<size_t>(row) * d_num_cols + col];
+    }
+
+    /**
+     * @brief Returns the local entries in row-major order.
+     */
+    const Scalar*
+    getData() const
+    {
+        return d_mat.data();
+    }
+
+    /**
+     * @brief Computes result = this * other.
+     *
+     * @pre !other.distributed()
+     * @pre numColumns() == other.dim()
+     *
+     * @param[in] other The vector to multiply, e.g. reduced coordinates.
+     * @param[out] result The product, distributed like this matrix and
+     *                    resized if needed.
+     */
+    void
+    mult(
+        const OnlineVector<Scalar>& other,
+        OnlineVector<Scalar>& result) const;
+
+    /**
+     * @brief Computes result = this^T * other, summed over all processors
+     *        if this matrix is distributed.
+     *
+     * @pre distributed() == other.distributed()
+     * @pre numRows() == other.dim()
+     *
+     * @param[in] other The vector to multiply, e.g. a full state.
+     * @param[out] result The product, not distributed and resized if
+     *                    needed.
+     */
+    void
+    transposeMult(
+        const OnlineVector<Scalar>& other,
+        OnlineVector<Scalar>& result) const;
+
+    /**
+     * @brief Copies the matrix into a double Matrix.
+     *
+     * @pre result has the dimensions of this matrix
+     */
+    void
+    copyTo(
+        Matrix& result) const;
+
+private:
+    /**
+     * @brief The local entries in row-major order.
+     */
+    std::vector<Scalar> d_mat;
+
+    /**
+     * @brief The number of local rows.
+     */
+    int d_num_rows;
+
+    /**
+     * @brief The number of columns.
+     */
+    int d_num_cols;
+
+    /**
+     * @brief Whether the rows are distributed.
+     */
+    bool d_distributed;
+};
+
+}
+
+#endif
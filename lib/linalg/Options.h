@@ -15,6 +15,8 @@
 #define included_Options_h
 
 #include "utils/Utilities.h"
+#include <string>
+#include <vector>
 
 namespace CAROM {
 
@@ -120,6 +122,50 @@ public:
         return *this;
     }
 
+    /**
+     * @brief Sets the parameters of the adaptive-rank randomized SVD
+     *        algorithm, and turns on the randomized SVD if adaptive_ is true.
+     *
+     * The randomized subspace is grown in blocks of random directions until
+     * the estimated relative error ||A - Q Q^T A||_F / ||A||_F of the
+     * snapshot matrix A is at most the tolerance, so that the subspace
+     * dimension follows the numerical rank of the snapshots. To keep an
+     * energy fraction e of the snapshots, use the tolerance sqrt(1 - e). A
+     * positive randomized_subspace_dim set by setRandomizedSVD bounds the
+     * subspace dimension. The error is estimated to about 1e-7, so smaller
+     * tolerances behave as 1e-7.
+     *
+     * @param[in] adaptive_ Whether to grow the randomized subspace
+     *                      adaptively.
+     * @param[in] randomized_tol_ The relative error tolerance of the
+     *                            randomized subspace. If not positive, the
+     *                            subspace grows until the residual norm is
+     *                            at most singular_value_tol times the largest
+     *                            singular value captured, so that no
+     *                            singular value above the singular_value_tol
+     *                            cutoff is left out, and if singular_value_tol
+     *                            is zero until it spans the snapshots. The
+     *                            two tolerances differ: randomized_tol bounds
+     *                            ||A - Q Q^T A||_F / ||A||_F, while
+     *                            singular_value_tol is a cutoff on
+     *                            sigma_i / sigma_1.
+     * @param[in] randomized_block_size_ The number of random directions
+     *                                   added at a time.
+     */
+    Options setAdaptiveRandomizedSVD(
+        bool adaptive_,
+        double randomized_tol_ = -1.0,
+        int randomized_block_size_ = 10
+    )
+    {
+        CAROM_VERIFY(randomized_block_size_ > 0);
+        randomized_adaptive = adaptive_;
+        randomized_tol = randomized_tol_;
+        randomized_block_size = randomized_block_size_;
+        if (adaptive_) randomized = true;
+        return *this;
+    }
+
     /**
      * @brief Sets the essential parameters of the incremental SVD algorithm.
      *
@@ -209,6 +255,61 @@ public:
         return *this;
     }
 
+    /**
+     * @brief Sets a diagonal weight defining the inner product in which the
+     *        basis is orthonormal, e.g. a lumped finite element mass matrix.
+     *
+     * The snapshots are scaled by the square root of the weight as they are
+     * sampled, and the basis and snapshot matrix returned by BasisGenerator
+     * are scaled back, so the basis U satisfies U^T diag(weight) U = I.
+     *
+     * @pre inner_product_weight_.size() == dim
+     * @pre All entries of inner_product_weight_ are positive.
+     *
+     * @param[in] inner_product_weight_ The local diagonal entries of the
+     *                                  weight on this processor.
+     */
+    Options setInnerProductWeight(
+        const std::vector<double>& inner_product_weight_
+    )
+    {
+        inner_product_weight = inner_product_weight_;
+        return *this;
+    }
+
+    /**
+     * @brief Lets BasisGenerator choose the SVD backend from the problem
+     *        shape, see selectSVDBackend.
+     *
+     * The batch backends (StaticSVD or RandomizedSVD) are compared by a cost
+     * model of the global dimension, max_num_samples, max_basis_dimension
+     * and the number of processors. The incremental variant is chosen when
+     * BasisGenerator is incremental. The flags set by setRandomizedSVD and
+     * setIncrementalSVD are overridden, except for a positive randomized
+     * subspace dimension.
+     *
+     * @param[in] auto_svd_ Whether to choose the SVD backend automatically.
+     * @param[in] svd_calibration_file_ If not empty, a file caching the
+     *                                  measured cost of each backend on this
+     *                                  machine per number of processors. A
+     *                                  missing entry is measured on a small
+     *                                  problem and appended.
+     * @param[in] svd_oversampling_ The number of columns added to
+     *                              max_basis_dimension for the randomized
+     *                              subspace.
+     */
+    Options setAutoSVD(
+        bool auto_svd_,
+        const std::string& svd_calibration_file_ = "",
+        int svd_oversampling_ = 10
+    )
+    {
+        auto_svd = auto_svd_;
+        svd_calibration_file = svd_calibration_file_;
+        svd_oversampling = svd_oversampling_;
+        return *this;
+    }
+
     /**
      * @brief The dimension of the system on this processor.
      */
@@ -262,6 +363,24 @@ public:
      */
     int random_seed = 1;
 
+    /**
+     * @brief Whether the randomized subspace is grown adaptively.
+     */
+    bool randomized_adaptive = false;
+
+    /**
+     * @brief The relative error tolerance of the adaptive randomized
+     *        subspace, or a non-positive value to stop at the cutoff of
+     *        singular_value_tol.
+     */
+    double randomized_tol = -1.0;
+
+    /**
+     * @brief The number of random directions added at a time to the
+     *        adaptive randomized subspace.
+     */
+    int randomized_block_size = 10;
+
     // Incremental SVD
 
     /**
@@ -344,6 +463,29 @@ public:
      * @brief Option to preserve snapshot in StaticSVD::computeSVD.
      */
     bool static_svd_preserve_snapshot = false;
+
+    /**
+     * @brief The local diagonal entries of the inner product weight. If
+     *        empty, the Euclidean inner product is used.
+     */
+    std::vector<double> inner_product_weight;
+
+    /**
+     * @brief Whether BasisGenerator chooses the SVD backend automatically.
+     */
+    bool auto_svd = false;
+
+    /**
+     * @brief The file caching the measured cost of the SVD backends, or
+     *        empty to use the default cost model.
+     */
+    std::string svd_calibration_file;
+
+    /**
+     * @brief The oversampling of the randomized subspace chosen by the
+     *        automatic SVD backend selection.
+     */
+    int svd_oversampling = 10;
 };
 
 }
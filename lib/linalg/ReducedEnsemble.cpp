@@ -0,0 +1,291 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2013-2024, Lawrence Livermore National Security, LLC
+ * and other libROM project developers. See the top-level COPYRIGHT
+ * file for details.
+ *
+ * SPDX-License-Identifier: (Apache-2.0 OR MIT)
+ *
+ *****************************************************************************/
+
+// Description: A batch of small reduced linear systems stored as structure of
+//              arrays.
+
+#include "ReducedEnsemble.h"
+#include "Matrix.h"
+#include "Vector.h"
+#include "utils/Utilities.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace CAROM {
+
+ReducedEnsemble::ReducedEnsemble(
+    int dim,
+    int num_members) :
+    d_dim(dim),
+    d_num_members(num_members),
+    d_factored(false),
+    d_factored_alpha(0.0),
+    d_factored_beta(0.0)
+{
+    CAROM_VERIFY(dim > 0);
+    CAROM_VERIFY(num_members > 0);
+
+    const size_t batch = static_cast<size_t>(dim) * num_members;
+    d_operator.assign(batch * dim, 0.0);
+    d_lu.assign(batch * dim, 0.0);
+    d_forcing.assign(batch, 0.0);
+    d_state.assign(batch, 0.0);
+    d_work.assign(batch, 0.0);
+    d_pivots.assign(batch, 0);
+}
+
+void
+ReducedEnsemble::setOperator(
+    int member,
+    const Matrix& A)
+{
+    CAROM_VERIFY(0 <= member && member < d_num_members);
+    CAROM_VERIFY(!A.distributed());
+    CAROM_VERIFY(A.numRows() == d_dim && A.numColumns() == d_dim);
+
+    for (int i = 0; i < d_dim; ++i)
+        for (int j = 0; j < d_dim; ++j)
+            d_operator[(static_cast<size_t>(i) * d_dim + j) * d_num_members + member] =
+                A(i, j);
+    d_factored = false;
+}
+
+void
+ReducedEnsemble::setAffineOperator(
+    const std::vector<const Matrix*>& terms,
+    const Matrix& coefficients)
+{
+    const int num_terms = terms.size();
+    CAROM_VERIFY(coefficients.numRows() == d_num_members);
+    CAROM_VERIFY(coefficients.numColumns() == num_terms);
+
+    std::fill(d_operator.begin(), d_operator.end(), 0.0);
+    for (int q = 0; q < num_terms; ++q)
+    {
+        CAROM_VERIFY(!terms[q]->distributed());
+        CAROM_VERIFY(terms[q]->numRows() == d_dim &&
+                     terms[q]->numColumns() == d_dim);
+        for (int ij = 0; ij < d_dim * d_dim; ++ij)
+        {
+            const double a = terms[q]->getData()[ij];
+            double* op = &d_operator[static_cast<size_t>(ij) * d_num_members];
+            for (int b = 0; b < d_num_members; ++b)
+                op[b] += coefficients(b, q) * a;
+        }
+    }
+    d_factored = false;
+}
+
+void
+ReducedEnsemble::setForcing(
+    int member,
+    const Vector& f)
+{
+    CAROM_VERIFY(0 <= member && member < d_num_members);
+    CAROM_VERIFY(f.dim() == d_dim);
+
+    for (int i = 0; i < d_dim; ++i)
+        d_forcing[static_cast<size_t>(i) * d_num_members + member] = f(i);
+}
+
+void
+ReducedEnsemble::setState(
+    int member,
+    const Vector& x)
+{
+    CAROM_VERIFY(0 <= member && member < d_num_members);
+    CAROM_VERIFY(x.dim() == d_dim);
+
+    for (int i = 0; i < d_dim; ++i)
+        d_state[static_cast<size_t>(i) * d_num_members + member] = x(i);
+}
+
+void
+ReducedEnsemble::getState(
+    int member,
+    Vector& x) const
+{
+    CAROM_VERIFY(0 <= member && member < d_num_members);
+    CAROM_VERIFY(x.dim() == d_dim);
+
+    for (int i = 0; i < d_dim; ++i)
+        x(i) = d_state[static_cast<size_t>(i) * d_num_members + member];
+}
+
+void
+ReducedEnsemble::mult(
+    const double* x,
+    double* y) const
+{
+    CAROM_VERIFY(x != y);
+
+    const int B = d_num_members;
+    for (int i = 0; i < d_dim; ++i)
+    {
+        double* yi = y + static_cast<size_t>(i) * B;
+        for (int b = 0; b < B; ++b)
+            yi[b] = 0.0;
+        for (int j = 0; j < d_dim; ++j)
+        {
+            const double* aij = &d_operator[(static_cast<size_t>(i) * d_dim + j) * B];
+            const double* xj = x + static_cast<size_t>(j) * B;
+            for (int b = 0; b < B; ++b)
+                yi[b] += aij[b] * xj[b];
+        }
+    }
+}
+
+void
+ReducedEnsemble::factorShiftedOperator(
+    double alpha,
+    double beta)
+{
+    if (d_factored && alpha == d_factored_alpha && beta == d_factored_beta)
+    {
+        return;
+    }
+
+    const int k = d_dim;
+    const int B = d_num_members;
+    auto lu = [&](int i, int j) {
+        return &d_lu[(static_cast<size_t>(i) * k + j) * B];
+    };
+
+    for (size_t n = 0; n < d_lu.size(); ++n)
+        d_lu[n] = beta * d_operator[n];
+    for (int i = 0; i < k; ++i)
+    {
+        double* lii = lu(i, i);
+        for (int b = 0; b < B; ++b)
+            lii[b] += alpha;
+    }
+
+    for (int c = 0; c < k; ++c)
+    {
+        // Partial pivoting is chosen per member; the row swaps are the only
+        // step that is not vectorized across members.
+        int* pivots = &d_pivots[static_cast<size_t>(c) * B];
+        for (int b = 0; b < B; ++b)
+        {
+            int p = c;
+            double pmax = std::abs(lu(c, c)[b]);
+            for (int r = c + 1; r < k; ++r)
+            {
+                if (std::abs(lu(r, c)[b]) > pmax)
+                {
+                    pmax = std::abs(lu(r, c)[b]);
+                    p = r;
+                }
+            }
+            CAROM_VERIFY(pmax > 0.0);
+            pivots[b] = p;
+            if (p != c)
+            {
+                for (int j = 0; j < k; ++j)
+                    std::swap(lu(c, j)[b], lu(p, j)[b]);
+            }
+        }
+
+        const double* lcc = lu(c, c);
+        for (int r = c + 1; r < k; ++r)
+        {
+            double* lrc = lu(r, c);
+            for (int b = 0; b < B; ++b)
+                lrc[b] /= lcc[b];
+            for (int j = c + 1; j < k; ++j)
+            {
+                double* lrj = lu(r, j);
+                const double* lcj = lu(c, j);
+                for (int b = 0; b < B; ++b)
+                    lrj[b] -= lrc[b] * lcj[b];
+            }
+        }
+    }
+
+    d_factored = true;
+    d_factored_alpha = alpha;
+    d_factored_beta = beta;
+}
+
+void
+ReducedEnsemble::solveShifted(
+    double* rhs) const
+{
+    CAROM_VERIFY(d_factored);
+
+    const int k = d_dim;
+    const int B = d_num_members;
+    auto lu = [&](int i, int j) {
+        return &d_lu[(static_cast<size_t>(i) * k + j) * B];
+    };
+
+    for (int c = 0; c < k; ++c)
+    {
+        const int* pivots = &d_pivots[static_cast<size_t>(c) * B];
+        for (int b = 0; b < B; ++b)
+        {
+            if (pivots[b] != c)
+                std::swap(rhs[static_cast<size_t>(c) * B + b],
+                          rhs[static_cast<size_t>(pivots[b]) * B + b]);
+        }
+    }
+
+    // Forward substitution with the unit lower triangular factor.
+    for (int r = 1; r < k; ++r)
+    {
+        double* xr = rhs + static_cast<size_t>(r) * B;
+        for (int c = 0; c < r; ++c)
+        {
+            const double* lrc = lu(r, c);
+            const double* xc = rhs + static_cast<size_t>(c) * B;
+            for (int b = 0; b < B; ++b)
+                xr[b] -= lrc[b] * xc[b];
+        }
+    }
+
+    // Back substitution with the upper triangular factor.
+    for (int r = k - 1; r >= 0; --r)
+    {
+        double* xr = rhs + static_cast<size_t>(r) * B;
+        for (int c = r + 1; c < k; ++c)
+        {
+            const double* lrc = lu(r, c);
+            const double* xc = rhs + static_cast<size_t>(c) * B;
+            for (int b = 0; b < B; ++b)
+                xr[b] -= lrc[b] * xc[b];
+        }
+        const double* lrr = lu(r, r);
+        for (int b = 0; b < B; ++b)
+            xr[b] /= lrr[b];
+    }
+}
+
+void
+ReducedEnsemble::forwardEulerStep(
+    double dt)
+{
+    mult(d_state.data(), d_work.data());
+    for (size_t n = 0; n < d_state.size(); ++n)
+        d_state[n] += dt * (d_work[n] + d_forcing[n]);
+}
+
+void
+ReducedEnsemble::backwardEulerStep(
+    double dt)
+{
+    factorShiftedOperator(1.0, -dt);
+    for (size_t n = 0; n < d_state.size(); ++n)
+        d_state[n] += dt * d_forcing[n];
+    solveShifted(d_state.data());
+}
+
+}
@@ -0,0 +1,265 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2013-2024, Lawrence Livermore National Security, LLC
+ * and other libROM project developers. See the top-level COPYRIGHT
+ * file for details.
+ *
+ * SPDX-License-Identifier: (Apache-2.0 OR MIT)
+ *
+ *****************************************************************************/
+
+// Description: A batch of small reduced linear systems, one per ensemble
+//              member, stored as structure of arrays so that mat-vecs, LU
+//              solves and time steps are vectorized across the members.
+
+#ifndef included_ReducedEnsemble_h
+#define included_ReducedEnsemble_h
+
+#include <vector>
+
+namespace CAROM {
+
+class Matrix;
+class Vector;
+
+/**
+ * Class ReducedEnsemble holds the reduced states x_b, operators A_b and
+ * forcings f_b of an ensemble of reduced systems
+ *
+ *     dx_b/dt = A_b x_b + f_b,   b = 0, ..., num_members - 1,
+ *
+ * of the same dimension k, e.g. online ROM instances at different parameter
+ * values. Entry (i, j) of every member's operator is stored contiguously,
+ * as are entry i of the states and forcings, so each kernel loops over the
+ * members innermost and replaces num_members calls on k x k Matrix and
+ * Vector objects by one call with no allocation.
+ *
+ * The batch arrays passed to the public kernels use the same layout: entry i
+ * of member b is at i * num_members + b.
+ */
+class ReducedEnsemble
+{
+public:
+    /**
+     * @brief Constructor. The operators, forcings and states are zero.
+     *
+     * @pre dim > 0
+     * @pre num_members > 0
+     *
+     * @param[in] dim The dimension k of each reduced system.
+     * @param[in] num_members The number of ensemble members.
+     */
+    ReducedEnsemble(
+        int dim,
+        int num_members);
+
+    /**
+     * @brief Returns the dimension of each reduced system.
+     */
+    int
+    dim() const
+    {
+        return d_dim;
+    }
+
+    /**
+     * @brief Returns the number of ensemble members.
+     */
+    int
+    numMembers() const
+    {
+        return d_num_members;
+    }
+
+    /**
+     * @brief Sets the operator of one member.
+     *
+     * @pre 0 <= member < numMembers()
+     * @pre A is dim() x dim() and not distributed
+     */
+    void
+    setOperator(
+        int member,
+        const Matrix& A);
+
+    /**
+     * @brief Sets the operators of all members from an affine decomposition
+     *        A_b = sum_q coefficients(b, q) A_q.
+     *
+     * @pre terms are dim() x dim() and not distributed
+     * @pre coefficients is numMembers() x terms.size()
+     *
+     * @param[in] terms The parameter-independent operators A_q.
+     * @param[in] coefficients The coefficient of each term for each member.
+     */
+    void
+    setAffineOperator(
+        const std::vector<const Matrix*>& terms,
+        const Matrix& coefficients);
+
+    /**
+     * @brief Sets the forcing of one member.
+     *
+     * @pre 0 <= member < numMembers()
+     * @pre f.dim() == dim()
+     */
+    void
+    setForcing(
+        int member,
+        const Vector& f);
+
+    /**
+     * @brief Sets the state of one member.
+     *
+     * @pre 0 <= member < numMembers()
+     * @pre x.dim() == dim()
+     */
+    void
+    setState(
+        int member,
+        const Vector& x);
+
+    /**
+     * @brief Copies the state of one member into x.
+     *
+     * @pre 0 <= member < numMembers()
+     * @pre x.dim() == dim()
+     */
+    void
+    getState(
+        int member,
+        Vector& x) const;
+
+    /**
+     * @brief Returns the batch array of states, dim() * numMembers() entries.
+     */
+    double*
+    getStates()
+    {
+        return d_state.data();
+    }
+
+    /**
+     * @brief Computes y_b = A_b x_b for all members.
+     *
+     * @param[in] x The batch array of inputs.
+     * @param[out] y The batch array of outputs, not aliasing x.
+     */
+    void
+    mult(
+        const double* x,
+        double* y) const;
+
+    /**
+     * @brief Computes the LU factorizations with partial pivoting of
+     *        alpha I + beta A_b for all members.
+     *
+     * @pre Every factored matrix is nonsingular.
+     */
+    void
+    factorShiftedOperator(
+        double alpha,
+        double beta);
+
+    /**
+     * @brief Solves (alpha I + beta A_b) x_b = rhs_b in place for all
+     *        members, with the factorizations of factorShiftedOperator.
+     *
+     * @param[in,out] rhs The batch array of right hand sides, overwritten by
+     *                    the solutions.
+     */
+    void
+    solveShifted(
+        double* rhs) const;
+
+    /**
+     * @brief Advances all states by a forward Euler step,
+     *        x_b += dt (A_b x_b + f_b).
+     */
+    void
+    forwardEulerStep(
+        double dt);
+
+    /**
+     * @brief Advances all states by a backward Euler step,
+     *        (I - dt A_b) x_b^{n+1} = x_b^n + dt f_b.
+     *
+     * The factorizations are kept while dt and the operators do not change.
+     */
+    void
+    backwardEulerStep(
+        double dt);
+
+private:
+    /**
+     * @brief Unimplemented default constructor.
+     */
+    ReducedEnsemble();
+
+    /**
+     * @brief Unimplemented copy constructor.
+     */
+    ReducedEnsemble(
+        const ReducedEnsemble& other);
+
+    /**
+     * @brief Unimplemented assignment operator.
+     */
+    ReducedEnsemble&
+    operator = (
+        const ReducedEnsemble& rhs);
+
+    /**
+     * @brief The dimension of each reduced system.
+     */
+    const int d_dim;
+
+    /**
+     * @brief The number of ensemble members.
+     */
+    const int d_num_members;
+
+    /**
+     * @brief The operators, entry (i, j) of member b at
+     *        (i * dim + j) * num_members + b.
+     */
+    std::vector<double> d_operator;
+
+    /**
+     * @brief The batch array of forcings.
+     */
+    std::vector<double> d_forcing;
+
+    /**
+     * @brief The batch array of states.
+     */
+    std::vector<double> d_state;
+
+    /**
+     * @brief A batch array of work space.
+     */
+    std::vector<double> d_work;
+
+    /**
+     * @brief The LU factors of the shifted operators, in the layout of
+     *        d_operator.
+     */
+    std::vector<double> d_lu;
+
+    /**
+     * @brief The pivot row of each elimination step of each member.
+     */
+    std::vector<int> d_pivots;
+
+    /**
+     * @brief Whether d_lu holds the factors of alpha I + beta A for the
+     *        current operators, and the corresponding shift.
+     */
+    bool d_factored;
+    double d_factored_alpha;
+    double d_factored_beta;
+};
+
+}
+
+#endif
@@ -0,0 +1,257 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2013-2024, Lawrence Livermore National Security, LLC
+ * and other libROM project developers. See the top-level COPYRIGHT
+ * file for details.
+ *
+ * SPDX-License-Identifier: (Apache-2.0 OR MIT)
+ *
+ *****************************************************************************/
+
+// Description: Automatic choice of the SVD backend used by BasisGenerator.
+
+#include "SVDSelection.h"
+#include "BasisGenerator.h"
+#include "utils/mpi_utils.h"
+#include "mpi.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <vector>
+
+namespace CAROM {
+
+namespace {
+
+// Flop counts of the SVD of an a x b matrix, a >= b, by StaticSVD and by
+// RandomizedSVD with a subspace of dimension s: the sketch, the QR of the
+// sketch, the projection and the small SVD.
+double
+staticSVDWork(double a, double b)
+{
+    return 4.0 * a * b * b + 8.0 * b * b * b;
+}
+
+double
+randomizedSVDWork(double a, double b, double s)
+{
+    return 4.0 * a * b * s + 4.0 * a * s * s + 8.0 * b * s * s;
+}
+
+// Shape of the calibration problem.
+const int calibration_dim = 8192;
+const int calibration_num_samples = 128;
+const int calibration_subspace_dim = 16;
+
+// Returns the time to compute the basis of random snapshots, maximized over
+// the processors.
+double
+timeBasis(const Options& options, int num_samples)
+{
+    int rank = 0;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    std::mt19937 gen(rank + 1);
+    std::normal_distribution<double> normal(0.0, 1.0);
+
+    BasisGenerator generator(options, false);
+    std::vector<double> sample(options.dim);
+    for (int j = 0; j < num_samples; ++j)
+    {
+        for (int i = 0; i < options.dim; ++i)
+            sample[i] = normal(gen);
+        generator.takeSample(sample.data());
+    }
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    double time = MPI_Wtime();
+    generator.getSpatialBasis();
+    time = MPI_Wtime() - time;
+    MPI_Allreduce(MPI_IN_PLACE, &time, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    return time;
+}
+
+// Measures the cost per flop of StaticSVD and RandomizedSVD on a small
+// problem.
+void
+calibrate(double& static_cost, double& randomized_cost)
+{
+    const int dim = split_dimension(calibration_dim, MPI_COMM_WORLD);
+    const double a = calibration_dim;
+    const double b = calibration_num_samples;
+    const double s = calibration_subspace_dim;
+
+    Options static_options(dim, calibration_num_samples);
+    static_options.setMaxBasisDimension(calibration_num_samples);
+    static_cost = timeBasis(static_options, calibration_num_samples) /
+                  staticSVDWork(a, b);
+
+    Options randomized_options(dim, calibration_num_samples);
+    randomized_options.setMaxBasisDimension(calibration_subspace_dim);
+    randomized_options.setRandomizedSVD(true, calibration_subspace_dim);
+    randomized_cost = timeBasis(randomized_options, calibration_num_samples) /
+                      randomizedSVDWork(a, b, s);
+}
+
+// Reads the costs for num_procs processors from the calibration file. Each
+// line holds a number of processors and the costs of StaticSVD and
+// RandomizedSVD.
+bool
+readCalibration(const std::string& file_name, int num_procs,
+                double& static_cost, double& randomized_cost)
+{
+    std::ifstream file(file_name);
+    std::string line;
+    bool found = false;
+    while (std::getline(file, line))
+    {
+        std::istringstream entry(line);
+        int procs;
+        double cs, cr;
+        if (entry >> procs >> cs >> cr && procs == num_procs && cs > 0.0 &&
+                cr > 0.0)
+        {
+            static_cost = cs;
+            randomized_cost = cr;
+            found = true;
+        }
+    }
+    return found;
+}
+
+}
+
+Options
+selectSVDBackend(const Options& options, bool incremental)
+{
+    CAROM_VERIFY(options.auto_svd);
+    CAROM_VERIFY(options.dim > 0);
+    CAROM_VERIFY(options.max_num_samples > 0);
+    CAROM_VERIFY(options.max_basis_dimension > 0);
+    CAROM_VERIFY(options.svd_oversampling >= 0);
+
+    int rank = 0;
+    int num_procs = 1;
+    double global_dim = options.dim;
+    int mpi_init;
+    MPI_Initialized(&mpi_init);
+    if (mpi_init)
+    {
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+        MPI_Allreduce(MPI_IN_PLACE, &global_dim, 1, MPI_DOUBLE, MPI_SUM,
+                      MPI_COMM_WORLD);
+    }
+
+    Options selected = options;
+    selected.auto_svd = false;
+    const int k = options.max_basis_dimension;
+    std::ostringstream reason;
+    std::string backend;
+
+    if (incremental)
+    {
+        selected.fast_update = false;
+        selected.fast_update_brand = global_dim > k;
+        if (selected.fast_update_brand)
+        {
+            backend = "IncrementalSVDBrand";
+            reason << "the amortized O(N k) basis update per sample is "
+                   << "cheaper than the O(N k^2) update of "
+                   << "IncrementalSVDStandard";
+        }
+        else
+        {
+            backend = "IncrementalSVDStandard";
+            reason << "the basis can span the whole space, so deferring the "
+                   << "basis update saves nothing";
+        }
+    }
+    else
+    {
+        const double m = options.max_num_samples;
+        const double a = std::max(global_dim, m);
+        const double b = std::min(global_dim, m);
+        const int s = options.randomized_subspace_dim > 0 ?
+                      options.randomized_subspace_dim :
+                      std::min(k, options.max_num_samples) + options.svd_oversampling;
+
+        if (s >= b)
+        {
+            selected.randomized = false;
+            backend = "StaticSVD";
+            reason << "the randomized subspace dimension " << s
+                   << " is not smaller than min(N, m)";
+        }
+        else
+        {
+            double static_cost = 1.0;
+            double randomized_cost = 2.0;
+            bool calibrated = false;
+            if (!options.svd_calibration_file.empty())
+            {
+                CAROM_VERIFY(mpi_init);
+                int found = 0;
+                if (rank == 0)
+                {
+                    found = readCalibration(options.svd_calibration_file,
+                                            num_procs, static_cost,
+                                            randomized_cost);
+                }
+                MPI_Bcast(&found, 1, MPI_INT, 0, MPI_COMM_WORLD);
+                if (found)
+                {
+                    MPI_Bcast(&static_cost, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+                    MPI_Bcast(&randomized_cost, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+                }
+                else
+                {
+                    calibrate(static_cost, randomized_cost);
+                    if (rank == 0)
+                    {
+                        std::ofstream file(options.svd_calibration_file,
+                                           std::ios::app);
+                        file << num_procs << " " << static_cost << " "
+                             << randomized_cost << std::endl;
+                    }
+                }
+                calibrated = true;
+            }
+
+            const double static_estimate = static_cost * staticSVDWork(a, b);
+            const double randomized_estimate = randomized_cost *
+                                               randomizedSVDWork(a, b, s);
+            selected.randomized = randomized_estimate < static_estimate;
+            if (selected.randomized)
+            {
+                selected.randomized_subspace_dim = s;
+                backend = "RandomizedSVD with subspace dimension " +
+                          std::to_string(s);
+            }
+            else
+            {
+                backend = "StaticSVD";
+            }
+            reason << "estimated costs from the "
+                   << (calibrated ? "measured" : "default")
+                   << " cost per flop are " << static_estimate
+                   << " for StaticSVD and " << randomized_estimate
+                   << " for RandomizedSVD";
+        }
+    }
+
+    if (rank == 0)
+    {
+        std::cout << "Automatic SVD backend selection: " << backend
+                  << " (N = " << static_cast<long long>(global_dim) << ", m = "
+                  << options.max_num_samples << ", k = " << k << ", "
+                  << num_procs << " processors): " << reason.str() << "."
+                  << std::endl;
+    }
+
+    return selected;
+}
+
+}
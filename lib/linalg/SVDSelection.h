@@ -0,0 +1,51 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2013-2024, Lawrence Livermore National Security, LLC
+ * and other libROM project developers. See the top-level COPYRIGHT
+ * file for details.
+ *
+ * SPDX-License-Identifier: (Apache-2.0 OR MIT)
+ *
+ *****************************************************************************/
+
+// Description: Automatic choice of the SVD backend used by BasisGenerator
+//              from the problem shape and, optionally, from timings measured
+//              on this machine.
+
+#ifndef included_SVDSelection_h
+#define included_SVDSelection_h
+
+#include "Options.h"
+
+namespace CAROM {
+
+/**
+ * @brief Returns a copy of options whose flags select the SVD backend
+ *        expected to be fastest, and prints the decision and its reasons on
+ *        rank 0. Collective.
+ *
+ * For incremental sampling, IncrementalSVDBrand is chosen when the global
+ * dimension N exceeds max_basis_dimension k, since its amortized basis
+ * update costs O(N k) per sample instead of the O(N k^2) of
+ * IncrementalSVDStandard; otherwise IncrementalSVDStandard is kept.
+ *
+ * For batch sampling, StaticSVD and RandomizedSVD with a subspace of
+ * dimension s = k + svd_oversampling (or the given randomized subspace
+ * dimension) are compared by their flop counts on an N x max_num_samples
+ * snapshot matrix, each scaled by a cost per flop. The default costs charge
+ * RandomizedSVD twice as much per flop for its redistributions of the
+ * snapshot matrix. If svd_calibration_file is set, the costs are instead
+ * read from that file for the current number of processors, or measured on
+ * a small problem and appended to it.
+ *
+ * @param[in] options The options, with auto_svd set.
+ * @param[in] incremental Whether the basis is generated incrementally.
+ *
+ * @return The options with the flags of the chosen backend set and
+ *         auto_svd cleared.
+ */
+Options selectSVDBackend(const Options& options, bool incremental);
+
+}
+
+#endif
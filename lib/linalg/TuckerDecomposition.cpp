@@ -0,0 +1,415 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2013-2024, Lawrence Livermore National Security, LLC
+ * and other libROM project developers. See the top-level COPYRIGHT
+ * file for details.
+ *
+ * SPDX-License-Identifier: (Apache-2.0 OR MIT)
+ *
+ *****************************************************************************/
+
+// Description: A distributed sequentially truncated higher-order SVD (Tucker
+//              decomposition) of space x time x parameter snapshot tensors.
+
+#include "TuckerDecomposition.h"
+#include "BasisGenerator.h"
+#include "Matrix.h"
+#include "Vector.h"
+#include "utils/Utilities.h"
+
+#include <algorithm>
+#include <utility>
+
+/* Use automatically detected Fortran name-mangling scheme */
+#define dgesdd CAROM_FC_GLOBAL(dgesdd, DGESDD)
+
+extern "C" {
+// Serial SVD of a matrix.
+    void dgesdd(char*, int*, int*, double*, int*,
+                double*, double*, int*, double*, int*,
+                double*, int*, int*, int*);
+}
+
+namespace CAROM {
+
+namespace {
+
+// Returns the smallest rank whose discarded singular values have a squared
+// sum of at most budget, capped by max_rank if max_rank > 0.
+int
+truncatedRank(const double* sv, int n, double budget, int max_rank)
+{
+    int rank = n;
+    double tail = 0.0;
+    while (rank > 1 && tail + sv[rank - 1] * sv[rank - 1] <= budget)
+    {
+        tail += sv[rank - 1] * sv[rank - 1];
+        --rank;
+    }
+    if (max_rank > 0 && rank > max_rank) rank = max_rank;
+    return rank;
+}
+
+// Computes the left singular vectors U (m x min(m, n)) and singular values S
+// of the column-major m x n matrix A, which is overwritten.
+void
+leftSingularVectors(std::vector<double>& A, int m, int n,
+                    std::vector<double>& U, std::vector<double>& S)
+{
+    int mn = std::min(m, n);
+    U.resize(static_cast<size_t>(m) * mn);
+    S.resize(mn);
+    std::vector<double> VT(static_cast<size_t>(mn) * n);
+    std::vector<int> iwork(8 * mn);
+
+    char jobz = 'S';
+    int lwork = -1;
+    int info;
+    double work_size;
+    dgesdd(&jobz, &m, &n, A.data(), &m, S.data(), U.data(), &m, VT.data(),
+           &mn, &work_size, &lwork, iwork.data(), &info);
+    CAROM_VERIFY(info == 0);
+
+    lwork = static_cast<int>(work_size);
+    std::vector<double> work(lwork);
+    dgesdd(&jobz, &m, &n, A.data(), &m, S.data(), U.data(), &m, VT.data(),
+           &mn, work.data(), &lwork, iwork.data(), &info);
+    CAROM_VERIFY(info == 0);
+}
+
+}
+
+TuckerDecomposition::TuckerDecomposition(
+    int dim,
+    int num_time_steps,
+    double tol,
+    int max_space_rank,
+    int max_time_rank,
+    int max_param_rank) :
+    d_dim(dim),
+    d_num_time_steps(num_time_steps),
+    d_tol(tol),
+    d_num_params(0),
+    d_norm2(0.0),
+    d_spatial_factor(NULL),
+    d_temporal_factor(NULL),
+    d_parameter_factor(NULL)
+{
+    CAROM_VERIFY(dim > 0);
+    CAROM_VERIFY(num_time_steps > 0);
+    CAROM_VERIFY(tol >= 0.0);
+
+    d_max_rank[0] = max_space_rank;
+    d_max_rank[1] = max_time_rank;
+    d_max_rank[2] = max_param_rank;
+}
+
+TuckerDecomposition::~TuckerDecomposition()
+{
+    for (size_t p = 0; p < d_slice_space.size(); ++p)
+    {
+        delete d_slice_space[p];
+        delete d_slice_time[p];
+    }
+    delete d_spatial_factor;
+    delete d_temporal_factor;
+    delete d_parameter_factor;
+}
+
+void
+TuckerDecomposition::addParameterSnapshots(
+    const Matrix& snapshots)
+{
+    CAROM_VERIFY(!isComputed());
+    CAROM_VERIFY(snapshots.distributed());
+    CAROM_VERIFY(snapshots.numRows() == d_dim);
+    CAROM_VERIFY(snapshots.numColumns() == d_num_time_steps);
+
+    ++d_num_params;
+
+    // SVD of the space x time slice. Zero time steps are skipped by the
+    // sampler, so record which time steps the right singular vectors refer
+    // to.
+    Options options(d_dim, d_num_time_steps);
+    BasisGenerator generator(options, false);
+    std::vector<double> column(d_dim);
+    std::vector<int> time_step;
+    for (int t = 0; t < d_num_time_steps; ++t)
+    {
+        for (int i = 0; i < d_dim; ++i)
+            column[i] = snapshots.item(i, t);
+        if (generator.takeSample(column.data()))
+            time_step.push_back(t);
+    }
+
+    if (time_step.empty())
+    {
+        d_slice_space.push_back(NULL);
+        d_slice_time.push_back(NULL);
+        return;
+    }
+
+    const Matrix* U = generator.getSpatialBasis();
+    const Matrix* V = generator.getTemporalBasis();
+    const Vector* S = generator.getSingularValues();
+
+    double norm2 = 0.0;
+    for (int l = 0; l < S->dim(); ++l)
+        norm2 += S->item(l) * S->item(l);
+    d_norm2 += norm2;
+
+    const int rank = truncatedRank(S->getData(), U->numColumns(),
+                                   0.25 * d_tol * d_tol * norm2, -1);
+
+    Matrix* space = new Matrix(d_dim, rank, true);
+    for (int i = 0; i < d_dim; ++i)
+        for (int l = 0; l < rank; ++l)
+            space->item(i, l) = U->item(i, l) * S->item(l);
+
+    Matrix* time = new Matrix(d_num_time_steps, rank, false);
+    *time = 0.0;
+    for (size_t s = 0; s < time_step.size(); ++s)
+        for (int l = 0; l < rank; ++l)
+            time->item(time_step[s], l) = V->item(s, l);
+
+    d_slice_space.push_back(space);
+    d_slice_time.push_back(time);
+}
+
+void
+TuckerDecomposition::compute()
+{
+    CAROM_VERIFY(!isComputed());
+    CAROM_VERIFY(d_norm2 > 0.0);
+
+    const double budget = 0.25 * d_tol * d_tol * d_norm2;
+    const int P = d_num_params;
+    const int T = d_num_time_steps;
+
+    // Spatial factor from the SVD of the compressed slices
+    // [U_1 S_1, ..., U_P S_P] = W S_w Z^T.
+    std::vector<int> offset(P + 1, 0);
+    for (int p = 0; p < P; ++p)
+        offset[p + 1] = offset[p] +
+                        (d_slice_space[p] ? d_slice_space[p]->numColumns() : 0);
+
+    Options options(d_dim, offset[P]);
+    BasisGenerator generator(options, false);
+    std::vector<double> column(d_dim);
+    for (int p = 0; p < P; ++p)
+    {
+        if (!d_slice_space[p]) continue;
+        for (int l = 0; l < d_slice_space[p]->numColumns(); ++l)
+        {
+            for (int i = 0; i < d_dim; ++i)
+                column[i] = d_slice_space[p]->item(i, l);
+            CAROM_VERIFY(generator.takeSample(column.data()));
+        }
+        delete d_slice_space[p];
+        d_slice_space[p] = NULL;
+    }
+
+    const Matrix* W = generator.getSpatialBasis();
+    const Matrix* Z = generator.getTemporalBasis();
+    const Vector* S_w = generator.getSingularValues();
+
+    const int r_s = truncatedRank(S_w->getData(), W->numColumns(), budget,
+                                  d_max_rank[0]);
+    d_spatial_factor = new Matrix(d_dim, r_s, true);
+    for (int i = 0; i < d_dim; ++i)
+        for (int a = 0; a < r_s; ++a)
+            d_spatial_factor->item(i, a) = W->item(i, a);
+
+    // Y(a, t, p) = (U_s^T X_p)(a, t) = S_w(a) sum_l Z(offset_p + l, a) V_p(t, l),
+    // stored as the column-major T x (r_s P) mode-2 unfolding.
+    std::vector<double> Y(static_cast<size_t>(T) * r_s * P, 0.0);
+    for (int p = 0; p < P; ++p)
+    {
+        const Matrix* V = d_slice_time[p];
+        if (!V) continue;
+        for (int a = 0; a < r_s; ++a)
+        {
+            double* y = Y.data() + static_cast<size_t>(T) * (a + r_s * p);
+            for (int l = 0; l < V->numColumns(); ++l)
+            {
+                const double z = S_w->item(a) * Z->item(offset[p] + l, a);
+                for (int t = 0; t < T; ++t)
+                    y[t] += z * V->item(t, l);
+            }
+        }
+        delete d_slice_time[p];
+        d_slice_time[p] = NULL;
+    }
+
+    // Temporal factor from the mode-2 unfolding of Y.
+    std::vector<double> A(Y);
+    std::vector<double> U, S;
+    leftSingularVectors(A, T, r_s * P, U, S);
+    const int r_t = truncatedRank(S.data(), static_cast<int>(S.size()),
+                                  budget, d_max_rank[1]);
+    d_temporal_factor = new Matrix(T, r_t, false);
+    for (int t = 0; t < T; ++t)
+        for (int j = 0; j < r_t; ++j)
+            d_temporal_factor->item(t, j) = U[t + static_cast<size_t>(T) * j];
+
+    // Y2(a, j, p) = sum_t U_t(t, j) Y(a, t, p), stored as the column-major
+    // P x (r_s r_t) mode-3 unfolding.
+    std::vector<double> Y2(static_cast<size_t>(P) * r_s * r_t);
+    for (int p = 0; p < P; ++p)
+    {
+        for (int a = 0; a < r_s; ++a)
+        {
+            const double* y = Y.data() + static_cast<size_t>(T) * (a + r_s * p);
+            for (int j = 0; j < r_t; ++j)
+            {
+                double sum = 0.0;
+                for (int t = 0; t < T; ++t)
+                    sum += d_temporal_factor->item(t, j) * y[t];
+                Y2[p + static_cast<size_t>(P) * (a + r_s * j)] = sum;
+            }
+        }
+    }
+
+    // Parameter factor from the mode-3 unfolding.
+    A = Y2;
+    leftSingularVectors(A, P, r_s * r_t, U, S);
+    const int r_p = truncatedRank(S.data(), static_cast<int>(S.size()),
+                                  budget, d_max_rank[2]);
+    d_parameter_factor = new Matrix(P, r_p, false);
+    for (int p = 0; p < P; ++p)
+        for (int k = 0; k < r_p; ++k)
+            d_parameter_factor->item(p, k) = U[p + static_cast<size_t>(P) * k];
+
+    // Core G(a, j, k) = sum_p U_p(p, k) Y2(a, j, p).
+    d_core.assign(static_cast<size_t>(r_s) * r_t * r_p, 0.0);
+    for (int k = 0; k < r_p; ++k)
+    {
+        for (int aj = 0; aj < r_s * r_t; ++aj)
+        {
+            double sum = 0.0;
+            for (int p = 0; p < P; ++p)
+                sum += d_parameter_factor->item(p, k) *
+                       Y2[p + static_cast<size_t>(P) * aj];
+            d_core[aj + static_cast<size_t>(r_s) * r_t * k] = sum;
+        }
+    }
+}
+
+const Matrix*
+TuckerDecomposition::getSpatialFactor() const
+{
+    CAROM_VERIFY(isComputed());
+    return d_spatial_factor;
+}
+
+const Matrix*
+TuckerDecomposition::getTemporalFactor() const
+{
+    CAROM_VERIFY(isComputed());
+    return d_temporal_factor;
+}
+
+const Matrix*
+TuckerDecomposition::getParameterFactor() const
+{
+    CAROM_VERIFY(isComputed());
+    return d_parameter_factor;
+}
+
+double
+TuckerDecomposition::getCore(
+    int i,
+    int j,
+    int k) const
+{
+    CAROM_VERIFY(isComputed());
+    const int r_s = d_spatial_factor->numColumns();
+    const int r_t = d_temporal_factor->numColumns();
+    CAROM_VERIFY(0 <= i && i < r_s);
+    CAROM_VERIFY(0 <= j && j < r_t);
+    CAROM_VERIFY(0 <= k && k < d_parameter_factor->numColumns());
+    return d_core[i + static_cast<size_t>(r_s) * (j + r_t * k)];
+}
+
+void
+TuckerDecomposition::getSpaceTimeBasis(
+    int num_vectors,
+    Matrix*& s_basis,
+    Matrix*& t_basis) const
+{
+    CAROM_VERIFY(isComputed());
+    const int r_s = d_spatial_factor->numColumns();
+    const int r_t = d_temporal_factor->numColumns();
+    const int r_p = d_parameter_factor->numColumns();
+    CAROM_VERIFY(0 < num_vectors && num_vectors <= r_s * r_t);
+
+    // Energy of each space-time pair over the parameter mode.
+    std::vector<std::pair<double, int> > energy(r_s * r_t);
+    for (int aj = 0; aj < r_s * r_t; ++aj)
+    {
+        double e = 0.0;
+        for (int k = 0; k < r_p; ++k)
+        {
+            const double g = d_core[aj + static_cast<size_t>(r_s) * r_t * k];
+            e += g * g;
+        }
+        energy[aj] = std::make_pair(-e, aj);
+    }
+    std::stable_sort(energy.begin(), energy.end());
+
+    s_basis = new Matrix(d_dim, num_vectors, true);
+    t_basis = new Matrix(d_num_time_steps, num_vectors, false);
+    for (int n = 0; n < num_vectors; ++n)
+    {
+        const int a = energy[n].second % r_s;
+        const int j = energy[n].second / r_s;
+        for (int i = 0; i < d_dim; ++i)
+            s_basis->item(i, n) = d_spatial_factor->item(i, a);
+        for (int t = 0; t < d_num_time_steps; ++t)
+            t_basis->item(t, n) = d_temporal_factor->item(t, j);
+    }
+}
+
+Matrix*
+TuckerDecomposition::getParameterSnapshots(
+    int param) const
+{
+    CAROM_VERIFY(isComputed());
+    CAROM_VERIFY(0 <= param && param < d_num_params);
+    const int r_s = d_spatial_factor->numColumns();
+    const int r_t = d_temporal_factor->numColumns();
+    const int r_p = d_parameter_factor->numColumns();
+
+    // C(a, j) = sum_k G(a, j, k) U_p(param, k).
+    Matrix C(r_s, r_t, false);
+    for (int a = 0; a < r_s; ++a)
+    {
+        for (int j = 0; j < r_t; ++j)
+        {
+            double sum = 0.0;
+            for (int k = 0; k < r_p; ++k)
+                sum += d_core[a + static_cast<size_t>(r_s) * (j + r_t * k)] *
+                       d_parameter_factor->item(param, k);
+            C.item(a, j) = sum;
+        }
+    }
+
+    // U_s C U_t^T.
+    Matrix* UsC = d_spatial_factor->mult(C);
+    Matrix* snapshots = new Matrix(d_dim, d_num_time_steps, true);
+    for (int i = 0; i < d_dim; ++i)
+    {
+        for (int t = 0; t < d_num_time_steps; ++t)
+        {
+            double sum = 0.0;
+            for (int j = 0; j < r_t; ++j)
+                sum += UsC->item(i, j) * d_temporal_factor->item(t, j);
+            snapshots->item(i, t) = sum;
+        }
+    }
+    delete UsC;
+
+    return snapshots;
+}
+
+}
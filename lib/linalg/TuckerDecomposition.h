@@ -0,0 +1,265 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2013-2024, Lawrence Livermore National Security, LLC
+ * and other libROM project developers. See the top-level COPYRIGHT
+ * file for details.
+ *
+ * SPDX-License-Identifier: (Apache-2.0 OR MIT)
+ *
+ *****************************************************************************/
+
+// Description: A distributed sequentially truncated higher-order SVD (Tucker
+//              decomposition) of space x time x parameter snapshot tensors.
+
+#ifndef included_TuckerDecomposition_h
+#define included_TuckerDecomposition_h
+
+#include <cstddef>
+#include <vector>
+
+namespace CAROM {
+
+class Matrix;
+
+/**
+ * Class TuckerDecomposition computes a Tucker decomposition
+ *
+ *     X(:, t, p) ~ sum_{i,j,k} G(i, j, k) U_s(:, i) U_t(t, j) U_p(p, k)
+ *
+ * of a snapshot tensor indexed by space, time and parameter, without forming
+ * the space x (time * parameter) unfolding. The spatial index is distributed
+ * like the rows of a distributed Matrix.
+ *
+ * The snapshots of each parameter are compressed as they are added, by a
+ * truncated SVD of the space x time slice computed with the StaticSVD
+ * backend, so only the scaled left singular vectors and the right singular
+ * vectors of each slice are kept. compute() then obtains the spatial factor
+ * from an SVD of the compressed slices, and the temporal and parameter
+ * factors by the sequentially truncated HOSVD of the small projected tensor.
+ * Memory is proportional to the spatial dimension times the sum of the slice
+ * ranks, and the distributed SVD acts on that many columns rather than on
+ * the number of time steps times the number of parameters.
+ *
+ * Each of the four truncations discards at most a quarter of tol^2 times the
+ * squared Frobenius norm of the tensor, so the relative error of the
+ * decomposition is about tol.
+ */
+class TuckerDecomposition
+{
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @pre dim > 0
+     * @pre num_time_steps > 0
+     * @pre tol >= 0.0
+     *
+     * @param[in] dim The spatial dimension on this processor.
+     * @param[in] num_time_steps The number of time steps of each parameter.
+     * @param[in] tol The relative truncation tolerance.
+     * @param[in] max_space_rank Maximum rank of the spatial factor, or -1.
+     * @param[in] max_time_rank Maximum rank of the temporal factor, or -1.
+     * @param[in] max_param_rank Maximum rank of the parameter factor, or -1.
+     */
+    TuckerDecomposition(
+        int dim,
+        int num_time_steps,
+        double tol = 1.0e-8,
+        int max_space_rank = -1,
+        int max_time_rank = -1,
+        int max_param_rank = -1);
+
+    /**
+     * @brief Destructor.
+     */
+    ~TuckerDecomposition();
+
+    /**
+     * @brief Adds the snapshots of the next parameter. Collective.
+     *
+     * @pre !isComputed()
+     * @pre snapshots.distributed()
+     * @pre snapshots.numRows() == dim
+     * @pre snapshots.numColumns() == num_time_steps
+     *
+     * @param[in] snapshots The space x time snapshot matrix, one column per
+     *                      time step.
+     */
+    void
+    addParameterSnapshots(
+        const Matrix& snapshots);
+
+    /**
+     * @brief Computes the factors and the core. Collective.
+     *
+     * @pre !isComputed()
+     * @pre At least one nonzero snapshot was added.
+     */
+    void
+    compute();
+
+    /**
+     * @brief Returns true once compute() has been called.
+     */
+    bool
+    isComputed() const
+    {
+        return d_spatial_factor != NULL;
+    }
+
+    /**
+     * @brief Returns the number of parameters added.
+     */
+    int
+    numParameters() const
+    {
+        return d_num_params;
+    }
+
+    /**
+     * @brief Returns the distributed spatial factor U_s, with orthonormal
+     *        columns.
+     *
+     * @pre isComputed()
+     */
+    const Matrix*
+    getSpatialFactor() const;
+
+    /**
+     * @brief Returns the temporal factor U_t, num_time_steps x time rank,
+     *        with orthonormal columns.
+     *
+     * @pre isComputed()
+     */
+    const Matrix*
+    getTemporalFactor() const;
+
+    /**
+     * @brief Returns the parameter factor U_p, numParameters() x parameter
+     *        rank, with orthonormal columns.
+     *
+     * @pre isComputed()
+     */
+    const Matrix*
+    getParameterFactor() const;
+
+    /**
+     * @brief Returns the core entry G(i, j, k).
+     *
+     * @pre isComputed()
+     */
+    double
+    getCore(
+        int i,
+        int j,
+        int k) const;
+
+    /**
+     * @brief Forms a space-time basis from the products of spatial and
+     *        temporal factor columns carrying the most energy in the core.
+     *
+     * The i-th basis vector is the space-time product of the i-th columns of
+     * s_basis and t_basis, which is the format of SpaceTimeProduct and
+     * SpaceTimeSampling. The products are orthonormal.
+     *
+     * @pre isComputed()
+     * @pre 0 < num_vectors <= spatial rank * temporal rank
+     *
+     * @param[in] num_vectors The number of space-time basis vectors.
+     * @param[out] s_basis The distributed spatial vectors, owned by the
+     *                     caller.
+     * @param[out] t_basis The temporal vectors, owned by the caller.
+     */
+    void
+    getSpaceTimeBasis(
+        int num_vectors,
+        Matrix*& s_basis,
+        Matrix*& t_basis) const;
+
+    /**
+     * @brief Returns the approximation of the snapshots of a parameter.
+     *
+     * @pre isComputed()
+     * @pre 0 <= param < numParameters()
+     *
+     * @param[in] param The index of the parameter.
+     *
+     * @return The distributed space x time approximation, owned by the
+     *         caller.
+     */
+    Matrix*
+    getParameterSnapshots(
+        int param) const;
+
+private:
+    /**
+     * @brief Unimplemented copy constructor.
+     */
+    TuckerDecomposition(
+        const TuckerDecomposition& other);
+
+    /**
+     * @brief Unimplemented assignment operator.
+     */
+    TuckerDecomposition&
+    operator = (
+        const TuckerDecomposition& rhs);
+
+    /**
+     * @brief The spatial dimension on this processor.
+     */
+    const int d_dim;
+
+    /**
+     * @brief The number of time steps of each parameter.
+     */
+    const int d_num_time_steps;
+
+    /**
+     * @brief The relative truncation tolerance.
+     */
+    const double d_tol;
+
+    /**
+     * @brief The maximum ranks of the space, time and parameter factors.
+     */
+    int d_max_rank[3];
+
+    /**
+     * @brief The number of parameters added.
+     */
+    int d_num_params;
+
+    /**
+     * @brief The squared Frobenius norm of the snapshot tensor.
+     */
+    double d_norm2;
+
+    /**
+     * @brief The left singular vectors of each slice scaled by the singular
+     *        values. Released by compute().
+     */
+    std::vector<Matrix*> d_slice_space;
+
+    /**
+     * @brief The right singular vectors of each slice, num_time_steps rows.
+     *        Released by compute().
+     */
+    std::vector<Matrix*> d_slice_time;
+
+    /**
+     * @brief The spatial, temporal and parameter factors.
+     */
+    Matrix* d_spatial_factor;
+    Matrix* d_temporal_factor;
+    Matrix* d_parameter_factor;
+
+    /**
+     * @brief The core tensor, with entry (i, j, k) at i + r_s * (j + r_t * k).
+     */
+    std::vector<double> d_core;
+};
+
+}
+
+#endif
@@ -14,6 +14,7 @@
 
 #include "Vector.h"
 #include "utils/HDFDatabase.h"
+#include "utils/AllreducePlan.h"
 
 #include "mpi.h"
 
@@ -63,7 +64,7 @@ Vector::Vector(
     CAROM_VERIFY(dim > 0);
     if (copy_data) {
         setSize(dim);
-        memcpy(d_vec, vec, d_alloc_size*sizeof(double));
+        first_touch_copy(d_vec, vec, d_alloc_size);
     }
     else {
         d_vec = vec;
@@ -96,7 +97,7 @@ Vector::Vector(
     else {
         d_num_procs = 1;
     }
-    memcpy(d_vec, other.d_vec, d_alloc_size*sizeof(double));
+    first_touch_copy(d_vec, other.d_vec, d_alloc_size);
 }
 
 Vector::~Vector()
@@ -113,7 +114,7 @@ Vector::operator = (
     d_distributed = rhs.d_distributed;
     d_num_procs = rhs.d_num_procs;
     setSize(rhs.d_dim);
-    memcpy(d_vec, rhs.d_vec, d_dim*sizeof(double));
+    first_touch_copy(d_vec, rhs.d_vec, d_dim);
     return *this;
 }
 
@@ -224,16 +225,12 @@ Vector::inner_product(
 {
     CAROM_VERIFY(dim() == other.dim());
     CAROM_ASSERT(distributed() == other.distributed());
-    double ip;
-    double local_ip = 0.0;
+    double ip = 0.0;
     for (int i = 0; i < d_dim; ++i) {
-        local_ip += d_vec[i]*other.d_vec[i];
+        ip += d_vec[i]*other.d_vec[i];
     }
     if (d_num_procs > 1 && d_distributed) {
-        MPI_Allreduce(&local_ip, &ip, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-    }
-    else {
-        ip = local_ip;
+        allreduce_sum(&ip, 1);
     }
     return ip;
 }
@@ -16,6 +16,7 @@
 #define included_Vector_h
 
 #include "utils/Utilities.h"
+#include "utils/FirstTouch.h"
 #include <vector>
 #include <functional>
 
@@ -239,8 +240,9 @@ public:
                 delete [] d_vec;
             }
 
-            // Allocate new array and initialize all values to zero.
-            d_vec = new double [dim] {0.0};
+            // Allocate new array and initialize all values to zero, in
+            // parallel for large arrays.
+            d_vec = first_touch_allocate(dim);
             d_alloc_size = dim;
         }
         d_dim = dim;
@@ -26,10 +26,100 @@
 
 namespace CAROM {
 
+namespace {
+
+// Returns the matrix [Q, Qi], distributed like Q and Qi.
+Matrix*
+appendColumns(
+    const Matrix& Q,
+    const Matrix& Qi)
+{
+    const int num_cols = Q.numColumns() + Qi.numColumns();
+    Matrix* result = new Matrix(Q.numRows(), num_cols, Q.distributed());
+    for (int i = 0; i < Q.numRows(); ++i) {
+        for (int j = 0; j < Q.numColumns(); ++j)
+            result->item(i, j) = Q.item(i, j);
+        for (int j = 0; j < Qi.numColumns(); ++j)
+            result->item(i, Q.numColumns() + j) = Qi.item(i, j);
+    }
+    return result;
+}
+
+// Returns the undistributed matrix [B; Bi].
+Matrix*
+appendRows(
+    const Matrix& B,
+    const Matrix& Bi)
+{
+    const int num_cols = B.numColumns();
+    Matrix* result = new Matrix(B.numRows() + Bi.numRows(), num_cols, false);
+    memcpy(result->getData(), B.getData(),
+           sizeof(double) * B.numRows() * num_cols);
+    memcpy(result->getData() + B.numRows() * num_cols, Bi.getData(),
+           sizeof(double) * Bi.numRows() * num_cols);
+    return result;
+}
+
+// Y -= Q C, for Q distributed like Y and C undistributed.
+void
+subtractProduct(
+    const Matrix& Q,
+    const Matrix& C,
+    Matrix& Y)
+{
+    Matrix* QC = Q.mult(C);
+    for (int i = 0; i < Y.numRows(); ++i)
+        for (int j = 0; j < Y.numColumns(); ++j)
+            Y.item(i, j) -= QC->item(i, j);
+    delete QC;
+}
+
+// The square of the largest singular value of the undistributed B, the
+// largest eigenvalue of B B^T.
+double
+largestSquaredSingularValue(
+    const Matrix& B)
+{
+    const int k = B.numRows();
+    Matrix BBt(k, k, false);
+    for (int i = 0; i < k; ++i) {
+        for (int j = 0; j <= i; ++j) {
+            double dot = 0.0;
+            for (int c = 0; c < B.numColumns(); ++c)
+                dot += B.item(i, c) * B.item(j, c);
+            BBt.item(i, j) = dot;
+            BBt.item(j, i) = dot;
+        }
+    }
+    EigenPair eigenpair = SymmetricRightEigenSolve(&BBt);
+    delete eigenpair.ev;
+    return eigenpair.eigs.back();
+}
+
+// The sum of the squares of the local entries of A.
+double
+localSquaredNorm(
+    const Matrix& A)
+{
+    double norm2 = 0.0;
+    const double* a = A.getData();
+    for (int i = 0; i < A.numRows() * A.numColumns(); ++i)
+        norm2 += a[i] * a[i];
+    return norm2;
+}
+
+}
+
 RandomizedSVD::RandomizedSVD(
     Options options) :
     StaticSVD(options),
-    d_subspace_dim(options.randomized_subspace_dim) {
+    d_subspace_dim(options.randomized_subspace_dim),
+    d_adaptive(options.randomized_adaptive),
+    d_max_subspace_dim(options.randomized_subspace_dim),
+    d_adaptive_tol(options.randomized_tol),
+    d_block_size(options.randomized_block_size),
+    d_random_seed(options.random_seed) {
+    CAROM_VERIFY(d_block_size > 0);
     srand(options.random_seed);
 }
 
@@ -41,6 +131,9 @@ RandomizedSVD::computeSVD()
 
     const int num_rows = d_total_dim;
     const int num_cols = d_num_samples;
+    if (d_adaptive) {
+        d_subspace_dim = d_max_subspace_dim;
+    }
     if (d_subspace_dim < 1 || d_subspace_dim > std::min(num_rows, num_cols)) {
         d_subspace_dim = std::min(num_rows, num_cols);
     }
@@ -82,41 +175,68 @@ RandomizedSVD::computeSVD()
 
     int snapshot_matrix_distributed_rows = std::max(num_rows, num_cols);
 
-    // Create a random matrix of smaller dimension to project the snapshot matrix
-    // If debug mode is turned on, just set rand_mat as an identity matrix of smaller size
-    // for reproducibility
-    Matrix* rand_mat;
-    if (d_debug_algorithm) {
-        rand_mat = new Matrix(snapshot_matrix->numColumns(), d_subspace_dim, false);
-        for (int i = 0; i < snapshot_matrix->numColumns(); i++) {
-            for (int j = 0; j < d_subspace_dim; j++) {
-                rand_mat->item(i, j) = (i == j);
-            }
+    Matrix* Q;
+    Matrix* svd_input_mat;
+    if (d_adaptive) {
+        // Grow the randomized subspace until it captures the snapshots to
+        // the tolerance. The projection Q^T A is then distributed by rows
+        // as in the fixed-dimension case.
+        Q = adaptiveRangeFinder(*snapshot_matrix, d_subspace_dim, svd_input_mat);
+        d_subspace_dim = Q->numColumns();
+        svd_input_mat->distribute(split_dimension(d_subspace_dim,
+                                  MPI_COMM_WORLD));
+        if (d_debug_algorithm && d_rank == 0) {
+            printf("Adaptive randomized subspace dimension: %d\n",
+                   d_subspace_dim);
         }
     }
     else {
-        rand_mat = new Matrix(snapshot_matrix->numColumns(), d_subspace_dim, false,
-                              true);
-    }
+        // Create a random matrix of smaller dimension to project the snapshot matrix
+        // If debug mode is turned on, just set rand_mat as an identity matrix of smaller size
+        // for reproducibility
+        Matrix* rand_mat;
+        if (d_debug_algorithm) {
+            rand_mat = new Matrix(snapshot_matrix->numColumns(), d_subspace_dim, false);
+            for (int i = 0; i < snapshot_matrix->numColumns(); i++) {
+                for (int j = 0; j < d_subspace_dim; j++) {
+                    rand_mat->item(i, j) = (i == j);
+                }
+            }
+        }
+        else {
+            rand_mat = new Matrix(snapshot_matrix->numColumns(), d_subspace_dim, false,
+                                  true);
+        }
 
-    // Project snapshot matrix onto random subspace
-    Matrix* rand_proj = snapshot_matrix->mult(rand_mat);
-    int rand_proj_rows = rand_proj->numRows();
-    delete rand_mat;
+        // Project snapshot matrix onto random subspace
+        Matrix* rand_proj = snapshot_matrix->mult(rand_mat);
+        int rand_proj_rows = rand_proj->numRows();
+        delete rand_mat;
 
-    Matrix* Q = rand_proj->qr_factorize();
+        Q = rand_proj->qr_factorize();
 
-    // Project d_samples onto Q
-    Matrix* svd_input_mat = Q->transposeMult(snapshot_matrix);
-    int svd_input_mat_distributed_rows = svd_input_mat->numDistributedRows();
+        // Project d_samples onto Q. The projection is left distributed by rows
+        // so that no process holds a full copy of it, and each process
+        // scatters its own block into the ScaLAPACK layout.
+        svd_input_mat = Q->transposeMultDistributed(*snapshot_matrix);
+    }
+    std::vector<int> svd_input_row_offset;
+    const int svd_input_mat_distributed_rows =
+        get_global_offsets(svd_input_mat->numRows(), svd_input_row_offset,
+                           MPI_COMM_WORLD);
 
     SLPK_Matrix svd_input;
     initialize_matrix(&svd_input, svd_input_mat->numColumns(),
-                      svd_input_mat->numDistributedRows(),
+                      svd_input_mat_distributed_rows,
                       d_npcol, d_nprow, d_blocksize, d_blocksize);
-    scatter_block(&svd_input, 1, 1,
-                  svd_input_mat->getData(),
-                  svd_input_mat->numColumns(), svd_input_mat->numDistributedRows(),0);
+    for (int rank = 0; rank < d_num_procs; ++rank) {
+        const int block_rows = svd_input_row_offset[rank + 1] -
+                               svd_input_row_offset[rank];
+        if (block_rows == 0) continue;
+        scatter_block(&svd_input, 1, svd_input_row_offset[rank] + 1,
+                      svd_input_mat->getData(),
+                      svd_input_mat->numColumns(), block_rows, rank);
+    }
     delete svd_input_mat;
     delete snapshot_matrix;
 
@@ -133,7 +253,7 @@ RandomizedSVD::computeSVD()
     if (d_singular_value_tol == 0) {
         sigma_cutoff = std::numeric_limits<int>::max();
     } else {
-        for (int i = 0; i < num_cols; ++i) {
+        for (int i = 0; i < std::min(num_cols, d_subspace_dim); ++i) {
             if (d_factorizer->S[i] / d_factorizer->S[0] > d_singular_value_tol) {
                 sigma_cutoff += 1;
             } else {
@@ -223,4 +343,107 @@ RandomizedSVD::computeSVD()
 
 }
 
+Matrix*
+RandomizedSVD::adaptiveRangeFinder(
+    const Matrix& A,
+    int max_dim,
+    Matrix*& B)
+{
+    CAROM_VERIFY(A.distributed());
+    const int num_cols = A.numColumns();
+    CAROM_VERIFY(0 < max_dim && max_dim <= num_cols);
+
+    double norm2_A = localSquaredNorm(A);
+    MPI_Allreduce(MPI_IN_PLACE, &norm2_A, 1, MPI_DOUBLE, MPI_SUM,
+                  MPI_COMM_WORLD);
+    // The residual norm is updated by subtraction, so it is known only to
+    // about sqrt(eps) relative to ||A||_F, and smaller tolerances are raised
+    // to that accuracy.
+    const double eps = std::numeric_limits<double>::epsilon();
+    const double min_tol2 = 100.0 * eps * norm2_A;
+    const double exhausted2 = eps * norm2_A;
+
+    // The random directions are drawn from one sequence, the same on all
+    // processes, so that each block is new.
+    std::default_random_engine generator(d_random_seed);
+    std::normal_distribution<double> normal_distribution(0.0, 1.0);
+
+    Matrix* Q = NULL;
+    B = NULL;
+    double error2 = norm2_A;
+    int dim = 0;
+    while (dim < max_dim) {
+        const int block_size = std::min(d_block_size, max_dim - dim);
+        Matrix omega(num_cols, block_size, false);
+        for (int i = 0; i < num_cols; i++) {
+            for (int j = 0; j < block_size; j++) {
+                omega.item(i, j) = d_debug_algorithm ? (i == dim + j) :
+                                   normal_distribution(generator);
+            }
+        }
+
+        // Sample the range of the residual A - Q B.
+        Matrix* Y = A.mult(omega);
+        if (Q) {
+            Matrix* B_omega = B->mult(omega);
+            subtractProduct(*Q, *B_omega, *Y);
+            delete B_omega;
+        }
+        Matrix* Qi = Y->qr_factorize();
+        delete Y;
+
+        // Reorthogonalize the block against Q, which rounding errors in the
+        // residual sample do not keep it orthogonal to.
+        if (Q) {
+            Matrix* QtQi = Q->transposeMult(*Qi);
+            subtractProduct(*Q, *QtQi, *Qi);
+            delete QtQi;
+            Matrix* Qi_orth = Qi->qr_factorize();
+            delete Qi;
+            Qi = Qi_orth;
+        }
+
+        // The residual shrinks by the new rows of B, since Qi is orthogonal
+        // to Q.
+        Matrix* Bi = Qi->transposeMult(A);
+        const double norm2_Bi = localSquaredNorm(*Bi);
+        error2 -= norm2_Bi;
+
+        if (Q) {
+            Matrix* Q_new = appendColumns(*Q, *Qi);
+            Matrix* B_new = appendRows(*B, *Bi);
+            delete Q;
+            delete B;
+            delete Qi;
+            delete Bi;
+            Q = Q_new;
+            B = B_new;
+        }
+        else {
+            Q = Qi;
+            B = Bi;
+        }
+        dim += block_size;
+
+        // Stop at the tolerance, or when the snapshots are spanned and the
+        // new block adds nothing. Without randomized_tol, the singular
+        // values of A beyond the subspace dimension are at most the residual
+        // norm, so a residual of at most singular_value_tol times the largest
+        // singular value of B leaves out no singular value above the cutoff.
+        double tol2 = 0.0;
+        if (d_adaptive_tol > 0.0) {
+            tol2 = d_adaptive_tol * d_adaptive_tol * norm2_A;
+        }
+        else if (d_singular_value_tol > 0.0) {
+            tol2 = d_singular_value_tol * d_singular_value_tol *
+                   largestSquaredSingularValue(*B);
+        }
+        if (error2 <= std::max(tol2, min_tol2) || norm2_Bi <= exhausted2) {
+            break;
+        }
+    }
+
+    return Q;
+}
+
 }
@@ -29,6 +29,19 @@ namespace CAROM {
  *    Nathan Halko, Per-Gunnar Martinsson, and Joel A. Tropp.
  *    "Finding structure with randomness: Probabilistic algorithms for constructing approximate matrix decompositions."
  *    SIAM review 53.2 (2011): 217-288.
+ *
+ * With Options::randomized_adaptive, the randomized subspace is built by the
+ * blocked randQB_EI algorithm of
+ *    Wenjian Yu, Yu Gu, and Yaohang Li.
+ *    "Efficient randomized algorithms for the fixed-precision low-rank matrix approximation."
+ *    SIAM Journal on Matrix Analysis and Applications 39.3 (2018): 1339-1359.
+ * Blocks of random directions are added until the Frobenius norm of the
+ * residual A - Q B, updated from the norms of the blocks of B = Q^T A, meets
+ * the tolerance, so the subspace dimension follows the numerical rank of the
+ * snapshot matrix A. With Options::randomized_tol, the tolerance is relative
+ * to ||A||_F. Otherwise it is Options::singular_value_tol times the largest
+ * singular value of B, which bounds the singular values left out of the
+ * subspace by the cutoff of the SVD.
  */
 class RandomizedSVD : public StaticSVD
 {
@@ -70,11 +83,55 @@ private:
     void
     computeSVD();
 
+    /**
+     * @brief Computes an orthonormal basis of a randomized subspace of the
+     *        range of A, grown in blocks until the relative error tolerance
+     *        is met or the subspace dimension reaches max_dim.
+     *
+     * @param[in] A The distributed snapshot matrix.
+     * @param[in] max_dim The largest subspace dimension.
+     * @param[out] B The undistributed projection Q^T A.
+     *
+     * @return The distributed orthonormal basis Q of the subspace.
+     */
+    Matrix*
+    adaptiveRangeFinder(
+        const Matrix& A,
+        int max_dim,
+        Matrix*& B);
+
     /**
      * @brief The number of dimensions of the randomized subspace the
      * snapshot matrix will be projected to.
      */
     int d_subspace_dim;
+
+    /**
+     * @brief Whether the randomized subspace is grown adaptively.
+     */
+    bool d_adaptive;
+
+    /**
+     * @brief The upper bound on the adaptive subspace dimension, or a
+     *        non-positive value for none.
+     */
+    int d_max_subspace_dim;
+
+    /**
+     * @brief The relative error tolerance of the adaptive subspace, or a
+     *        non-positive value to stop at the singular value tolerance.
+     */
+    double d_adaptive_tol;
+
+    /**
+     * @brief The number of random directions added at a time.
+     */
+    int d_block_size;
+
+    /**
+     * @brief The random seed of the adaptive subspace.
+     */
+    int d_random_seed;
 };
 
 }
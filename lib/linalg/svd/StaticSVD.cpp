@@ -394,9 +394,12 @@ StaticSVD::get_global_info()
 
     for (unsigned i = 0; i < static_cast<unsigned>(d_num_procs); ++i) {
         d_total_dim += d_dims[i];
-        if (i > 0) {
-            d_istarts[i] = d_istarts[i-1] + d_dims[i-1];
-        }
+    }
+    // The distributed snapshot matrix is factored by ScaLAPACK, which
+    // addresses its rows with int.
+    CAROM_VERIFY(d_total_dim <= INT_MAX);
+    for (unsigned i = 1; i < static_cast<unsigned>(d_num_procs); ++i) {
+        d_istarts[i] = d_istarts[i-1] + d_dims[i-1];
     }
 }
 
@@ -17,6 +17,7 @@
 #include "SVD.h"
 #include "linalg/Options.h"
 #include "linalg/scalapack_wrapper.h"
+#include "utils/mpi_utils.h"
 
 #include <limits>
 #include <memory>
@@ -171,7 +172,7 @@ protected:
     /**
      * @brief The total dimension of the system (row dimension)
      */
-    int d_total_dim;
+    GlobalIndex d_total_dim;
 
     /**
      * @brief The number of processor rows in the grid.
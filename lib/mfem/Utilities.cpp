@@ -62,6 +62,33 @@ void ComputeCtAB_vec(const HypreParMatrix& A,
     C.transposeMult(AB_carom, CtAB_vec);
 }
 
+CAROM::ReducedJacobian* CreateReducedJacobian(const HypreParMatrix& J,
+        const CAROM::Matrix& Bsp)
+{
+    SparseMatrix diag;
+    J.GetDiag(diag);
+    MFEM_VERIFY(diag.Width() == J.GetGlobalNumCols(),
+                "In CreateReducedJacobian, J must be on a single process.");
+
+    const int n = diag.Height();
+    const std::vector<int> row_ptr(diag.GetI(), diag.GetI() + n + 1);
+    const std::vector<int> col_ind(diag.GetJ(),
+                                   diag.GetJ() + diag.NumNonZeroElems());
+    return new CAROM::ReducedJacobian(n, row_ptr, col_ind, Bsp);
+}
+
+void ComputeReducedJacobian(const HypreParMatrix& J,
+                            CAROM::ReducedJacobian& kernel,
+                            CAROM::Matrix& Jr)
+{
+    SparseMatrix diag;
+    J.GetDiag(diag);
+    MFEM_VERIFY(diag.NumNonZeroElems() == kernel.numNonzeros(),
+                "In ComputeReducedJacobian, the sparsity of J has changed.");
+
+    kernel.project(diag.GetData(), Jr);
+}
+
 void verify_within_portion(const mfem::Vector &bb_min,
                            const mfem::Vector &bb_max,
                            const mfem::Vector &t, const double limit)
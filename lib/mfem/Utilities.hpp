@@ -13,6 +13,7 @@
 
 #include "mfem.hpp"
 #include "linalg/Matrix.h"
+#include "hyperreduction/ReducedJacobian.h"
 
 using namespace mfem;
 using namespace std;
@@ -55,6 +56,40 @@ void ComputeCtAB_vec(const HypreParMatrix& A,
                      const CAROM::Matrix& C,
                      CAROM::Vector& CtAB_vec);
 
+/**
+ * @brief Analyzes the sparsity of a sample mesh Jacobian for repeated
+ *        projection onto the sample mesh rows of a basis.
+ *
+ * @param[in] J The sample mesh Jacobian, a HypreParMatrix (an MFEM class) on
+ *              the single process holding the sample mesh.
+ *
+ * @param[in] Bsp The non-distributed rows of the basis on the sample mesh
+ *                true DOFs, as returned by
+ *                SampleMeshManager::GatherDistributedMatrixRows.
+ *
+ * @return The projection kernel, to be used with ComputeReducedJacobian for
+ *         every Jacobian with the sparsity pattern of J.
+ *
+ */
+CAROM::ReducedJacobian* CreateReducedJacobian(const HypreParMatrix& J,
+        const CAROM::Matrix& Bsp);
+
+/**
+ * @brief This function computes the reduced Jacobian Bsp^t J Bsp with a
+ *        kernel created by CreateReducedJacobian.
+ *
+ * @param[in] J The sample mesh Jacobian, with the sparsity pattern given to
+ *              CreateReducedJacobian.
+ *
+ * @param[in] kernel The projection kernel.
+ *
+ * @param[out] Jr The non-distributed Matrix Bsp^t J Bsp.
+ *
+ */
+void ComputeReducedJacobian(const HypreParMatrix& J,
+                            CAROM::ReducedJacobian& kernel,
+                            CAROM::Matrix& Jr);
+
 /**
  * @brief Helper function to ensure that @p t is within a given percentage of
  * the domain relative to the center of the mesh. Performs the check for each
@@ -0,0 +1,162 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2013-2024, Lawrence Livermore National Security, LLC
+ * and other libROM project developers. See the top-level COPYRIGHT
+ * file for details.
+ *
+ * SPDX-License-Identifier: (Apache-2.0 OR MIT)
+ *
+ *****************************************************************************/
+
+// Description: Plans for repeated in-place MPI reductions of a fixed shape,
+//              using MPI-4 persistent collectives when libROM is configured
+//              with USE_PERSISTENT_COLLECTIVES.
+
+#include "AllreducePlan.h"
+#include "Utilities.h"
+#include "CAROM_config.h"
+
+#include <cstring>
+#include <map>
+
+#if CAROM_USE_PERSISTENT_COLLECTIVES && (MPI_VERSION < 4)
+#error "USE_PERSISTENT_COLLECTIVES requires an MPI-4 library."
+#endif
+
+namespace CAROM {
+
+AllreducePlan::AllreducePlan(
+    int count,
+    MPI_Datatype datatype,
+    MPI_Op op,
+    MPI_Comm comm) :
+    d_count(count),
+    d_datatype(datatype),
+    d_op(op),
+    d_comm(comm),
+    d_persistent(false),
+    d_request(MPI_REQUEST_NULL)
+{
+    CAROM_VERIFY(count >= 0);
+
+#if CAROM_USE_PERSISTENT_COLLECTIVES
+    int type_size;
+    MPI_Type_size(datatype, &type_size);
+    d_buffer.resize(static_cast<size_t>(count) * type_size);
+    CAROM_VERIFY(MPI_Allreduce_init(MPI_IN_PLACE, d_buffer.data(), count,
+                                    datatype, op, comm, MPI_INFO_NULL,
+                                    &d_request) == MPI_SUCCESS);
+    d_persistent = true;
+#endif
+}
+
+AllreducePlan::~AllreducePlan()
+{
+    if (d_persistent)
+    {
+        // Plans held until exit may be destroyed after MPI_Finalize, which
+        // releases their requests.
+        int finalized;
+        MPI_Finalized(&finalized);
+        if (!finalized)
+        {
+            MPI_Request_free(&d_request);
+        }
+    }
+}
+
+void
+AllreducePlan::allreduce(
+    void* data)
+{
+    if (d_persistent)
+    {
+        std::memcpy(d_buffer.data(), data, d_buffer.size());
+        CAROM_VERIFY(MPI_Start(&d_request) == MPI_SUCCESS);
+        CAROM_VERIFY(MPI_Wait(&d_request, MPI_STATUS_IGNORE) == MPI_SUCCESS);
+        std::memcpy(data, d_buffer.data(), d_buffer.size());
+    }
+    else
+    {
+        CAROM_VERIFY(MPI_Allreduce(MPI_IN_PLACE, data, d_count, d_datatype,
+                                   d_op, d_comm) == MPI_SUCCESS);
+    }
+}
+
+#if CAROM_USE_PERSISTENT_COLLECTIVES
+namespace {
+
+// The largest reduction allreduce_sum plans, in bytes. Persistent plans save
+// the setup of latency-bound reductions, while larger ones would keep a
+// buffer of their size and pay two copies per call for no gain.
+const size_t MAX_PLANNED_BYTES = 8192;
+
+// The maximum number of plans kept by allreduce_sum. Counts beyond them are
+// reduced by MPI_Allreduce, which every process decides at the same call.
+const size_t MAX_CACHED_PLANS = 32;
+
+// The plans of allreduce_sum by count.
+std::map<int, AllreducePlan*> sum_plans;
+
+// The key of the MPI_COMM_SELF attribute whose deletion at MPI_Finalize
+// frees the plans, or MPI_KEYVAL_INVALID before the first plan is cached.
+int finalize_keyval = MPI_KEYVAL_INVALID;
+
+int
+free_plans_at_finalize(
+    MPI_Comm comm,
+    int keyval,
+    void* attribute_val,
+    void* extra_state)
+{
+    free_allreduce_plans();
+    return MPI_SUCCESS;
+}
+
+}
+#endif
+
+void
+allreduce_sum(
+    double* data,
+    int count)
+{
+#if CAROM_USE_PERSISTENT_COLLECTIVES
+    if (finalize_keyval == MPI_KEYVAL_INVALID)
+    {
+        // MPI_Finalize deletes the attributes of MPI_COMM_SELF first, while
+        // the requests can still be freed.
+        MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, free_plans_at_finalize,
+                               &finalize_keyval, NULL);
+        MPI_Comm_set_attr(MPI_COMM_SELF, finalize_keyval, NULL);
+    }
+    auto it = sum_plans.find(count);
+    if (it == sum_plans.end() && sum_plans.size() < MAX_CACHED_PLANS &&
+            static_cast<size_t>(count) * sizeof(double) <= MAX_PLANNED_BYTES)
+    {
+        it = sum_plans.insert(std::make_pair(count,
+                                             new AllreducePlan(count, MPI_DOUBLE, MPI_SUM))).first;
+    }
+    if (it != sum_plans.end())
+    {
+        it->second->allreduce(data);
+        return;
+    }
+#endif
+    CAROM_VERIFY(MPI_Allreduce(MPI_IN_PLACE, data, count, MPI_DOUBLE, MPI_SUM,
+                               MPI_COMM_WORLD) == MPI_SUCCESS);
+}
+
+void
+free_allreduce_plans()
+{
+#if CAROM_USE_PERSISTENT_COLLECTIVES
+    for (auto& plan : sum_plans)
+    {
+        delete plan.second;
+    }
+    sum_plans.clear();
+#endif
+}
+
+}
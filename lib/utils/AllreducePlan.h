@@ -0,0 +1,178 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2013-2024, Lawrence Livermore National Security, LLC
+ * and other libROM project developers. See the top-level COPYRIGHT
+ * file for details.
+ *
+ * SPDX-License-Identifier: (Apache-2.0 OR MIT)
+ *
+ *****************************************************************************/
+
+// Description: Plans for repeated in-place MPI reductions of a fixed shape,
+//              using MPI-4 persistent collectives when libROM is configured
+//              with USE_PERSISTENT_COLLECTIVES.
+
+#ifndef included_AllreducePlan_h
+#define included_AllreducePlan_h
+
+#include "mpi.h"
+#include <vector>
+
+namespace CAROM {
+
+/**
+ * Class AllreducePlan reduces an array of a fixed number of entries in place
+ * over a communicator, as MPI_Allreduce with MPI_IN_PLACE does, for loops
+ * that issue the same reduction many times.
+ *
+ * When libROM is configured with USE_PERSISTENT_COLLECTIVES, which requires an
+ * MPI-4 library, the plan is a persistent collective created once by
+ * MPI_Allreduce_init on a buffer owned by the plan, so the setup of the
+ * reduction is not repeated on every call. Each call copies the data into the
+ * buffer, starts and completes the request and copies the result back.
+ * Otherwise, the default, each call is a regular MPI_Allreduce.
+ *
+ * Creating a plan is collective over the communicator, and the plans of a
+ * communicator must be used in the same order on all of its processes, as
+ * for any collective.
+ */
+class AllreducePlan
+{
+public:
+    /**
+     * @brief Constructor. Collective over comm.
+     *
+     * @pre count >= 0
+     *
+     * @param[in] count The number of entries to reduce.
+     * @param[in] datatype The MPI datatype of the entries.
+     * @param[in] op The MPI reduction operation.
+     * @param[in] comm The communicator to reduce over.
+     */
+    AllreducePlan(
+        int count,
+        MPI_Datatype datatype,
+        MPI_Op op,
+        MPI_Comm comm = MPI_COMM_WORLD);
+
+    /**
+     * @brief Destructor. Frees the persistent request unless MPI has been
+     *        finalized.
+     */
+    ~AllreducePlan();
+
+    /**
+     * @brief Reduces the count entries of data in place over the
+     *        communicator.
+     *
+     * @param[in,out] data The entries to reduce, overwritten by the result.
+     */
+    void
+    allreduce(
+        void* data);
+
+    /**
+     * @brief Returns the number of entries reduced.
+     */
+    int
+    count() const
+    {
+        return d_count;
+    }
+
+    /**
+     * @brief Returns true if the plan is a persistent collective, false if
+     *        it falls back to MPI_Allreduce.
+     */
+    bool
+    persistent() const
+    {
+        return d_persistent;
+    }
+
+private:
+    /**
+     * @brief Unimplemented default constructor.
+     */
+    AllreducePlan();
+
+    /**
+     * @brief Unimplemented copy constructor.
+     */
+    AllreducePlan(
+        const AllreducePlan& other);
+
+    /**
+     * @brief Unimplemented assignment operator.
+     */
+    AllreducePlan&
+    operator = (
+        const AllreducePlan& rhs);
+
+    /**
+     * @brief The number of entries reduced.
+     */
+    int d_count;
+
+    /**
+     * @brief The MPI datatype of the entries.
+     */
+    MPI_Datatype d_datatype;
+
+    /**
+     * @brief The MPI reduction operation.
+     */
+    MPI_Op d_op;
+
+    /**
+     * @brief The communicator reduced over.
+     */
+    MPI_Comm d_comm;
+
+    /**
+     * @brief True if d_request is a persistent collective.
+     */
+    bool d_persistent;
+
+    /**
+     * @brief The buffer the persistent collective reduces, empty otherwise.
+     */
+    std::vector<char> d_buffer;
+
+    /**
+     * @brief The persistent request.
+     */
+    MPI_Request d_request;
+};
+
+/**
+ * @brief Sums count doubles in place over MPI_COMM_WORLD.
+ *
+ * With persistent collectives, only small, latency-bound reductions of at
+ * most 8 KiB are planned. The plan of each such count is created on first
+ * use and reused by later calls with the same count, and up to 32 plans are
+ * kept until free_allreduce_plans is called, at the latest by MPI_Finalize.
+ * Larger counts, and new counts once 32 plans are kept, are reduced by
+ * MPI_Allreduce. Like MPI_Allreduce, this must be called with the same count
+ * on all processes.
+ *
+ * @param[in,out] data The entries to sum, overwritten by the sums.
+ * @param[in] count The number of entries.
+ */
+void
+allreduce_sum(
+    double* data,
+    int count);
+
+/**
+ * @brief Frees the plans kept by allreduce_sum. Collective over
+ *        MPI_COMM_WORLD. MPI_Finalize calls it, and it may be called
+ *        earlier to release the requests, after which allreduce_sum
+ *        creates new plans as needed.
+ */
+void
+free_allreduce_plans();
+
+}
+
+#endif
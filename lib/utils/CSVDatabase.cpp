@@ -15,6 +15,7 @@
 #include <vector>
 #include <complex>
 #include <iomanip>
+#include <cctype>
 
 namespace CAROM {
 
@@ -70,6 +71,25 @@ CSVDatabase::putIntegerArray(
     d_fs.close();
 }
 
+void
+CSVDatabase::putInteger64Array(
+    const std::string& file_name,
+    const int64_t* const data,
+    int nelements,
+    const bool distributed)
+{
+    CAROM_VERIFY(!file_name.empty());
+    CAROM_VERIFY(data != nullptr);
+    CAROM_VERIFY(nelements > 0);
+
+    std::ofstream d_fs(file_name.c_str());
+    for (int i = 0; i < nelements; ++i)
+    {
+        d_fs << data[i] << std::endl;
+    }
+    d_fs.close();
+}
+
 void
 CSVDatabase::putDoubleArray(
     const std::string& file_name,
@@ -172,6 +192,30 @@ CSVDatabase::getIntegerArray(
     d_fs.close();
 }
 
+void
+CSVDatabase::getInteger64Array(
+    const std::string& file_name,
+    int64_t* data,
+    int nelements,
+    const bool distributed)
+{
+    CAROM_VERIFY(!file_name.empty());
+#ifndef DEBUG_CHECK_ASSERTIONS
+    CAROM_NULL_USE(nelements);
+#endif
+
+    std::ifstream d_fs(file_name.c_str());
+    if (d_fs.fail())
+        return;
+    int64_t data_entry = 0;
+    for (int i = 0; i < nelements; ++i)
+    {
+        d_fs >> data_entry;
+        data[i] = data_entry;
+    }
+    d_fs.close();
+}
+
 void
 CSVDatabase::getIntegerVector(
     const std::string& file_name,
@@ -232,23 +276,31 @@ CSVDatabase::getDoubleArray(
     }
     else
     {
+        CAROM_VERIFY(idx.back() < nelements);
         std::ifstream d_fs(file_name.c_str());
         CAROM_VERIFY(!d_fs.fail());
-        int k = 0;
-        double data_entry = 0.0;
-        for (int i = 0; i < nelements; ++i)
+
+        // Only the indexed entries are parsed. The entries in between are
+        // skipped as characters, and the file is read only up to the last
+        // indexed entry.
+        std::streambuf* buf = d_fs.rdbuf();
+        int i = 0;
+        for (size_t k = 0; k < idx.size(); ++k)
         {
-            d_fs >> data_entry;
-            if (idx[k] == i)
-            {
-                data[k++] = data_entry;
-            }
-            if (k == idx.size())
+            CAROM_VERIFY(idx[k] >= i);
+            for (; i < idx[k]; ++i)
             {
-                break;
+                d_fs >> std::ws;
+                while (buf->sgetc() != std::char_traits<char>::eof() &&
+                        !std::isspace(buf->sgetc()))
+                {
+                    buf->sbumpc();
+                }
             }
+            d_fs >> data[k];
+            CAROM_VERIFY(!d_fs.fail());
+            ++i;
         }
-        CAROM_VERIFY(k == idx.size());
         d_fs.close();
     }
 }
@@ -100,6 +100,28 @@ public:
         int nelements,
         const bool distributed=false) override;
 
+    /**
+     * @brief Writes an array of 64-bit integers associated with the supplied
+     *        filename.
+     *
+     * @pre !file_name.empty()
+     * @pre data != nullptr
+     * @pre nelements > 0
+     *
+     * @param[in] file_name The filename associated with the array of values to be
+     *                written.
+     * @param[in] data The array of integer values to be written.
+     * @param[in] nelements The number of integers in the array.
+     * @param[in] distributed True if data is a distributed integer array.
+     *                        CSVDatabase writes the array serially whether or not distributed.
+     */
+    void
+    putInteger64Array(
+        const std::string& file_name,
+        const int64_t* const data,
+        int nelements,
+        const bool distributed=false) override;
+
     /**
      * @brief Writes an array of doubles associated with the supplied filename.
      *
@@ -199,6 +221,27 @@ public:
         int nelements,
         const bool distributed=false) override;
 
+    /**
+     * @brief Reads an array of 64-bit integers associated with the supplied
+     *        filename.
+     *
+     * @pre !file_name.empty()
+     * @pre data != nullptr || nelements == 0
+     *
+     * @param[in] file_name The filename associated with the array of values to be
+     *                read.
+     * @param[out] data The allocated array of integer values to be read.
+     * @param[in] nelements The number of integers in the array.
+     * @param[in] distributed True if data is a distributed integer array.
+     *                        CSVDatabase reads the array serially whether or not distributed.
+     */
+    void
+    getInteger64Array(
+        const std::string& file_name,
+        int64_t* data,
+        int nelements,
+        const bool distributed=false) override;
+
     /**
      * @brief Reads a vector of integers associated with the supplied filename.
      *
@@ -254,15 +297,19 @@ public:
 
     /**
      * @brief Reads a sub-array of doubles associated with the supplied filename.
+     *        Only the indexed values are parsed, and the file is read only up
+     *        to the last indexed value.
      *
      * @pre !file_name.empty()
      * @pre data != nullptr || nelements == 0
+     * @pre idx is strictly increasing and in [0, nelements)
      *
      * @param[in] file_name The filename associated with the array of values to be
      *                read.
      * @param[out] data The allocated sub-array of double values to be read.
      * @param[in] nelements The number of doubles in the full array.
-     * @param[in] idx The set of indices in the sub-array.
+     * @param[in] idx The set of indices in the sub-array. If empty, the full
+     *                array is read.
      * @param[in] distributed True if data is a distributed integer array.
      *                        CSVDatabase reads the array serially whether or not distributed.
      */
@@ -14,6 +14,7 @@
 #define included_Database_h
 
 #include "Utilities.h"
+#include <cstdint>
 #include <string>
 #include <vector>
 #include "mpi.h"
@@ -118,6 +119,40 @@ public:
         int nelements,
         const bool distributed=false) = 0;
 
+    /**
+     * @brief Writes a 64-bit integer associated with the supplied key to
+     *        currently open database file.
+     *
+     * @param[in] key The key associated with the value to be written.
+     * @param[in] data The integer value to be written.
+     */
+    void
+    putInteger64(
+        const std::string& key,
+        int64_t data)
+    {
+        putInteger64Array(key, &data, 1);
+    }
+
+    /**
+     * @brief Writes an array of 64-bit integers associated with the
+     *        supplied key to the currently open database file.
+     *
+     * @param[in] key The key associated with the array of values to be
+     *                written.
+     * @param[in] data The array of integer values to be written.
+     * @param[in] nelements The number of integers in the array.
+     * @param[in] distributed If true, distributed integer array will be written.
+     *                        the distributed I/O behavior varies with classes.
+     */
+    virtual
+    void
+    putInteger64Array(
+        const std::string& key,
+        const int64_t* const data,
+        int nelements,
+        const bool distributed=false) = 0;
+
     /**
      * @brief Writes a double associated with the supplied key to currently
      *        open database file.
@@ -205,6 +240,41 @@ public:
         int nelements,
         const bool distributed=false) = 0;
 
+    /**
+     * @brief Reads a 64-bit integer associated with the supplied key from
+     *        the currently open database file. A value written as a 32-bit
+     *        integer is read as well.
+     *
+     * @param[in] key The key associated with the value to be read.
+     * @param[out] data The integer value read.
+     */
+    void
+    getInteger64(
+        const std::string& key,
+        int64_t& data)
+    {
+        getInteger64Array(key, &data, 1);
+    }
+
+    /**
+     * @brief Reads an array of 64-bit integers associated with the supplied
+     *        key from the currently open database file.
+     *
+     * @param[in] key The key associated with the array of values to be
+     *                read.
+     * @param[out] data The allocated array of integer values to be read.
+     * @param[in] nelements The number of integers in the array.
+     * @param[in] distributed If true, distributed integer array will be read.
+     *                        the distributed I/O behavior varies with classes.
+     */
+    virtual
+    void
+    getInteger64Array(
+        const std::string& key,
+        int64_t* data,
+        int nelements,
+        const bool distributed=false) = 0;
+
     /**
      * @brief Reads a double associated with the supplied key from the
      *        currently open database file.
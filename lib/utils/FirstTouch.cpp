@@ -0,0 +1,88 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2013-2024, Lawrence Livermore National Security, LLC
+ * and other libROM project developers. See the top-level COPYRIGHT
+ * file for details.
+ *
+ * SPDX-License-Identifier: (Apache-2.0 OR MIT)
+ *
+ *****************************************************************************/
+
+// Description: Allocation of large Matrix and Vector storage with parallel
+//              first-touch initialization for NUMA placement.
+
+#include "FirstTouch.h"
+#include "CAROM_config.h"
+
+#include <cstring>
+
+#if CAROM_HAVE_OPENMP
+#include <omp.h>
+#endif
+
+namespace CAROM {
+
+namespace {
+
+// 2 MB, the size of a huge page; below it the pages of one array cannot
+// be spread over several domains anyway.
+const size_t min_parallel_size = 262144;
+
+}
+
+double*
+first_touch_allocate(
+    size_t size)
+{
+    // new [] without an initializer does not write to the memory.
+    double* data = new double [size];
+#if CAROM_HAVE_OPENMP
+    if (size >= min_parallel_size)
+    {
+        #pragma omp parallel for schedule(static)
+        for (long long i = 0; i < static_cast<long long>(size); ++i)
+            data[i] = 0.0;
+        return data;
+    }
+#endif
+    if (size > 0)
+        memset(data, 0, size * sizeof(double));
+    return data;
+}
+
+void
+first_touch_copy(
+    double* dst,
+    const double* src,
+    size_t size)
+{
+#if CAROM_HAVE_OPENMP
+    if (size >= min_parallel_size)
+    {
+        #pragma omp parallel for schedule(static)
+        for (long long i = 0; i < static_cast<long long>(size); ++i)
+            dst[i] = src[i];
+        return;
+    }
+#endif
+    if (size > 0)
+        memcpy(dst, src, size * sizeof(double));
+}
+
+size_t
+first_touch_min_size()
+{
+    return min_parallel_size;
+}
+
+int
+first_touch_num_threads()
+{
+#if CAROM_HAVE_OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+}
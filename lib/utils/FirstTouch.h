@@ -0,0 +1,67 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2013-2024, Lawrence Livermore National Security, LLC
+ * and other libROM project developers. See the top-level COPYRIGHT
+ * file for details.
+ *
+ * SPDX-License-Identifier: (Apache-2.0 OR MIT)
+ *
+ *****************************************************************************/
+
+// Description: Allocation of large Matrix and Vector storage with parallel
+//              first-touch initialization for NUMA placement.
+
+#ifndef included_FirstTouch_h
+#define included_FirstTouch_h
+
+#include <cstddef>
+
+namespace CAROM {
+
+/**
+ * @brief Allocates an array of doubles with new [] and sets it to zero.
+ *
+ * Most operating systems place a page on the NUMA domain of the thread that
+ * first writes to it. When libROM is built with USE_OPENMP, arrays of at
+ * least first_touch_min_size() entries are zeroed by all OpenMP threads, each
+ * writing one contiguous block as a static schedule over the array would
+ * assign it. Threaded kernels that partition rows of a row-major Matrix the
+ * same way then read mostly local memory. Smaller arrays, and all arrays
+ * without OpenMP, are zeroed by the calling thread.
+ *
+ * @param[in] size The number of entries.
+ *
+ * @return The zeroed array, to be freed with delete [].
+ */
+double*
+first_touch_allocate(
+    size_t size);
+
+/**
+ * @brief Copies size entries from src to dst with the thread partitioning of
+ *        first_touch_allocate, so that a copy of a large array written by
+ *        one thread does not move it away from the threads using it.
+ */
+void
+first_touch_copy(
+    double* dst,
+    const double* src,
+    size_t size);
+
+/**
+ * @brief Returns the smallest array size, in entries, that is initialized
+ *        by all threads.
+ */
+size_t
+first_touch_min_size();
+
+/**
+ * @brief Returns the number of threads that initialize large arrays, 1
+ *        without OpenMP.
+ */
+int
+first_touch_num_threads();
+
+}
+
+#endif
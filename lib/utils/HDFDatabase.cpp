@@ -19,6 +19,14 @@ namespace CAROM {
 const int HDFDatabase::KEY_DOUBLE_ARRAY = 0;
 const int HDFDatabase::KEY_INT_ARRAY = 1;
 
+namespace {
+
+// The maximum number of strided hyperslabs whose union is selected by an
+// indexed read. Index sets with more are selected as points.
+const int MAX_HYPERSLAB_PATTERNS = 16;
+
+}
+
 HDFDatabase::HDFDatabase() :
     d_is_file(false),
     d_file_id(-1),
@@ -138,6 +146,27 @@ HDFDatabase::putIntegerArray(
     const int* const data,
     int nelements,
     const bool distributed)
+{
+    writeIntegerArray(key, data, nelements, H5T_STD_I32BE, H5T_NATIVE_INT);
+}
+
+void
+HDFDatabase::putInteger64Array(
+    const std::string& key,
+    const int64_t* const data,
+    int nelements,
+    const bool distributed)
+{
+    writeIntegerArray(key, data, nelements, H5T_STD_I64BE, H5T_NATIVE_INT64);
+}
+
+void
+HDFDatabase::writeIntegerArray(
+    const std::string& key,
+    const void* const data,
+    int nelements,
+    hid_t file_type,
+    hid_t mem_type)
 {
     CAROM_VERIFY(!key.empty());
     CAROM_VERIFY(data != nullptr);
@@ -150,7 +179,7 @@ HDFDatabase::putIntegerArray(
 #if (H5_VERS_MAJOR > 1) || ((H5_VERS_MAJOR == 1) && (H5_VERS_MINOR > 6))
     hid_t dataset = H5Dcreate(d_group_id,
                               key.c_str(),
-                              H5T_STD_I32BE,
+                              file_type,
                               space,
                               H5P_DEFAULT,
                               H5P_DEFAULT,
@@ -158,14 +187,14 @@ HDFDatabase::putIntegerArray(
 #else
     hid_t dataset = H5Dcreate(d_group_id,
                               key.c_str(),
-                              H5T_STD_I32BE,
+                              file_type,
                               space,
                               H5P_DEFAULT);
 #endif
     CAROM_VERIFY(dataset >= 0);
 
     herr_t errf = H5Dwrite(dataset,
-                           H5T_NATIVE_INT,
+                           mem_type,
                            H5S_ALL,
                            H5S_ALL,
                            H5P_DEFAULT,
@@ -254,6 +283,26 @@ HDFDatabase::getIntegerArray(
     int* data,
     int nelements,
     const bool distributed)
+{
+    readIntegerArray(key, data, nelements, H5T_NATIVE_INT);
+}
+
+void
+HDFDatabase::getInteger64Array(
+    const std::string& key,
+    int64_t* data,
+    int nelements,
+    const bool distributed)
+{
+    readIntegerArray(key, data, nelements, H5T_NATIVE_INT64);
+}
+
+void
+HDFDatabase::readIntegerArray(
+    const std::string& key,
+    void* data,
+    int nelements,
+    hid_t mem_type)
 {
     if (nelements == 0) return;
 
@@ -277,7 +326,7 @@ HDFDatabase::getIntegerArray(
 
     herr_t errf;
     if (nsel > 0) {
-        errf = H5Dread(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+        errf = H5Dread(dset, mem_type, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
         CAROM_VERIFY(errf >= 0);
     }
 
@@ -373,25 +422,123 @@ HDFDatabase::getDoubleArray(
     if (idx.size() == 0)
     {
         getDoubleArray(key, data, nelements);
+        return;
+    }
+
+    CAROM_VERIFY(!key.empty());
+    CAROM_VERIFY(idx.back() < nelements);
+
+#if (H5_VERS_MAJOR > 1) || ((H5_VERS_MAJOR == 1) && (H5_VERS_MINOR > 6))
+    hid_t dset = H5Dopen(d_group_id, key.c_str(), H5P_DEFAULT);
+#else
+    hid_t dset = H5Dopen(d_group_id, key.c_str());
+#endif
+    CAROM_VERIFY(dset >= 0);
+
+    hid_t dspace = H5Dget_space(dset);
+    CAROM_VERIFY(dspace >= 0);
+
+    hsize_t nsel = H5Sget_select_npoints(dspace);
+    CAROM_VERIFY(static_cast<int>(nsel) == nelements);
+
+    // Only the indexed entries are read, into consecutive entries of data.
+    selectIndices(dspace, idx, 0);
+    hsize_t buffer_array_size[1] = {(hsize_t) idx.size()};
+    hid_t memspace = H5Screate_simple(1, buffer_array_size, NULL);
+    CAROM_VERIFY(memspace >= 0);
+
+    herr_t errf = H5Dread(dset, H5T_NATIVE_DOUBLE, memspace, dspace,
+                          H5P_DEFAULT, data);
+    CAROM_VERIFY(errf >= 0);
+
+    errf = H5Sclose(memspace);
+    CAROM_VERIFY(errf >= 0);
+
+    errf = H5Sclose(dspace);
+    CAROM_VERIFY(errf >= 0);
+
+    errf = H5Dclose(dset);
+    CAROM_VERIFY(errf >= 0);
+#ifndef DEBUG_CHECK_ASSERTIONS
+    CAROM_NULL_USE(errf);
+#endif
+}
+
+void
+HDFDatabase::selectIndices(
+    hid_t space,
+    const std::vector<int>& idx,
+    hsize_t offset)
+{
+    CAROM_VERIFY(idx.size() > 0);
+    CAROM_VERIFY(idx[0] >= 0);
+
+    // Coalesce consecutive indices into ranges [starts[r], starts[r] + counts[r]).
+    std::vector<hsize_t> starts, counts;
+    for (size_t i = 0; i < idx.size(); ++i)
+    {
+        if (i > 0 && idx[i] == idx[i - 1] + 1)
+        {
+            counts.back()++;
+        }
+        else
+        {
+            CAROM_VERIFY(i == 0 || idx[i] > idx[i - 1]);
+            starts.push_back(offset + idx[i]);
+            counts.push_back(1);
+        }
+    }
+
+    // Group ranges of equal length and equal spacing into strided hyperslabs
+    // with pattern_counts[p] blocks of length pattern_blocks[p].
+    std::vector<hsize_t> pattern_starts, pattern_strides, pattern_counts,
+        pattern_blocks;
+    for (size_t r = 0; r < starts.size(); ++r)
+    {
+        if (r > 0 && counts[r] == pattern_blocks.back() &&
+                (pattern_counts.back() == 1 ||
+                 starts[r] - starts[r - 1] == pattern_strides.back()))
+        {
+            pattern_strides.back() = starts[r] - starts[r - 1];
+            pattern_counts.back()++;
+        }
+        else
+        {
+            pattern_starts.push_back(starts[r]);
+            pattern_strides.push_back(1);
+            pattern_counts.push_back(1);
+            pattern_blocks.push_back(counts[r]);
+        }
+    }
+
+    // The union of hyperslabs is formed in time quadratic in the number of
+    // hyperslabs, so irregular index sets are selected as points.
+    herr_t errf;
+    if (pattern_starts.size() <= MAX_HYPERSLAB_PATTERNS)
+    {
+        for (size_t p = 0; p < pattern_starts.size(); ++p)
+        {
+            errf = H5Sselect_hyperslab(space,
+                                       p == 0 ? H5S_SELECT_SET : H5S_SELECT_OR,
+                                       &pattern_starts[p], &pattern_strides[p],
+                                       &pattern_counts[p], &pattern_blocks[p]);
+            CAROM_VERIFY(errf >= 0);
+        }
     }
     else
     {
-        std::vector<double> alldata(nelements);
-        getDoubleArray(key, alldata.data(), nelements);
-        int k = 0;
-        for (int i = 0; i < nelements; ++i)
+        std::vector<hsize_t> coords(idx.size());
+        for (size_t i = 0; i < idx.size(); ++i)
         {
-            if (idx[k] == i)
-            {
-                data[k++] = alldata[i];
-            }
-            if (k == idx.size())
-            {
-                break;
-            }
+            coords[i] = offset + idx[i];
         }
-        CAROM_VERIFY(k == idx.size());
+        errf = H5Sselect_elements(space, H5S_SELECT_SET, idx.size(),
+                                  coords.data());
+        CAROM_VERIFY(errf >= 0);
     }
+#ifndef DEBUG_CHECK_ASSERTIONS
+    CAROM_NULL_USE(errf);
+#endif
 }
 
 void
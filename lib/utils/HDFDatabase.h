@@ -103,6 +103,30 @@ public:
         int nelements,
         const bool distributed=false);
 
+    /**
+     * @brief Writes an array of 64-bit integers associated with the supplied
+     * key to the currently open HDF5 database file.
+     *
+     * @pre !key.empty()
+     * @pre data != nullptr
+     * @pre nelements > 0
+     *
+     * @param[in] key The key associated with the array of values to be
+     *                written.
+     * @param[in] data The array of integer values to be written.
+     * @param[in] nelements The number of integers in the array.
+     * @param[in] distributed True if data is a distributed integer array.
+     *                        HDFDatabase writes the array in file-per-process,
+     *                        where each file is written serially by one process.
+     */
+    virtual
+    void
+    putInteger64Array(
+        const std::string& key,
+        const int64_t* const data,
+        int nelements,
+        const bool distributed=false);
+
     /**
      * @brief Writes an array of doubles associated with the supplied key to
      * the currently open HDF5 database file.
@@ -174,6 +198,29 @@ public:
         int nelements,
         const bool distributed=false);
 
+    /**
+     * @brief Reads an array of 64-bit integers associated with the supplied
+     * key from the currently open HDF5 database file. Arrays written as
+     * 32-bit integers are converted.
+     *
+     * @pre !key.empty()
+     *
+     * @param[in] key The key associated with the array of values to be
+     *                read.
+     * @param[out] data The allocated array of integer values to be read.
+     * @param[in] nelements The number of integers in the array.
+     * @param[in] distributed True if data is a distributed integer array.
+     *                        HDFDatabase reads the array in file-per-process,
+     *                        where each file is read serially by one process.
+     */
+    virtual
+    void
+    getInteger64Array(
+        const std::string& key,
+        int64_t* data,
+        int nelements,
+        const bool distributed=false);
+
     /**
      * @brief Count the number of elements in an array of doubles associated
      * with the supplied key from the currently open HDF5 database file.
@@ -213,14 +260,20 @@ public:
      * @brief Reads a sub-array of doubles associated with the supplied key
      * from the currently open HDF5 database file.
      *
+     * Only the indexed entries are read, selected as strided hyperslabs for
+     * regular runs of consecutive indices or as points otherwise, so the I/O
+     * and memory scale with idx.size() rather than nelements.
+     *
      * @pre !key.empty()
      * @pre data != nullptr || nelements == 0
+     * @pre idx is strictly increasing and in [0, nelements)
      *
      * @param[in] key The key associated with the array of values to be
      *                read.
      * @param[out] data The allocated sub-array of double values to be read.
      * @param[in] nelements The number of doubles in the full array.
-     * @param[in] idx The set of indices in the sub-array.
+     * @param[in] idx The set of indices in the sub-array. If empty, the
+     *                full array is read.
      * @param[in] distributed True if data is a distributed double array.
      *                        HDFDatabase reads the array in file-per-process,
      *                        where each file is read serially by one process.
@@ -317,6 +370,65 @@ protected:
     readAttribute(
         hid_t dataset_id);
 
+    /**
+     * @brief Writes an array of integers of the given memory type to a new
+     *        dataset of the given file type.
+     *
+     * @param[in] key The key associated with the array of values to be
+     *                written.
+     * @param[in] data The array of integer values to be written.
+     * @param[in] nelements The number of integers in the array.
+     * @param[in] file_type The HDF5 type of the dataset.
+     * @param[in] mem_type The HDF5 type of the entries of data.
+     */
+    void
+    writeIntegerArray(
+        const std::string& key,
+        const void* const data,
+        int nelements,
+        hid_t file_type,
+        hid_t mem_type);
+
+    /**
+     * @brief Reads an array of integers into the given memory type,
+     *        converting from the type of the dataset.
+     *
+     * @param[in] key The key associated with the array of values to be
+     *                read.
+     * @param[out] data The allocated array of integer values to be read.
+     * @param[in] nelements The number of integers in the array.
+     * @param[in] mem_type The HDF5 type of the entries of data.
+     */
+    void
+    readIntegerArray(
+        const std::string& key,
+        void* data,
+        int nelements,
+        hid_t mem_type);
+
+    /**
+     * @brief Selects the entries offset + idx[i] of a one-dimensional
+     *        dataspace.
+     *
+     * Consecutive indices are coalesced into ranges, and ranges of equal
+     * length and spacing into strided hyperslabs. If there are few
+     * hyperslabs their union is selected, otherwise the entries are selected
+     * as a point list. Either way the selected entries are in increasing
+     * order, matching a contiguous memory space of idx.size() entries.
+     *
+     * @pre idx is non-empty, strictly increasing and non-negative
+     *
+     * @param[in] space The dataspace in which to select.
+     * @param[in] idx The indices of the entries to select.
+     * @param[in] offset The offset added to each index.
+     */
+    static
+    void
+    selectIndices(
+        hid_t space,
+        const std::vector<int>& idx,
+        hsize_t offset);
+
     /**
      * @brief True if the HDF5 database is mounted to a file.
      */
@@ -147,14 +147,34 @@ HDFDatabaseMPIO::putIntegerArray_parallel(
     const std::string& key,
     const int* const data,
     int nelem_local)
+{
+    writeIntegerArray_parallel(key, data, nelem_local, H5T_NATIVE_INT);
+}
+
+void
+HDFDatabaseMPIO::putInteger64Array_parallel(
+    const std::string& key,
+    const int64_t* const data,
+    int nelem_local)
+{
+    writeIntegerArray_parallel(key, data, nelem_local, H5T_NATIVE_INT64);
+}
+
+void
+HDFDatabaseMPIO::writeIntegerArray_parallel(
+    const std::string& key,
+    const void* const data,
+    int nelem_local,
+    hid_t type)
 {
     CAROM_VERIFY(!key.empty());
     CAROM_VERIFY(data != nullptr);
     CAROM_VERIFY(nelem_local >= 0);
 
     /* determine global nelements and offsets */
-    std::vector<int> offsets;
-    int nelements = CAROM::get_global_offsets(nelem_local, offsets, d_comm);
+    std::vector<CAROM::GlobalIndex> offsets;
+    const CAROM::GlobalIndex nelements = CAROM::get_global_offsets(nelem_local,
+                                         offsets, d_comm);
     CAROM_VERIFY(nelements > 0);
 
     const int dim_rank = 1;
@@ -165,7 +185,7 @@ HDFDatabaseMPIO::putIntegerArray_parallel(
 #if (H5_VERS_MAJOR > 1) || ((H5_VERS_MAJOR == 1) && (H5_VERS_MINOR > 6))
     hid_t dataset = H5Dcreate(d_group_id,
                               key.c_str(),
-                              H5T_NATIVE_INT,
+                              type,
                               filespace,
                               H5P_DEFAULT,
                               H5P_DEFAULT,
@@ -203,7 +223,7 @@ HDFDatabaseMPIO::putIntegerArray_parallel(
     H5Pset_dxpl_mpio(plist_id, H5FD_MPIO_COLLECTIVE);
 
     herr_t errf = H5Dwrite(dataset,
-                           H5T_NATIVE_INT,
+                           type,
                            memspace,
                            filespace,
                            plist_id,
@@ -240,8 +260,9 @@ HDFDatabaseMPIO::putDoubleArray_parallel(
     CAROM_VERIFY(nelem_local >= 0);
 
     /* determine global nelements and offsets */
-    std::vector<int> offsets;
-    int nelements = CAROM::get_global_offsets(nelem_local, offsets, d_comm);
+    std::vector<CAROM::GlobalIndex> offsets;
+    const CAROM::GlobalIndex nelements = CAROM::get_global_offsets(nelem_local,
+                                         offsets, d_comm);
     CAROM_VERIFY(nelements > 0);
 
     const int dim_rank = 1;
@@ -321,11 +342,31 @@ HDFDatabaseMPIO::getIntegerArray_parallel(
     const std::string& key,
     int* data,
     int nelem_local)
+{
+    readIntegerArray_parallel(key, data, nelem_local, H5T_NATIVE_INT);
+}
+
+void
+HDFDatabaseMPIO::getInteger64Array_parallel(
+    const std::string& key,
+    int64_t* data,
+    int nelem_local)
+{
+    readIntegerArray_parallel(key, data, nelem_local, H5T_NATIVE_INT64);
+}
+
+void
+HDFDatabaseMPIO::readIntegerArray_parallel(
+    const std::string& key,
+    void* data,
+    int nelem_local,
+    hid_t type)
 {
     CAROM_VERIFY(nelem_local >= 0);
     /* determine global nelements and offsets */
-    std::vector<int> offsets;
-    int nelements = CAROM::get_global_offsets(nelem_local, offsets, d_comm);
+    std::vector<CAROM::GlobalIndex> offsets;
+    const CAROM::GlobalIndex nelements = CAROM::get_global_offsets(nelem_local,
+                                         offsets, d_comm);
     if (nelements == 0) return;
 
     CAROM_VERIFY(!key.empty());
@@ -344,7 +385,7 @@ HDFDatabaseMPIO::getIntegerArray_parallel(
     CAROM_VERIFY(filespace >= 0);
 
     hsize_t nsel = H5Sget_select_npoints(filespace);
-    CAROM_VERIFY(static_cast<int>(nsel) == nelements);
+    CAROM_VERIFY(static_cast<CAROM::GlobalIndex>(nsel) == nelements);
 
     const int dim_rank = 1;
     H5Sclose(filespace);
@@ -376,7 +417,7 @@ HDFDatabaseMPIO::getIntegerArray_parallel(
     H5Pset_dxpl_mpio(plist_id, H5FD_MPIO_COLLECTIVE);
 
     herr_t errf;
-    errf = H5Dread(dset, H5T_NATIVE_INT, memspace, filespace, plist_id, data);
+    errf = H5Dread(dset, type, memspace, filespace, plist_id, data);
     CAROM_VERIFY(errf >= 0);
 
     errf = H5Sclose(filespace);
@@ -403,8 +444,9 @@ HDFDatabaseMPIO::getDoubleArray_parallel(
 {
     CAROM_VERIFY(nelem_local >= 0);
     /* determine global nelements and offsets */
-    std::vector<int> offsets;
-    int nelements = CAROM::get_global_offsets(nelem_local, offsets, d_comm);
+    std::vector<CAROM::GlobalIndex> offsets;
+    const CAROM::GlobalIndex nelements = CAROM::get_global_offsets(nelem_local,
+                                         offsets, d_comm);
     if (nelements == 0) return;
 
     CAROM_VERIFY(!key.empty());
@@ -423,7 +465,7 @@ HDFDatabaseMPIO::getDoubleArray_parallel(
     CAROM_VERIFY(filespace >= 0);
 
     hsize_t nsel = H5Sget_select_npoints(filespace);
-    CAROM_VERIFY(static_cast<int>(nsel) == nelements);
+    CAROM_VERIFY(static_cast<CAROM::GlobalIndex>(nsel) == nelements);
 
     const int dim_rank = 1;
     H5Sclose(filespace);
@@ -481,28 +523,75 @@ HDFDatabaseMPIO::getDoubleArray_parallel(
     int nelem_local,
     const std::vector<int>& idx_local)
 {
-    std::vector<int> idx_tmp = idx_local;
-    if (idx_local.size() == 0)
-    {
-        for (int i = 0; i < nelem_local; i++)
-            idx_tmp.push_back(i);
-    }
+    CAROM_VERIFY(nelem_local >= 0);
+    CAROM_VERIFY(idx_local.size() == 0 || idx_local.back() < nelem_local);
+    /* determine global nelements and offsets */
+    std::vector<CAROM::GlobalIndex> global_offsets;
+    const CAROM::GlobalIndex nelements = CAROM::get_global_offsets(nelem_local,
+                                         global_offsets, d_comm);
 
-    std::vector<double> alldata(nelem_local);
-    getDoubleArray_parallel(key, alldata.data(), nelem_local);
-    int k = 0;
-    for (int i = 0; i < nelem_local; ++i)
-    {
-        if (idx_tmp[k] == i)
-        {
-            data[k++] = alldata[i];
-        }
-        if (k == idx_tmp.size())
-        {
-            break;
-        }
+    CAROM_VERIFY(!key.empty());
+#ifndef DEBUG_CHECK_ASSERTIONS
+    CAROM_NULL_USE(nelements);
+#endif
+
+#if (H5_VERS_MAJOR > 1) || ((H5_VERS_MAJOR == 1) && (H5_VERS_MINOR > 6))
+    hid_t dset = H5Dopen(d_group_id, key.c_str(), H5P_DEFAULT);
+#else
+    hid_t dset = H5Dopen(d_group_id, key.c_str());
+#endif
+    CAROM_VERIFY(dset >= 0);
+
+    hid_t filespace = H5Dget_space(dset);
+    CAROM_VERIFY(filespace >= 0);
+
+    hsize_t nsel = H5Sget_select_npoints(filespace);
+    CAROM_VERIFY(nsel == static_cast<hsize_t>(nelements));
+
+    herr_t errf;
+    if (nsel > 0) {
+        /*
+         * Each process selects only its indexed entries in the file, shifted
+         * by its offset, or all of its entries if idx_local is empty.
+         */
+        const hsize_t num_read = (idx_local.size() > 0) ? idx_local.size() :
+                                 nelem_local;
+        hsize_t buffer_array_size[1] = {num_read};
+        hid_t memspace = H5Screate_simple(1, buffer_array_size, NULL);
+
+        hsize_t offset[1] = {(hsize_t) global_offsets[d_rank]};
+        if (idx_local.size() > 0)
+            selectIndices(filespace, idx_local, offset[0]);
+        else if (nelem_local > 0)
+            H5Sselect_hyperslab(filespace, H5S_SELECT_SET, offset, NULL,
+                                buffer_array_size, NULL);
+        else
+            H5Sselect_none(filespace);
+
+        /*
+         * Create property list for collective dataset read.
+         */
+        hid_t plist_id = H5Pcreate(H5P_DATASET_XFER);
+        H5Pset_dxpl_mpio(plist_id, H5FD_MPIO_COLLECTIVE);
+
+        errf = H5Dread(dset, H5T_NATIVE_DOUBLE, memspace, filespace, plist_id, data);
+        CAROM_VERIFY(errf >= 0);
+
+        errf = H5Sclose(memspace);
+        CAROM_VERIFY(errf >= 0);
+
+        errf = H5Pclose(plist_id);
+        CAROM_VERIFY(errf >= 0);
     }
-    CAROM_VERIFY(k == idx_tmp.size());
+
+    errf = H5Sclose(filespace);
+    CAROM_VERIFY(errf >= 0);
+
+    errf = H5Dclose(dset);
+    CAROM_VERIFY(errf >= 0);
+#ifndef DEBUG_CHECK_ASSERTIONS
+    CAROM_NULL_USE(errf);
+#endif
 }
 
 void
@@ -522,9 +611,9 @@ HDFDatabaseMPIO::getDoubleArray_parallel(
     CAROM_VERIFY(block_offset_global + block_size_global <= stride_global);
     /* determine global nelements and offsets */
     hsize_t num_local_blocks = nelem_local / block_size_global;
-    std::vector<int> global_offsets;
-    int nelements = CAROM::get_global_offsets(num_local_blocks * stride_global,
-                    global_offsets, d_comm);
+    std::vector<CAROM::GlobalIndex> global_offsets;
+    const CAROM::GlobalIndex nelements = CAROM::get_global_offsets(
+            num_local_blocks * stride_global, global_offsets, d_comm);
 
     CAROM_VERIFY(!key.empty());
 #ifndef DEBUG_CHECK_ASSERTIONS
@@ -542,7 +631,7 @@ HDFDatabaseMPIO::getDoubleArray_parallel(
     CAROM_VERIFY(filespace >= 0);
 
     hsize_t nsel = H5Sget_select_npoints(filespace);
-    CAROM_VERIFY((nsel == 0) || (nsel == nelements));
+    CAROM_VERIFY((nsel == 0) || (nsel == static_cast<hsize_t>(nelements)));
 
     const int dim_rank = 1;
     H5Sclose(filespace);
@@ -97,6 +97,34 @@ public:
         putIntegerArray_parallel(key, data, nelements);
     }
 
+    /**
+     * @brief Writes an array of 64-bit integers in the root rank
+     *        associated with the supplied key to
+     *        the currently open HDF5 database file.
+     *
+     * @pre !key.empty()
+     * @pre data != nullptr
+     * @pre nelements > 0
+     *
+     * @param[in] key The key associated with the array of values to be
+     *                written.
+     * @param[in] data The array of integer values to be written.
+     * @param[in] nelements The number of integers in the array.
+     * @param[in] distributed If true, distributed integer array will be written.
+     *                        If not, only the root process writes its integer array.
+     */
+    void
+    putInteger64Array(
+        const std::string& key,
+        const int64_t* const data,
+        int nelements,
+        const bool distributed=false) override
+    {
+        if ((!distributed) && (d_rank != 0))
+            nelements = 0;
+        putInteger64Array_parallel(key, data, nelements);
+    }
+
     /**
      * @brief Writes an array of doubles in the root rank
      *        associated with the supplied key to
@@ -160,6 +188,41 @@ public:
         MPI_Bcast(data, nelements, MPI_INT, 0, d_comm);
     }
 
+    /**
+     * @brief Reads an array of 64-bit integers associated with the supplied
+     * key from the currently open HDF5 database file.
+     * All processes share the same non-distributed integer array.
+     *
+     * @pre !key.empty()
+     * @pre data != nullptr || nelements == 0
+     *
+     * @param[in] key The key associated with the array of values to be
+     *                read.
+     * @param[out] data The allocated array of integer values to be read.
+     * @param[in] nelements The number of integers in the array.
+     * @param[in] distributed If true, the integer array will be read in a distributed way.
+     *                        If not, the root process reads the entire array and broadcast to all processes.
+     */
+    void
+    getInteger64Array(
+        const std::string& key,
+        int64_t* data,
+        int nelements,
+        const bool distributed=false) override
+    {
+        if (distributed)
+        {
+            getInteger64Array_parallel(key, data, nelements);
+            return;
+        }
+
+        int read_size = (d_rank == 0) ? nelements : 0;
+        getInteger64Array_parallel(key, data, read_size);
+
+        CAROM_VERIFY(d_comm != MPI_COMM_NULL);
+        MPI_Bcast(data, nelements, MPI_INT64_T, 0, d_comm);
+    }
+
     /**
      * @brief Reads an array of doubles associated with the supplied key
      * from the currently open HDF5 database file.
@@ -209,7 +272,8 @@ public:
      * @param[in] nelements The number of doubles in the full array.
      * @param[in] idx The set of indices in the sub-array.
      * @param[in] distributed If true, the double array will be read in a distributed way.
-     *                        If not, the root process reads the entire array and broadcast to all processes.
+     *                        If not, the root process reads the indexed entries and
+     *                        broadcasts them to all processes.
      */
     void
     getDoubleArray(
@@ -225,11 +289,15 @@ public:
             return;
         }
 
+        // The root process reads the indexed entries; the others read none,
+        // i.e. all of their zero entries.
         int read_size = (d_rank == 0) ? nelements : 0;
-        getDoubleArray_parallel(key, data, read_size, idx);
+        getDoubleArray_parallel(key, data, read_size,
+                                (d_rank == 0) ? idx : std::vector<int>());
 
         CAROM_VERIFY(d_comm != MPI_COMM_NULL);
-        MPI_Bcast(data, nelements, MPI_DOUBLE, 0, d_comm);
+        const int num_read = (idx.size() > 0) ? idx.size() : nelements;
+        MPI_Bcast(data, num_read, MPI_DOUBLE, 0, d_comm);
     }
 
     /**
@@ -282,6 +350,28 @@ private:
     MPI_Comm d_comm;
     int d_rank;
 
+    /**
+     * @brief Writes a distributed array of integers of the given HDF5 type,
+     *        which is also the type of the new dataset.
+     */
+    void
+    writeIntegerArray_parallel(
+        const std::string& key,
+        const void* const data,
+        int nelem_local,
+        hid_t type);
+
+    /**
+     * @brief Reads a distributed array of integers into the given HDF5
+     *        type, converting from the type of the dataset.
+     */
+    void
+    readIntegerArray_parallel(
+        const std::string& key,
+        void* data,
+        int nelem_local,
+        hid_t type);
+
     /**
      * @brief Writes a distributed array of integers
      *        associated with the supplied key
@@ -304,6 +394,28 @@ private:
         const int* const data,
         int nelem_local);
 
+    /**
+     * @brief Writes a distributed array of 64-bit integers
+     *        associated with the supplied key
+     *        to the currently open HDF5 database file.
+     *
+     * @pre !key.empty()
+     * @pre data != nullptr
+     * @pre nelem_local >= 0
+     * @pre nelements > 0
+     *
+     * @param[in] key The key associated with the array of values to be
+     *                written.
+     * @param[in] data The array of integer values to be written.
+     * @param[in] nelem_local The local number of integers in the array.
+     */
+    virtual
+    void
+    putInteger64Array_parallel(
+        const std::string& key,
+        const int64_t* const data,
+        int nelem_local);
+
     /**
      * @brief Writes a distributed array of doubles
      *        associated with the supplied key to
@@ -346,6 +458,26 @@ private:
         int* data,
         int nelem_local);
 
+    /**
+     * @brief Reads a distributed array of 64-bit integers
+     *        associated with the supplied key
+     *        from the currently open HDF5 database file.
+     *
+     * @pre !key.empty()
+     * @pre data != nullptr || nelements == 0
+     *
+     * @param[in] key The key associated with the array of values to be
+     *                read.
+     * @param[out] data The allocated array of integer values to be read.
+     * @param[in] nelem_local The local number of integers in the array.
+     */
+    virtual
+    void
+    getInteger64Array_parallel(
+        const std::string& key,
+        int64_t* data,
+        int nelem_local);
+
     /**
      * @brief Reads a distributed array of doubles
      * associated with the supplied key
@@ -370,15 +502,18 @@ private:
      * @brief Reads a distributed sub-array of doubles
      * associated with the supplied key
      * from the currently open HDF5 database file.
+     * Each process reads only its indexed entries, with a collective read.
      *
      * @pre !key.empty()
      * @pre data != nullptr || nelements == 0
+     * @pre idx_local is strictly increasing and in [0, nelem_local)
      *
      * @param[in] key The key associated with the array of values to be
      *                read.
      * @param[out] data The allocated sub-array of double values to be read.
-     * @param[in] nelem_local The number of doubles in the full array.
-     * @param[in] idx_local The set of indices in the sub-array.
+     * @param[in] nelem_local The number of doubles in the local array.
+     * @param[in] idx_local The set of local indices in the sub-array. If
+     *                      empty, all local entries are read.
      */
     virtual
     void
@@ -0,0 +1,233 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2013-2024, Lawrence Livermore National Security, LLC
+ * and other libROM project developers. See the top-level COPYRIGHT
+ * file for details.
+ *
+ * SPDX-License-Identifier: (Apache-2.0 OR MIT)
+ *
+ *****************************************************************************/
+
+// Description: Reproducible synthetic distributed snapshot matrices.
+
+#include "SyntheticSnapshots.h"
+#include "mpi_utils.h"
+#include "Utilities.h"
+#include "linalg/Matrix.h"
+
+#include <cmath>
+
+namespace CAROM {
+
+namespace {
+
+// Streams of independent random numbers.
+const uint64_t spatial_stream = 0;
+const uint64_t temporal_stream = 1;
+const uint64_t noise_stream = 2;
+
+const double two_pi = 6.283185307179586;
+
+uint64_t
+splitmix64(uint64_t x)
+{
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// Adds the noise to the local rows of the snapshot matrix, indexed by the
+// global row and column.
+void
+addNoise(Matrix* snapshots, double noise_level, uint64_t seed)
+{
+    if (noise_level == 0.0) return;
+
+    std::vector<GlobalIndex> row_offsets;
+    get_global_offsets(snapshots->numRows(), row_offsets, MPI_COMM_WORLD);
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    const int num_samples = snapshots->numColumns();
+    for (int i = 0; i < snapshots->numRows(); ++i)
+    {
+        const uint64_t row = row_offsets[rank] + i;
+        for (int j = 0; j < num_samples; ++j)
+        {
+            snapshots->item(i, j) += noise_level *
+                                     counter_normal(seed, noise_stream, row * num_samples + j);
+        }
+    }
+}
+
+}
+
+double
+counter_uniform(uint64_t seed, uint64_t stream, uint64_t counter)
+{
+    const uint64_t key = splitmix64(splitmix64(seed) ^ splitmix64(stream +
+                                    0xD1B54A32D192ED03ULL));
+    const uint64_t bits = splitmix64(key ^ splitmix64(counter));
+
+    // The top 53 bits, shifted by half a unit to exclude 0 and 1.
+    return ((bits >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+double
+counter_normal(uint64_t seed, uint64_t stream, uint64_t counter)
+{
+    const double u1 = counter_uniform(seed, stream, 2 * counter);
+    const double u2 = counter_uniform(seed, stream, 2 * counter + 1);
+    return std::sqrt(-2.0 * std::log(u1)) * std::cos(two_pi * u2);
+}
+
+std::vector<double>
+geometric_singular_values(int rank, double decay)
+{
+    CAROM_VERIFY(rank > 0);
+    CAROM_VERIFY(decay > 0.0 && decay <= 1.0);
+
+    std::vector<double> sv(rank);
+    sv[0] = 1.0;
+    for (int i = 1; i < rank; ++i)
+        sv[i] = sv[i - 1] * decay;
+    return sv;
+}
+
+Matrix*
+synthetic_spatial_modes(int dim, int num_modes, uint64_t seed)
+{
+    CAROM_VERIFY(dim > 0);
+    CAROM_VERIFY(num_modes > 0);
+
+    std::vector<GlobalIndex> row_offsets;
+    const GlobalIndex global_dim = get_global_offsets(dim, row_offsets,
+                                   MPI_COMM_WORLD);
+    CAROM_VERIFY(num_modes <= global_dim);
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    Matrix* modes = new Matrix(dim, num_modes, true);
+    for (int i = 0; i < dim; ++i)
+    {
+        const uint64_t row = row_offsets[rank] + i;
+        for (int k = 0; k < num_modes; ++k)
+            modes->item(i, k) = counter_normal(seed, spatial_stream,
+                                               row * num_modes + k);
+    }
+    modes->orthogonalize(true);
+    return modes;
+}
+
+Matrix*
+synthetic_low_rank_snapshots(int dim,
+                             int num_samples,
+                             const std::vector<double>& sv,
+                             double noise_level,
+                             uint64_t seed)
+{
+    CAROM_VERIFY(dim > 0);
+    CAROM_VERIFY(static_cast<int>(sv.size()) <= num_samples);
+    CAROM_VERIFY(noise_level >= 0.0);
+
+    const int r = sv.size();
+    Matrix* snapshots = new Matrix(dim, num_samples, true);
+    if (r > 0)
+    {
+        Matrix* U = synthetic_spatial_modes(dim, r, seed);
+
+        // The temporal modes are the same on every processor.
+        Matrix V(num_samples, r, false);
+        for (int j = 0; j < num_samples; ++j)
+            for (int k = 0; k < r; ++k)
+                V(j, k) = counter_normal(seed, temporal_stream,
+                                         static_cast<uint64_t>(j) * r + k);
+        V.orthogonalize(true);
+
+        for (int i = 0; i < dim; ++i)
+        {
+            for (int j = 0; j < num_samples; ++j)
+            {
+                double sum = 0.0;
+                for (int k = 0; k < r; ++k)
+                    sum += U->item(i, k) * sv[k] * V(j, k);
+                snapshots->item(i, j) = sum;
+            }
+        }
+        delete U;
+    }
+    else
+    {
+        *snapshots = 0.0;
+    }
+
+    addNoise(snapshots, noise_level, seed);
+    return snapshots;
+}
+
+Matrix*
+synthetic_dmd_snapshots(int dim,
+                        int num_samples,
+                        const std::vector<std::complex<double>>& eigs,
+                        double noise_level,
+                        uint64_t seed)
+{
+    CAROM_VERIFY(dim > 0);
+    CAROM_VERIFY(num_samples > 0);
+    CAROM_VERIFY(noise_level >= 0.0);
+
+    int num_modes = 0;
+    for (size_t k = 0; k < eigs.size(); ++k)
+    {
+        CAROM_VERIFY(eigs[k].imag() >= 0.0);
+        num_modes += eigs[k].imag() > 0.0 ? 2 : 1;
+    }
+
+    Matrix* snapshots = new Matrix(dim, num_samples, true);
+    *snapshots = 0.0;
+    if (num_modes > 0)
+    {
+        Matrix* modes = synthetic_spatial_modes(dim, num_modes, seed);
+
+        // Temporal coefficients of each mode, the same on every processor.
+        Matrix coeffs(num_samples, num_modes, false);
+        int mode = 0;
+        for (size_t k = 0; k < eigs.size(); ++k)
+        {
+            const double rho = std::abs(eigs[k]);
+            const double theta = std::arg(eigs[k]);
+            for (int j = 0; j < num_samples; ++j)
+            {
+                const double amplitude = std::pow(rho, j);
+                if (eigs[k].imag() > 0.0)
+                {
+                    coeffs(j, mode) = amplitude * std::cos(j * theta);
+                    coeffs(j, mode + 1) = -amplitude * std::sin(j * theta);
+                }
+                else
+                {
+                    coeffs(j, mode) = std::pow(eigs[k].real(), j);
+                }
+            }
+            mode += eigs[k].imag() > 0.0 ? 2 : 1;
+        }
+
+        for (int i = 0; i < dim; ++i)
+        {
+            for (int j = 0; j < num_samples; ++j)
+            {
+                double sum = 0.0;
+                for (int k = 0; k < num_modes; ++k)
+                    sum += modes->item(i, k) * coeffs(j, k);
+                snapshots->item(i, j) = sum;
+            }
+        }
+        delete modes;
+    }
+
+    addNoise(snapshots, noise_level, seed);
+    return snapshots;
+}
+
+}
@@ -0,0 +1,146 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2013-2024, Lawrence Livermore National Security, LLC
+ * and other libROM project developers. See the top-level COPYRIGHT
+ * file for details.
+ *
+ * SPDX-License-Identifier: (Apache-2.0 OR MIT)
+ *
+ *****************************************************************************/
+
+// Description: Reproducible synthetic distributed snapshot matrices with
+//              prescribed singular values or DMD eigenvalues, for benchmarks
+//              and accuracy tests.
+
+#ifndef included_SyntheticSnapshots_h
+#define included_SyntheticSnapshots_h
+
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+namespace CAROM {
+
+class Matrix;
+
+/**
+ * @brief Returns a uniform random number in (0, 1) that depends only on the
+ *        seed, the stream and the counter.
+ *
+ * The number is the SplitMix64 finalizer of a key combining the three
+ * arguments, so any entry of a random sequence is computed directly, without
+ * generating the preceding ones.
+ *
+ * @param[in] seed    The random seed.
+ * @param[in] stream  The index of the independent sequence.
+ * @param[in] counter The position in the sequence.
+ */
+double
+counter_uniform(uint64_t seed, uint64_t stream, uint64_t counter);
+
+/**
+ * @brief Returns a standard normal random number that depends only on the
+ *        seed, the stream and the counter, by the Box-Muller transform of
+ *        two counter_uniform numbers.
+ *
+ * @param[in] seed    The random seed.
+ * @param[in] stream  The index of the independent sequence.
+ * @param[in] counter The position in the sequence.
+ */
+double
+counter_normal(uint64_t seed, uint64_t stream, uint64_t counter);
+
+/**
+ * @brief Returns the singular values sv_i = decay^i, i = 0, ..., rank - 1.
+ *
+ * @pre rank > 0
+ * @pre 0 < decay <= 1
+ */
+std::vector<double>
+geometric_singular_values(int rank, double decay);
+
+/**
+ * @brief Generates distributed orthonormal spatial modes. Collective.
+ *
+ * The modes are the orthonormalized columns of a Gaussian matrix whose
+ * entries are indexed by their global row, so every processor generates
+ * its rows in O(dim * num_modes) and the modes do not depend on the
+ * decomposition beyond rounding.
+ *
+ * @pre dim > 0
+ * @pre 0 < num_modes <= global dimension
+ *
+ * @param[in] dim       The local number of rows.
+ * @param[in] num_modes The number of modes.
+ * @param[in] seed      The random seed.
+ *
+ * @return The distributed dim x num_modes matrix of modes, owned by the
+ *         caller.
+ */
+Matrix*
+synthetic_spatial_modes(int dim, int num_modes, uint64_t seed = 1);
+
+/**
+ * @brief Generates a distributed snapshot matrix U diag(sv) V^T + E with the
+ *        prescribed singular values. Collective.
+ *
+ * U is given by synthetic_spatial_modes, V has random orthonormal columns
+ * and E has independent normal entries of standard deviation noise_level,
+ * indexed by their global row and column. Without noise the singular values
+ * of the snapshot matrix are exactly sv.
+ *
+ * @pre dim > 0
+ * @pre sv.size() <= num_samples
+ * @pre noise_level >= 0
+ *
+ * @param[in] dim         The local number of rows.
+ * @param[in] num_samples The number of snapshots (columns).
+ * @param[in] sv          The singular values, possibly empty.
+ * @param[in] noise_level The standard deviation of the noise.
+ * @param[in] seed        The random seed.
+ *
+ * @return The distributed dim x num_samples snapshot matrix, owned by the
+ *         caller.
+ */
+Matrix*
+synthetic_low_rank_snapshots(int dim,
+                             int num_samples,
+                             const std::vector<double>& sv,
+                             double noise_level = 0.0,
+                             uint64_t seed = 1);
+
+/**
+ * @brief Generates distributed snapshots x_j = A^j x_0 of a linear system
+ *        with the prescribed DMD eigenvalues, plus noise. Collective.
+ *
+ * A real eigenvalue lambda contributes u lambda^j with one spatial mode u.
+ * An eigenvalue rho e^{i theta} with theta > 0 also contributes its
+ * conjugate, through rho^j (u cos(j theta) - w sin(j theta)) with two
+ * spatial modes u and w. The modes are given by synthetic_spatial_modes, so
+ * the noise-free snapshots are exactly those of a linear system whose
+ * nonzero eigenvalues are eigs and their conjugates. The noise is as in
+ * synthetic_low_rank_snapshots.
+ *
+ * @pre dim > 0
+ * @pre No eigenvalue has a negative imaginary part.
+ * @pre noise_level >= 0
+ *
+ * @param[in] dim         The local number of rows.
+ * @param[in] num_samples The number of snapshots (columns), x_0 first.
+ * @param[in] eigs        The eigenvalues with nonnegative imaginary part.
+ * @param[in] noise_level The standard deviation of the noise.
+ * @param[in] seed        The random seed.
+ *
+ * @return The distributed dim x num_samples snapshot matrix, owned by the
+ *         caller.
+ */
+Matrix*
+synthetic_dmd_snapshots(int dim,
+                        int num_samples,
+                        const std::vector<std::complex<double>>& eigs,
+                        double noise_level = 0.0,
+                        uint64_t seed = 1);
+
+}
+
+#endif
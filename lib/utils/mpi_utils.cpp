@@ -13,6 +13,7 @@
 #include "mpi_utils.h"
 #include "Utilities.h"
 
+#include <climits>
 #include <iomanip>
 #include <stdlib.h>
 #include <sys/stat.h>
@@ -20,7 +21,7 @@
 namespace CAROM {
 
 int
-split_dimension(const int dim, const MPI_Comm &comm)
+split_dimension(const GlobalIndex dim, const MPI_Comm &comm)
 {
     int mpi_init;
     MPI_Initialized(&mpi_init);
@@ -30,15 +31,16 @@ split_dimension(const int dim, const MPI_Comm &comm)
     MPI_Comm_rank(comm, &d_rank);
     MPI_Comm_size(comm, &d_num_procs);
 
-    int local_dim = dim / d_num_procs;
+    GlobalIndex local_dim = dim / d_num_procs;
     if (dim % d_num_procs > d_rank)
         local_dim++;
+    CAROM_VERIFY(local_dim <= INT_MAX);
 
-    return local_dim;
+    return static_cast<int>(local_dim);
 }
 
-int
-get_global_offsets(const int local_dim, std::vector<int> &offsets,
+GlobalIndex
+get_global_offsets(const int local_dim, std::vector<GlobalIndex> &offsets,
                    const MPI_Comm &comm)
 {
     int mpi_init;
@@ -51,11 +53,11 @@ get_global_offsets(const int local_dim, std::vector<int> &offsets,
 
     offsets.resize(d_num_procs + 1);
     offsets[d_rank] = local_dim;
-    CAROM_VERIFY(MPI_Allgather(MPI_IN_PLACE, 1, MPI_INT,
-                               &offsets[0], 1, MPI_INT,
+    CAROM_VERIFY(MPI_Allgather(MPI_IN_PLACE, 1, CAROM_MPI_GLOBAL_INDEX,
+                               &offsets[0], 1, CAROM_MPI_GLOBAL_INDEX,
                                comm) == MPI_SUCCESS);
 
-    int dim = 0;
+    GlobalIndex dim = 0;
     for (int i = 0; i < d_num_procs; i++)
         dim += offsets[i];
     offsets[d_num_procs] = dim;
@@ -68,6 +70,19 @@ get_global_offsets(const int local_dim, std::vector<int> &offsets,
     return dim;
 }
 
+int
+get_global_offsets(const int local_dim, std::vector<int> &offsets,
+                   const MPI_Comm &comm)
+{
+    std::vector<GlobalIndex> global_offsets;
+    const GlobalIndex dim = get_global_offsets(local_dim, global_offsets, comm);
+    CAROM_VERIFY(dim <= INT_MAX);
+
+    offsets.assign(global_offsets.begin(), global_offsets.end());
+
+    return static_cast<int>(dim);
+}
+
 bool
 is_same(int x, const MPI_Comm &comm) {
     int p[2] = {-x, x};
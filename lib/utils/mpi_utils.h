@@ -15,19 +15,34 @@
 
 #include "CAROM_config.h"
 #include "mpi.h"
+#include <cstdint>
 #include <vector>
 
 namespace CAROM {
 
+/**
+ * @brief Integer type of global dimensions, offsets and row indices of
+ *        distributed objects. These may exceed the range of int even though
+ *        the local dimensions, and hence the local storage, do not.
+ */
+typedef int64_t GlobalIndex;
+
+/**
+ * @brief The MPI datatype of GlobalIndex.
+ */
+#define CAROM_MPI_GLOBAL_INDEX MPI_INT64_T
+
 /**
  * @brief Distribute the global size dim into MPI processes as equally as possible.
  *
+ * @pre The local size fits in an int.
+ *
  * @param[in] dim          Input global size.
  * @param[in] comm         MPI communicator. default value MPI_COMM_WORLD.
  * @param[out] local_dim   (Returned value) Local size assigned to the current MPI process.
  */
 int
-split_dimension(const int dim, const MPI_Comm &comm=MPI_COMM_WORLD);
+split_dimension(const GlobalIndex dim, const MPI_Comm &comm=MPI_COMM_WORLD);
 
 /**
  * @brief Save integer offsets for each MPI rank under MPI communicator comm,
@@ -39,6 +54,16 @@ split_dimension(const int dim, const MPI_Comm &comm=MPI_COMM_WORLD);
  * @param[in] comm          MPI communicator. default value MPI_COMM_WORLD.
  * @param[out] dim          (Returned value) Global dimension as the sum of all local_dim.
  */
+GlobalIndex
+get_global_offsets(const int local_dim, std::vector<GlobalIndex> &offsets,
+                   const MPI_Comm &comm=MPI_COMM_WORLD);
+
+/**
+ * @brief As above, with int offsets for callers whose global dimension is
+ *        known to fit in an int, e.g. to pass to MPI or ScaLAPACK.
+ *
+ * @pre The global dimension fits in an int.
+ */
 int
 get_global_offsets(const int local_dim, std::vector<int> &offsets,
                    const MPI_Comm &comm=MPI_COMM_WORLD);
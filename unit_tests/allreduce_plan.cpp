@@ -0,0 +1,83 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2013-2024, Lawrence Livermore National Security, LLC
+ * and other libROM project developers. See the top-level COPYRIGHT
+ * file for details.
+ *
+ * SPDX-License-Identifier: (Apache-2.0 OR MIT)
+ *
+ *****************************************************************************/
+
+// Description: A benchmark of the per-call latency of small repeated
+//              reductions, as in the reduced-space projections and NNLS
+//              iterations, with MPI_Allreduce and with an AllreducePlan. The
+//              plans are persistent collectives only when libROM is
+//              configured with USE_PERSISTENT_COLLECTIVES; otherwise both
+//              columns time MPI_Allreduce. Run at the rank counts of
+//              interest. The optional arguments are the number of
+//              repetitions and the largest count.
+
+#include "utils/AllreducePlan.h"
+
+#include "mpi.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+namespace {
+
+// The mean time per call in microseconds, the maximum over the processors.
+double
+microseconds(double t_start, int num_reps)
+{
+    double us = (MPI_Wtime() - t_start) / num_reps * 1.0e6;
+    MPI_Allreduce(MPI_IN_PLACE, &us, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    return us;
+}
+
+}
+
+int
+main(
+    int argc,
+    char* argv[])
+{
+    MPI_Init(&argc, &argv);
+    int rank, num_procs;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+
+    const int num_reps = argc > 1 ? atoi(argv[1]) : 10000;
+    const int max_count = argc > 2 ? atoi(argv[2]) : 1024;
+
+    if (rank == 0) {
+        printf("%d processes, %d repetitions\n", num_procs, num_reps);
+    }
+    for (int count = 1; count <= max_count; count *= 4) {
+        std::vector<double> data(count, 1.0);
+        CAROM::AllreducePlan plan(count, MPI_DOUBLE, MPI_SUM);
+
+        MPI_Barrier(MPI_COMM_WORLD);
+        double t_start = MPI_Wtime();
+        for (int n = 0; n < num_reps; ++n)
+            MPI_Allreduce(MPI_IN_PLACE, data.data(), count, MPI_DOUBLE, MPI_SUM,
+                          MPI_COMM_WORLD);
+        const double allreduce_us = microseconds(t_start, num_reps);
+
+        MPI_Barrier(MPI_COMM_WORLD);
+        t_start = MPI_Wtime();
+        for (int n = 0; n < num_reps; ++n)
+            plan.allreduce(data.data());
+        const double plan_us = microseconds(t_start, num_reps);
+
+        if (rank == 0) {
+            printf("count %5d: MPI_Allreduce %8.2f us, %s plan %8.2f us\n",
+                   count, allreduce_us,
+                   plan.persistent() ? "persistent" : "fallback", plan_us);
+        }
+    }
+
+    MPI_Finalize();
+    return 0;
+}
@@ -0,0 +1,118 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2013-2024, Lawrence Livermore National Security, LLC
+ * and other libROM project developers. See the top-level COPYRIGHT
+ * file for details.
+ *
+ * SPDX-License-Identifier: (Apache-2.0 OR MIT)
+ *
+ *****************************************************************************/
+
+// Description: A benchmark of the NUMA placement of large Matrix storage. The
+//              same row-partitioned threaded mat-vec is timed on a basis
+//              whose pages were first touched by one thread and on a basis
+//              allocated by Matrix::setSize, which initializes large arrays
+//              with all OpenMP threads when libROM is built with USE_OPENMP.
+//              Run with one rank per node or socket and, e.g.,
+//              OMP_PROC_BIND=spread OMP_PLACES=cores. The optional arguments
+//              are the number of local rows, the number of columns and the
+//              number of repetitions.
+
+#include "linalg/Matrix.h"
+#include "utils/FirstTouch.h"
+
+#include "mpi.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+namespace {
+
+// y = A x with the rows split over the threads by a static schedule, the
+// partitioning of the parallel first touch.
+void
+rowPartitionedMult(const CAROM::Matrix& A, const double* x, double* y)
+{
+    const int num_rows = A.numRows();
+    const int num_cols = A.numColumns();
+    const double* a = A.getData();
+#if CAROM_HAVE_OPENMP
+    #pragma omp parallel for schedule(static)
+#endif
+    for (int i = 0; i < num_rows; ++i) {
+        double sum = 0.0;
+        const double* row = a + static_cast<size_t>(i) * num_cols;
+        for (int j = 0; j < num_cols; ++j)
+            sum += row[j] * x[j];
+        y[i] = sum;
+    }
+}
+
+// The bandwidth in GB/s of the mat-vec, the minimum over the processors.
+double
+bandwidth(const CAROM::Matrix& A, int num_reps)
+{
+    std::vector<double> x(A.numColumns(), 1.0), y(A.numRows());
+    rowPartitionedMult(A, x.data(), y.data());
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    const double t_start = MPI_Wtime();
+    for (int n = 0; n < num_reps; ++n)
+        rowPartitionedMult(A, x.data(), y.data());
+    double gbs = 8.0 * A.numRows() * A.numColumns() * num_reps /
+                 (MPI_Wtime() - t_start) / 1.0e9;
+    MPI_Allreduce(MPI_IN_PLACE, &gbs, 1, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD);
+    return gbs;
+}
+
+}
+
+int
+main(
+    int argc,
+    char* argv[])
+{
+    MPI_Init(&argc, &argv);
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    const int num_rows = argc > 1 ? atoi(argv[1]) : 2000000;
+    const int num_cols = argc > 2 ? atoi(argv[2]) : 32;
+    const int num_reps = argc > 3 ? atoi(argv[3]) : 20;
+    const size_t size = static_cast<size_t>(num_rows) * num_cols;
+
+    // Storage first touched by this thread only, as before parallel
+    // initialization was added.
+    double* serial_data = new double [size];
+    memset(serial_data, 0, size * sizeof(double));
+    CAROM::Matrix serial_basis(serial_data, num_rows, num_cols, true, false);
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    double t_start = MPI_Wtime();
+    CAROM::Matrix basis(num_rows, num_cols, true);
+    double alloc_time = MPI_Wtime() - t_start;
+    MPI_Allreduce(MPI_IN_PLACE, &alloc_time, 1, MPI_DOUBLE, MPI_MAX,
+                  MPI_COMM_WORLD);
+    for (size_t n = 0; n < size; ++n) {
+        serial_data[n] = 1.0 / (1.0 + n % 97);
+        basis.getData()[n] = serial_data[n];
+    }
+
+    const double serial_gbs = bandwidth(serial_basis, num_reps);
+    const double first_touch_gbs = bandwidth(basis, num_reps);
+    if (rank == 0) {
+        printf("Local matrix %d x %d, %d threads\n", num_rows, num_cols,
+               CAROM::first_touch_num_threads());
+        printf("Matrix allocation time = %f s\n", alloc_time);
+        printf("Mat-vec bandwidth, serial first touch   = %.2f GB/s\n",
+               serial_gbs);
+        printf("Mat-vec bandwidth, parallel first touch = %.2f GB/s\n",
+               first_touch_gbs);
+    }
+
+    delete [] serial_data;
+    MPI_Finalize();
+    return 0;
+}
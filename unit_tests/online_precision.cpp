@@ -0,0 +1,168 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2013-2024, Lawrence Livermore National Security, LLC
+ * and other libROM project developers. See the top-level COPYRIGHT
+ * file for details.
+ *
+ * SPDX-License-Identifier: (Apache-2.0 OR MIT)
+ *
+ *****************************************************************************/
+
+// Description: Reports the accuracy and run time of the online stage in single
+//              and double precision: DMD predictions and the lift and restrict
+//              of reduced coordinates with a distributed basis. The optional
+//              arguments are the local dimension, the number of modes and the
+//              number of repetitions.
+
+#include "algo/DMD.h"
+#include "algo/DMDPredictor.h"
+#include "linalg/Matrix.h"
+#include "linalg/OnlineLinearAlgebra.h"
+#include "linalg/Vector.h"
+#include "utils/SyntheticSnapshots.h"
+
+#include "mpi.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+namespace {
+
+// The relative 2-norm difference between an online vector and a Vector.
+template <class Scalar>
+double relativeError(const CAROM::OnlineVector<Scalar>& x,
+                     const CAROM::Vector& reference)
+{
+    double diff = 0.0;
+    for (int i = 0; i < reference.dim(); ++i)
+        diff += std::pow(x(i) - reference(i), 2);
+    MPI_Allreduce(MPI_IN_PLACE, &diff, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    return std::sqrt(diff) / reference.norm();
+}
+
+// The maximum over the processors of the average time of one repetition.
+double maxTime(double t_start, int num_reps)
+{
+    double t = (MPI_Wtime() - t_start) / num_reps;
+    MPI_Allreduce(MPI_IN_PLACE, &t, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    return t;
+}
+
+template <class Scalar>
+void
+report(const char* name,
+       CAROM::DMD& dmd,
+       const CAROM::Matrix& basis,
+       const CAROM::Vector& reduced,
+       int num_reps,
+       int rank)
+{
+    CAROM::DMDPredictor<Scalar> predictor(dmd);
+    CAROM::OnlineMatrix<Scalar> online_basis(basis);
+    CAROM::OnlineVector<Scalar> x, online_reduced(reduced), restricted;
+
+    // Accuracy against the double precision Matrix and Vector path.
+    double predict_error = 0.0;
+    for (int n = 0; n < 5; ++n) {
+        const double t = 0.7 * n;
+        CAROM::Vector* reference = dmd.predict(t);
+        predictor.predict(t, x);
+        predict_error = std::max(predict_error, relativeError(x, *reference));
+        delete reference;
+    }
+    CAROM::Vector* lifted = basis.mult(reduced);
+    CAROM::Vector* restricted_reference = basis.transposeMult(*lifted);
+    online_basis.mult(online_reduced, x);
+    const double lift_error = relativeError(x, *lifted);
+    online_basis.transposeMult(x, restricted);
+    const double restrict_error = relativeError(restricted,
+                                  *restricted_reference);
+    delete lifted;
+    delete restricted_reference;
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    double t_start = MPI_Wtime();
+    for (int n = 0; n < num_reps; ++n)
+        predictor.predict(0.01 * n, x);
+    const double predict_time = maxTime(t_start, num_reps);
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    t_start = MPI_Wtime();
+    for (int n = 0; n < num_reps; ++n) {
+        online_basis.mult(online_reduced, x);
+        online_basis.transposeMult(x, restricted);
+    }
+    const double lift_restrict_time = maxTime(t_start, num_reps);
+
+    if (rank == 0) {
+        printf("%-8s %10.2e %10.2e %10.2e %12.3e %12.3e %10.1f\n", name,
+               predict_error, lift_error, restrict_error, predict_time,
+               lift_restrict_time,
+               2.0 * sizeof(Scalar) * basis.numRows() * basis.numColumns() /
+               1048576.0);
+    }
+}
+
+}
+
+int
+main(
+    int argc,
+    char* argv[])
+{
+    MPI_Init(&argc, &argv);
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    const int dim = argc > 1 ? atoi(argv[1]) : 4000;
+    const int num_modes = argc > 2 ? atoi(argv[2]) : 20;
+    const int num_reps = argc > 3 ? atoi(argv[3]) : 100;
+    const int num_samples = 2 * num_modes + 1;
+
+    // A DMD model with num_modes slowly decaying oscillating modes.
+    std::vector<std::complex<double>> eigs;
+    for (int k = 0; k < num_modes / 2; ++k)
+        eigs.push_back(std::polar(0.999 - 0.001 * k, 0.05 * (k + 1)));
+    if (num_modes % 2 == 1)
+        eigs.push_back(0.995);
+    CAROM::Matrix* snapshots = CAROM::synthetic_dmd_snapshots(dim, num_samples,
+                               eigs);
+    CAROM::DMD dmd(dim, 0.1);
+    std::vector<double> sample(dim);
+    for (int j = 0; j < num_samples; ++j) {
+        for (int i = 0; i < dim; ++i)
+            sample[i] = snapshots->item(i, j);
+        dmd.takeSample(sample.data(), 0.1 * j);
+    }
+    dmd.train(num_modes);
+    delete snapshots;
+
+    CAROM::Matrix* basis = CAROM::synthetic_spatial_modes(dim, num_modes, 5);
+    CAROM::Vector reduced(num_modes, false);
+    for (int j = 0; j < num_modes; ++j)
+        reduced(j) = std::cos(1.0 + j);
+
+    // The double precision Matrix and Vector path for reference.
+    MPI_Barrier(MPI_COMM_WORLD);
+    double t_start = MPI_Wtime();
+    for (int n = 0; n < num_reps; ++n)
+        delete dmd.predict(0.01 * n);
+    const double matrix_predict_time = maxTime(t_start, num_reps);
+
+    if (rank == 0) {
+        printf("Local dimension %d, %d modes, %d repetitions\n", dim, num_modes,
+               num_reps);
+        printf("DMD::predict time %.3e s\n", matrix_predict_time);
+        printf("%-8s %10s %10s %10s %12s %12s %10s\n", "scalar", "predict",
+               "lift", "restrict", "predict [s]", "lift+res [s]", "modes [MB]");
+    }
+    report<double>("double", dmd, *basis, reduced, num_reps, rank);
+    report<float>("float", dmd, *basis, reduced, num_reps, rank);
+
+    delete basis;
+    MPI_Finalize();
+    return 0;
+}
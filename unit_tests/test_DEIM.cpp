@@ -17,6 +17,7 @@
 #include<gtest/gtest.h>
 #include <mpi.h>
 #include "hyperreduction/DEIM.h"
+#include "hyperreduction/Utilities.h"
 #include "linalg/Matrix.h"
 #define _USE_MATH_DEFINES
 #include <cmath>
@@ -142,6 +143,91 @@ TEST(DEIMSerialTest, Test_DEIM_decreased_used_basis_vectors)
     EXPECT_TRUE(l2_norm_diff < 1e-5);
 }
 
+TEST(DEIMSerialTest, Test_DEIM_joint)
+{
+    // Orthonormal input matrix to DEIM
+    double* orthonormal_mat = new double[50] {
+        -0.1067,   -0.4723,   -0.4552,    0.1104,   -0.2337,
+            0.1462,    0.6922,   -0.2716,    0.1663,    0.3569,
+            0.4087,   -0.3437,    0.4952,   -0.3356,    0.3246,
+            0.2817,   -0.0067,   -0.0582,   -0.0034,    0.0674,
+            0.5147,    0.1552,   -0.1635,   -0.3440,   -0.3045,
+            -0.4628,    0.0141,   -0.1988,   -0.5766,    0.0150,
+            -0.2203,    0.3283,    0.2876,   -0.4597,   -0.1284,
+            -0.0275,    0.1202,   -0.0924,   -0.2290,   -0.3808,
+            0.4387,   -0.0199,   -0.3338,   -0.1711,   -0.2220,
+            0.0101,    0.1807,    0.4488,    0.3219,   -0.6359
+        };
+
+    int num_cols = 5;
+    int num_rows = 10;
+
+    // The same basis with its columns reversed gives a second, different
+    // selection.
+    CAROM::Matrix* u = new CAROM::Matrix(orthonormal_mat, num_rows, num_cols,
+                                         false);
+    CAROM::Matrix* v = new CAROM::Matrix(num_rows, num_cols, false);
+    for (int i = 0; i < num_rows; i++) {
+        for (int j = 0; j < num_cols; j++) {
+            v->item(i, j) = u->item(i, num_cols - 1 - j);
+        }
+    }
+
+    std::vector<const CAROM::Matrix*> f_bases{u, v};
+    std::vector<int> num_used{num_cols, 3};
+    std::vector<std::vector<int>> f_sampled_row;
+    std::vector<std::vector<int>> f_sampled_rows_per_proc;
+    std::vector<CAROM::Matrix*> f_basis_sampled_inv;
+    for (int k = 0; k < 2; k++) {
+        f_basis_sampled_inv.push_back(new CAROM::Matrix(num_used[k], num_used[k],
+                                      false));
+    }
+    CAROM::DEIM(f_bases, num_used, f_sampled_row, f_sampled_rows_per_proc,
+                f_basis_sampled_inv, 0, 1);
+
+    // The joint selection matches DEIM on each basis separately.
+    for (int k = 0; k < 2; k++) {
+        std::vector<int> sampled_row(num_used[k], 0);
+        std::vector<int> sampled_rows_per_proc(1, 0);
+        CAROM::Matrix basis_sampled_inv(num_used[k], num_used[k], false);
+        CAROM::DEIM(f_bases[k], num_used[k], sampled_row, sampled_rows_per_proc,
+                    basis_sampled_inv, 0, 1);
+
+        EXPECT_EQ(f_sampled_row[k], sampled_row);
+        EXPECT_EQ(f_sampled_rows_per_proc[k], sampled_rows_per_proc);
+        for (int i = 0; i < num_used[k]; i++) {
+            for (int j = 0; j < num_used[k]; j++) {
+                EXPECT_DOUBLE_EQ(f_basis_sampled_inv[k]->item(i, j),
+                                 basis_sampled_inv(i, j));
+            }
+        }
+    }
+
+    // The merged sample set holds the union, and each basis sample maps to
+    // its row in it.
+    std::vector<int> merged_sampled_row, merged_rows_per_proc;
+    std::vector<std::vector<int>> merged_index;
+    CAROM::MergeSampledRows(f_sampled_row, f_sampled_rows_per_proc,
+                            merged_sampled_row, merged_rows_per_proc,
+                            merged_index);
+    EXPECT_EQ(merged_rows_per_proc[0], merged_sampled_row.size());
+    EXPECT_LE(merged_sampled_row.size(), num_cols + 3);
+    EXPECT_GE(merged_sampled_row.size(), num_cols);
+    for (size_t i = 1; i < merged_sampled_row.size(); i++) {
+        EXPECT_LT(merged_sampled_row[i - 1], merged_sampled_row[i]);
+    }
+    for (int k = 0; k < 2; k++) {
+        for (int s = 0; s < num_used[k]; s++) {
+            EXPECT_EQ(merged_sampled_row[merged_index[k][s]], f_sampled_row[k][s]);
+        }
+        delete f_basis_sampled_inv[k];
+    }
+
+    delete u;
+    delete v;
+    delete [] orthonormal_mat;
+}
+
 int main(int argc, char* argv[])
 {
     ::testing::InitGoogleTest(&argc, argv);
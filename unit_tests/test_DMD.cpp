@@ -19,9 +19,16 @@
 #include<gtest/gtest.h>
 #include <mpi.h>
 #include "algo/DMD.h"
+#include "algo/KernelDMD.h"
+#include "algo/WindowedDMD.h"
+#include "linalg/BasisGenerator.h"
 #include "linalg/Vector.h"
+#include "utils/SyntheticSnapshots.h"
+#include "utils/mpi_utils.h"
 #define _USE_MATH_DEFINES
 #include <cmath>
+#include <complex>
+#include <vector>
 
 /**
  * Simple smoke test to make sure Google Test is properly linked
@@ -90,6 +97,278 @@ TEST(DMDTest, Test_DMD)
     }
 }
 
+TEST(DMDTest, Test_DMD_out_of_core)
+{
+    constexpr int num_total_rows = 60;
+    constexpr int num_samples = 15;
+    const int dim = CAROM::split_dimension(num_total_rows, MPI_COMM_WORLD);
+    const std::vector<std::complex<double>> eigs = {
+        0.95, std::polar(0.9, 0.4), std::polar(0.98, 0.15)
+    };
+    CAROM::Matrix* snapshots = CAROM::synthetic_dmd_snapshots(dim, num_samples,
+                               eigs);
+
+    CAROM::DMD dmd(dim, 0.5);
+    CAROM::Options options(dim, num_samples);
+    options.setMaxBasisDimension(num_samples);
+    CAROM::BasisGenerator writer(options, false, "test_DMD_ooc");
+    CAROM::BasisGenerator mpio_writer(options, false, "test_DMD_ooc_mpio",
+                                      CAROM::Database::formats::HDF5_MPIO);
+    std::vector<double> sample(dim);
+    for (int j = 0; j < num_samples; ++j) {
+        for (int i = 0; i < dim; ++i)
+            sample[i] = snapshots->item(i, j);
+        dmd.takeSample(sample.data(), 0.5 * j);
+        writer.takeSample(sample.data());
+        mpio_writer.takeSample(sample.data());
+    }
+    writer.writeSnapshot();
+    mpio_writer.writeSnapshot();
+    dmd.train(5);
+
+    // Blocks of 4 snapshots, the last one partial.
+    CAROM::DMD dmd_ooc(dim, 0.5);
+    dmd_ooc.trainOutOfCore("test_DMD_ooc_snapshot", 5, 4);
+    CAROM::DMD dmd_mpio(dim, 0.5);
+    dmd_mpio.trainOutOfCore("test_DMD_ooc_mpio_snapshot", 0.9999, 4,
+                            CAROM::Database::formats::HDF5_MPIO);
+    EXPECT_EQ(dmd_ooc.getDimension(), 5);
+    EXPECT_EQ(dmd_mpio.getDimension(), 5);
+
+    for (double t : {0.0, 2.0, 7.0, 9.5}) {
+        CAROM::Vector* expected = dmd.predict(t);
+        CAROM::Vector* result = dmd_ooc.predict(t);
+        CAROM::Vector* result_mpio = dmd_mpio.predict(t);
+        const double tol = 1.0e-7 * expected->norm();
+        for (int i = 0; i < dim; ++i) {
+            EXPECT_NEAR(result->item(i), expected->item(i), tol);
+            EXPECT_NEAR(result_mpio->item(i), expected->item(i), tol);
+        }
+        delete expected;
+        delete result;
+        delete result_mpio;
+    }
+    delete snapshots;
+}
+
+TEST(DMDTest, Test_WindowedDMD)
+{
+    constexpr int num_total_rows = 60;
+    constexpr int num_samples = 21;
+    constexpr double dt = 0.5;
+    const int dim = CAROM::split_dimension(num_total_rows, MPI_COMM_WORLD);
+    const std::vector<std::complex<double>> eigs = {
+        0.95, std::polar(0.9, 0.4), std::polar(0.98, 0.15)
+    };
+    CAROM::Matrix* snapshots = CAROM::synthetic_dmd_snapshots(dim, num_samples,
+                               eigs);
+
+    // Windows start every 5 samples and share 2 samples with the next one:
+    // [0, 7], [5, 12], [10, 17] and [15, 20].
+    CAROM::WindowedDMD windowed(dim, dt, 5, 2);
+    std::vector<double> sample(dim);
+    for (int j = 0; j < num_samples; ++j) {
+        for (int i = 0; i < dim; ++i)
+            sample[i] = snapshots->item(i, j);
+        windowed.takeSample(sample.data(), dt * j);
+    }
+    windowed.train(5);
+    EXPECT_EQ(windowed.getNumWindows(), 4);
+    EXPECT_EQ(windowed.getNumSamples(), num_samples);
+    EXPECT_EQ(windowed.getWindowIndex(0.0), 0);
+    EXPECT_EQ(windowed.getWindowIndex(dt * 4.9), 0);
+    EXPECT_EQ(windowed.getWindowIndex(dt * 5), 1);
+    EXPECT_EQ(windowed.getWindowIndex(dt * 12), 2);
+    EXPECT_EQ(windowed.getWindowIndex(dt * 40), 3);
+    EXPECT_DOUBLE_EQ(windowed.getWindowStartTime(3), dt * 15);
+
+    // Each window is the DMD model of its samples.
+    CAROM::DMD last_window(dim, dt);
+    for (int j = 15; j < num_samples; ++j) {
+        for (int i = 0; i < dim; ++i)
+            sample[i] = snapshots->item(i, j);
+        last_window.takeSample(sample.data(), dt * j);
+    }
+    last_window.train(5);
+    CAROM::Vector* expected = last_window.predict(dt * 18.5);
+    CAROM::Vector* result = windowed.predict(dt * 18.5);
+    for (int i = 0; i < dim; ++i)
+        EXPECT_NEAR(result->item(i), expected->item(i), 1.0e-8 * expected->norm());
+    delete expected;
+    delete result;
+
+    // The snapshots are of a linear system of rank 5, so the windows chained
+    // from the first snapshot reproduce all of them, also after a restart.
+    CAROM::Vector init(dim, true);
+    for (int i = 0; i < dim; ++i)
+        init(i) = snapshots->item(i, 0);
+    windowed.projectInitialCondition(&init);
+    windowed.save("test_WindowedDMD");
+    CAROM::WindowedDMD loaded("test_WindowedDMD");
+    EXPECT_EQ(loaded.getNumWindows(), 4);
+    for (CAROM::WindowedDMD* model : {
+                &windowed, &loaded
+            }) {
+        for (int j = 0; j < num_samples; j += 3) {
+            CAROM::Vector* result = model->predict(dt * j);
+            double error = 0.0, norm = 0.0;
+            for (int i = 0; i < dim; ++i) {
+                error += std::pow(result->item(i) - snapshots->item(i, j), 2);
+                norm += std::pow(snapshots->item(i, j), 2);
+            }
+            EXPECT_LT(error, 1.0e-12 * norm) << "sample " << j;
+            delete result;
+        }
+    }
+    delete snapshots;
+}
+
+TEST(DMDTest, Test_KernelDMD_linear)
+{
+    int d_rank, d_num_procs;
+    MPI_Comm_rank(MPI_COMM_WORLD, &d_rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &d_num_procs);
+
+    int num_total_rows = 5;
+    int d_num_rows = num_total_rows / d_num_procs;
+    if (num_total_rows % d_num_procs > d_rank) {
+        d_num_rows++;
+    }
+    std::vector<int> row_offset(d_num_procs + 1);
+    row_offset[d_num_procs] = num_total_rows;
+    row_offset[d_rank] = d_num_rows;
+    MPI_Allgather(MPI_IN_PLACE, 1, MPI_INT, row_offset.data(), 1, MPI_INT,
+                  MPI_COMM_WORLD);
+    for (int i = d_num_procs - 1; i >= 0; i--) {
+        row_offset[i] = row_offset[i + 1] - row_offset[i];
+    }
+
+    double sample1[5] = {0.5377, 1.8339, -2.2588, 0.8622, 0.3188};
+    double sample2[5] = {-1.3077, -0.4336, 0.3426, 3.5784, 2.7694};
+    double sample3[5] = {-1.3499, 3.0349, 0.7254, -0.0631, 0.7147};
+
+    // With the linear kernel, kernel DMD reduces to DMD.
+    CAROM::DMD dmd(d_num_rows, 1.0);
+    CAROM::KernelDMD kdmd(d_num_rows, 1.0, "LIN", 1.0, 1);
+    for (CAROM::DMD* d : {
+                &dmd, static_cast<CAROM::DMD*>(&kdmd)
+            }) {
+        d->takeSample(&sample1[row_offset[d_rank]], 0.0);
+        d->takeSample(&sample2[row_offset[d_rank]], 1.0);
+        d->takeSample(&sample3[row_offset[d_rank]], 2.0);
+        d->train(2);
+    }
+
+    CAROM::Vector* result = dmd.predict(3.0);
+    CAROM::Vector* kernel_result = kdmd.predict(3.0);
+    for (int i = 0; i < d_num_rows; i++) {
+        EXPECT_NEAR(kernel_result->item(i), result->item(i), 1e-10);
+    }
+    delete result;
+    delete kernel_result;
+}
+
+TEST(DMDTest, Test_KernelDMD_polynomial)
+{
+    int d_rank, d_num_procs;
+    MPI_Comm_rank(MPI_COMM_WORLD, &d_rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &d_num_procs);
+
+    // The map x1' = a x1, x2' = b x2 + c x1^2 has the Koopman eigenvalues a,
+    // b and a^2 on the span of degree 2 monomials. Each rank stores a copy of
+    // (x1, x2).
+    const double a = 0.9, b = 0.5, c = 0.3;
+    double x[2] = {0.8, -0.4};
+
+    CAROM::KernelDMD kdmd(2, 1.0, "POLY", 2.0, 4);
+    std::vector<std::vector<double>> trajectory;
+    for (int n = 0; n < 12; n++) {
+        trajectory.push_back(std::vector<double>(x, x + 2));
+        kdmd.takeSample(x, n);
+        const double x1 = x[0];
+        x[0] = a * x1;
+        x[1] = b * x[1] + c * x1 * x1;
+    }
+    kdmd.train(6);
+
+    for (double lambda : {
+                a, b, a * a
+            }) {
+        double dist = 1.0;
+        for (std::complex<double> eig : kdmd.getEigs()) {
+            dist = std::min(dist, std::abs(eig - lambda));
+        }
+        EXPECT_NEAR(dist, 0.0, 1e-6) << "eigenvalue " << lambda;
+    }
+
+    // The state lies in the invariant subspace, so predictions are exact.
+    for (int n = 0; n < 12; n += 5) {
+        CAROM::Vector* result = kdmd.predict(n);
+        EXPECT_NEAR(result->item(0), trajectory[n][0], 1e-6);
+        EXPECT_NEAR(result->item(1), trajectory[n][1], 1e-6);
+        delete result;
+    }
+}
+
+TEST(DMDTest, Test_KernelDMD_save_load)
+{
+    int d_rank, d_num_procs;
+    MPI_Comm_rank(MPI_COMM_WORLD, &d_rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &d_num_procs);
+
+    constexpr int num_total_rows = 7;
+    int d_num_rows = CAROM::split_dimension(num_total_rows, MPI_COMM_WORLD);
+    std::vector<int> row_offset;
+    CAROM::get_global_offsets(d_num_rows, row_offset, MPI_COMM_WORLD);
+
+    // A decaying, rotating state, distributed by rows.
+    CAROM::KernelDMD kdmd(d_num_rows, 0.5, "G", 2.0, 3);
+    std::vector<double> sample(d_num_rows);
+    for (int n = 0; n < 10; n++) {
+        for (int i = 0; i < d_num_rows; i++) {
+            const int row = row_offset[d_rank] + i;
+            sample[i] = std::pow(0.9, n) * std::cos(0.4 * n + row);
+        }
+        kdmd.takeSample(sample.data(), 0.5 * n);
+    }
+    kdmd.train(5);
+    kdmd.save("test_KernelDMD");
+
+    // The saved model predicts as the trained one, also from a new initial
+    // condition, which is projected through the kernel at the saved
+    // snapshots.
+    CAROM::KernelDMD constructed("test_KernelDMD");
+    CAROM::KernelDMD loaded(d_num_rows, 0.5, "LIN", 1.0, 1);
+    loaded.load("test_KernelDMD");
+    CAROM::Vector init(d_num_rows, true);
+    for (int i = 0; i < d_num_rows; i++) {
+        init(i) = std::sin(row_offset[d_rank] + i);
+    }
+    auto expect_same_predictions = [&]() {
+        for (double t : {
+                    0.0, 1.5, 4.0
+                }) {
+            CAROM::Vector* result = kdmd.predict(t);
+            CAROM::Vector* constructed_result = constructed.predict(t);
+            CAROM::Vector* loaded_result = loaded.predict(t);
+            for (int i = 0; i < d_num_rows; i++) {
+                EXPECT_NEAR(constructed_result->item(i), result->item(i), 1e-12);
+                EXPECT_NEAR(loaded_result->item(i), result->item(i), 1e-12);
+            }
+            delete result;
+            delete constructed_result;
+            delete loaded_result;
+        }
+    };
+    expect_same_predictions();
+    for (CAROM::KernelDMD* d : {
+                &kdmd, &constructed, &loaded
+            }) {
+        d->projectInitialCondition(&init);
+    }
+    expect_same_predictions();
+}
+
 int main(int argc, char* argv[])
 {
     ::testing::InitGoogleTest(&argc, argv);
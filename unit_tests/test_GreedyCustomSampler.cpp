@@ -189,6 +189,66 @@ TEST(GreedyCustomSamplerSerialTest, Test_GreedySaveAndLoad)
               nextPointToSampleLoad.get()->item(0));
 }
 
+/**
+ * Runs the greedy procedure with a synthetic error indicator comparing a
+ * smooth function at the point and at the local ROM, and returns the number
+ * of error indicators computed.
+ */
+int runSyntheticGreedy(CAROM::GreedyCustomSampler& sampler)
+{
+    auto error = [](const CAROM::Vector& point, const CAROM::Vector& rom) {
+        return std::abs(std::sin(3.0 * point.item(0)) - std::sin(3.0 * rom.item(0)))
+               + 0.1 * std::abs(point.item(0) - rom.item(0));
+    };
+
+    int num_error_indicators = 0;
+    for (int iter = 0; iter < 10000 && !sampler.isComplete(); iter++)
+    {
+        struct CAROM::GreedyErrorIndicatorPoint relativeErrorPoint =
+            sampler.getNextPointRequiringRelativeError();
+        struct CAROM::GreedyErrorIndicatorPoint errorIndicatorPoint =
+            sampler.getNextPointRequiringErrorIndicator();
+        if (relativeErrorPoint.point != nullptr)
+        {
+            sampler.setPointRelativeError(error(*relativeErrorPoint.point,
+                                                *relativeErrorPoint.localROM));
+        }
+        else if (errorIndicatorPoint.point != nullptr)
+        {
+            sampler.setPointErrorIndicator(error(*errorIndicatorPoint.point,
+                                                 *errorIndicatorPoint.localROM), 1);
+            num_error_indicators++;
+        }
+        else
+        {
+            sampler.getNextParameterPoint();
+        }
+    }
+    EXPECT_TRUE(sampler.isComplete());
+    return num_error_indicators;
+}
+
+TEST(GreedyCustomSamplerSerialTest, Test_GreedySurrogate)
+{
+    std::vector<double> paramPoints;
+    for (int i = 0; i < 101; i++)
+    {
+        paramPoints.push_back(0.02 * i);
+    }
+
+    CAROM::GreedyCustomSampler plainSampler(paramPoints, false, 0.3, 1.05, 2.0,
+                                            20, 40, "", "", true, 1, false);
+    const int plain_evaluations = runSyntheticGreedy(plainSampler);
+
+    CAROM::GreedyCustomSampler surrogateSampler(paramPoints, false, 0.3, 1.05,
+            2.0, 20, 40, "", "", true, 1, false);
+    surrogateSampler.setSurrogate("G", 0.9, 2.0);
+    const int surrogate_evaluations = runSyntheticGreedy(surrogateSampler);
+
+    EXPECT_GT(surrogateSampler.getNumSurrogateSavedEvaluations(), 0);
+    EXPECT_LT(surrogate_evaluations, plain_evaluations);
+}
+
 int main(int argc, char* argv[])
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -13,7 +13,10 @@
 #include<gtest/gtest.h>
 #include "linalg/BasisGenerator.h"
 #include "utils/HDFDatabase.h"
+#include "utils/HDFDatabaseMPIO.h"
+#include "utils/CSVDatabase.h"
 #include <algorithm>
+#include <climits>
 #include <cmath>
 #include <cstdio>
 #include <cstring> // for memcpy
@@ -769,6 +772,111 @@ TEST(BasisReaderIO, partial_getSpatialBasis)
     delete spatial_basis1;
 }
 
+TEST(DatabaseIO, Test_indexed_reading)
+{
+    int nproc, rank;
+    MPI_Comm_size(MPI_COMM_WORLD, &nproc);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    const int nelements = 1000;
+    std::vector<double> values(nelements);
+    for (int i = 0; i < nelements; i++)
+        values[i] = std::sin(0.1 * i + rank);
+
+    // Runs of consecutive indices, read as hyperslab blocks, and scattered
+    // indices, read as points.
+    std::vector<int> runs, scattered;
+    for (int i = 3; i < nelements; i += 50)
+        for (int j = i; j < std::min(i + 10, nelements); j++)
+            runs.push_back(j);
+    for (int i = 1; i < nelements; i += 7)
+        scattered.push_back(i);
+    scattered.push_back(nelements - 1);
+
+    // Each process writes its own file.
+    CAROM::HDFDatabase hdf;
+    hdf.create("test_indexed.h5", MPI_COMM_WORLD);
+    hdf.putDoubleArray("values", values.data(), nelements);
+    hdf.close();
+
+    CAROM::CSVDatabase csv;
+    const std::string csv_name = "test_indexed_" + std::to_string(rank) + ".csv";
+    csv.putDoubleArray(csv_name, values.data(), nelements);
+
+    for (const std::vector<int>& idx : {runs, scattered})
+    {
+        std::vector<double> data(idx.size(), 0.0);
+        hdf.open("test_indexed.h5", "r", MPI_COMM_WORLD);
+        hdf.getDoubleArray("values", data.data(), nelements, idx);
+        hdf.close();
+        for (size_t k = 0; k < idx.size(); k++)
+            EXPECT_EQ(data[k], values[idx[k]]);
+
+        std::fill(data.begin(), data.end(), 0.0);
+        csv.getDoubleArray(csv_name, data.data(), nelements, idx);
+        for (size_t k = 0; k < idx.size(); k++)
+            EXPECT_NEAR(data[k], values[idx[k]], threshold);
+    }
+
+#if HDF5_IS_PARALLEL
+    // Each process reads its indexed entries of a distributed array.
+    CAROM::HDFDatabaseMPIO mpio;
+    mpio.create("test_indexed_mpio.h5", MPI_COMM_WORLD);
+    mpio.putDoubleArray("values", values.data(), nelements, true);
+    mpio.close();
+
+    std::vector<double> data(scattered.size(), 0.0);
+    mpio.open("test_indexed_mpio.h5", "r", MPI_COMM_WORLD);
+    mpio.getDoubleArray("values", data.data(), nelements, scattered, true);
+    mpio.close();
+    for (size_t k = 0; k < scattered.size(); k++)
+        EXPECT_EQ(data[k], values[scattered[k]]);
+#endif
+}
+
+TEST(DatabaseIO, Test_integer64)
+{
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    const int64_t large = static_cast<int64_t>(INT_MAX) * 3 + rank;
+
+    CAROM::HDFDatabase hdf;
+    hdf.create("test_integer64.h5", MPI_COMM_WORLD);
+    hdf.putInteger64("large", large);
+    hdf.putInteger("small", -rank - 1);
+    hdf.close();
+
+    // Integers written with 32 bits are read as 64-bit integers as well.
+    int64_t value;
+    hdf.open("test_integer64.h5", "r", MPI_COMM_WORLD);
+    hdf.getInteger64("large", value);
+    EXPECT_EQ(value, large);
+    hdf.getInteger64("small", value);
+    EXPECT_EQ(value, -rank - 1);
+    hdf.close();
+
+    CAROM::CSVDatabase csv;
+    const std::string csv_name = "test_integer64_" + std::to_string(rank) + ".csv";
+    csv.putInteger64(csv_name, large);
+    value = 0;
+    csv.getInteger64(csv_name, value);
+    EXPECT_EQ(value, large);
+
+#if HDF5_IS_PARALLEL
+    CAROM::HDFDatabaseMPIO mpio;
+    mpio.create("test_integer64_mpio.h5", MPI_COMM_WORLD);
+    mpio.putInteger64("large", large);
+    mpio.close();
+
+    value = 0;
+    mpio.open("test_integer64_mpio.h5", "r", MPI_COMM_WORLD);
+    mpio.getInteger64("large", value);
+    mpio.close();
+    EXPECT_EQ(value, static_cast<int64_t>(INT_MAX) * 3);
+#endif
+}
+
 TEST(BasisGeneratorIO, Scaling_test)
 {
     int nproc, rank;
@@ -0,0 +1,285 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2013-2024, Lawrence Livermore National Security, LLC
+ * and other libROM project developers. See the top-level COPYRIGHT
+ * file for details.
+ *
+ * SPDX-License-Identifier: (Apache-2.0 OR MIT)
+ *
+ *****************************************************************************/
+
+// Description: This source file is a test runner that uses the Google Test
+// Framework to run unit tests on the RBF interpolation utilities.
+
+#include <iostream>
+
+#ifdef CAROM_HAS_GTEST
+#include<gtest/gtest.h>
+#include <mpi.h>
+#include "algo/manifold_interp/Interpolator.h"
+#include "algo/manifold_interp/MatrixInterpolator.h"
+#include "algo/manifold_interp/VectorInterpolator.h"
+#include "linalg/Matrix.h"
+#include "linalg/Vector.h"
+#include <cmath>
+#include <vector>
+
+/**
+ * Simple smoke test to make sure Google Test is properly linked
+ */
+TEST(GoogleTestFramework, GoogleTestFrameworkFound) {
+    SUCCEED();
+}
+
+namespace {
+
+// A perturbed num_side x num_side grid of points in the unit square.
+std::vector<CAROM::Vector*> gridPoints(int num_side)
+{
+    std::vector<CAROM::Vector*> points;
+    for (int i = 0; i < num_side; ++i) {
+        for (int j = 0; j < num_side; ++j) {
+            CAROM::Vector* point = new CAROM::Vector(2, false);
+            point->item(0) = (i + 0.3 * std::sin(7.0 * i + 3.0 * j)) / num_side;
+            point->item(1) = (j + 0.3 * std::cos(5.0 * i - 2.0 * j)) / num_side;
+            points.push_back(point);
+        }
+    }
+    return points;
+}
+
+double testFunction(const CAROM::Vector* point, int k)
+{
+    return std::sin(2.0 * point->item(0) + k) * std::cos(3.0 * point->item(1));
+}
+
+}
+
+TEST(InterpolatorTest, Test_closest_rbf_epsilon)
+{
+    std::vector<CAROM::Vector*> points = gridPoints(12);
+
+    double closest = 1.0e10;
+    for (size_t i = 0; i < points.size(); ++i) {
+        for (size_t j = i + 1; j < points.size(); ++j) {
+            CAROM::Vector diff;
+            points[i]->minus(*points[j], diff);
+            closest = std::min(closest, diff.norm2());
+        }
+    }
+    EXPECT_DOUBLE_EQ(CAROM::convertClosestRBFToEpsilon(points, "G", 0.9),
+                     std::sqrt(-std::log(0.9) / closest));
+
+    // The Wendland RBF of the closest points is the requested value.
+    const double epsilon = CAROM::convertClosestRBFToEpsilon(points, "W", 0.5);
+    double closest_rbf = 0.0;
+    for (size_t i = 0; i < points.size(); ++i)
+        for (size_t j = i + 1; j < points.size(); ++j)
+            closest_rbf = std::max(closest_rbf, CAROM::obtainRBF("W", epsilon,
+                                   points[i], points[j]));
+    EXPECT_NEAR(closest_rbf, 0.5, 1.0e-10);
+
+    // Points spread along the second coordinate only, with one far point,
+    // give the closest pair of the loop over all pairs.
+    std::vector<CAROM::Vector*> line;
+    for (int i = 0; i < 20; ++i) {
+        CAROM::Vector* point = new CAROM::Vector(3, false);
+        point->item(0) = 1.0;
+        point->item(1) = 0.1 * i + 0.01 * i * i;
+        point->item(2) = 0.0;
+        line.push_back(point);
+    }
+    line.back()->item(1) = 100.0;
+    double line_closest = 1.0e10;
+    for (size_t i = 0; i < line.size(); ++i) {
+        for (size_t j = i + 1; j < line.size(); ++j) {
+            CAROM::Vector diff;
+            line[i]->minus(*line[j], diff);
+            line_closest = std::min(line_closest, diff.norm2());
+        }
+    }
+    EXPECT_DOUBLE_EQ(CAROM::convertClosestRBFToEpsilon(line, "G", 0.9),
+                     std::sqrt(-std::log(0.9) / line_closest));
+
+    for (auto point : points)
+        delete point;
+    for (auto point : line)
+        delete point;
+}
+
+TEST(InterpolatorTest, Test_sparse_rbf_cholesky)
+{
+    constexpr int num_side = 30;
+    std::vector<CAROM::Vector*> points = gridPoints(num_side);
+    const int n = points.size();
+    const double epsilon = CAROM::convertClosestRBFToEpsilon(points, "W", 0.9);
+
+    CAROM::SparseRBFCholesky factor(points, epsilon);
+    EXPECT_LT(factor.numNonzeros(), n * n / 5);
+    EXPECT_LT(factor.envelopeSize(), n * n / 5);
+
+    std::vector<double> b(n), x(n);
+    for (int i = 0; i < n; ++i)
+        b[i] = testFunction(points[i], 0);
+    x = b;
+    factor.solve(x.data());
+
+    // The residual with the dense RBF matrix.
+    double residual = 0.0;
+    for (int i = 0; i < n; ++i) {
+        double Bx = x[i];
+        for (int j = 0; j < n; ++j)
+            if (j != i)
+                Bx += CAROM::obtainRBF("W", epsilon, points[i], points[j]) * x[j];
+        residual = std::max(residual, std::abs(Bx - b[i]));
+    }
+    EXPECT_LT(residual, 1.0e-10);
+
+    for (auto point : points)
+        delete point;
+}
+
+TEST(InterpolatorTest, Test_VectorInterpolator_wendland)
+{
+    constexpr int num_side = 20;
+    constexpr int dim = 3;
+    std::vector<CAROM::Vector*> points = gridPoints(num_side);
+    std::vector<CAROM::Matrix*> rotations;
+    std::vector<CAROM::Vector*> vectors;
+    for (auto point : points) {
+        CAROM::Matrix* rotation = new CAROM::Matrix(dim, dim, false);
+        for (int k = 0; k < dim; ++k)
+            rotation->item(k, k) = 1.0;
+        rotations.push_back(rotation);
+        CAROM::Vector* vector = new CAROM::Vector(dim, false);
+        for (int k = 0; k < dim; ++k)
+            vector->item(k) = testFunction(point, k);
+        vectors.push_back(vector);
+    }
+
+    CAROM::VectorInterpolator interpolator(points, rotations, vectors, 0, "W",
+                                           "LS", 0.9);
+
+    // The LS interpolant reproduces the training vectors.
+    for (size_t i = 0; i < points.size(); i += 37) {
+        CAROM::Vector* result = interpolator.interpolate(points[i]);
+        for (int k = 0; k < dim; ++k)
+            EXPECT_NEAR(result->item(k), vectors[i]->item(k), 1.0e-10);
+        delete result;
+    }
+
+    // Away from the training points it approximates the smooth function.
+    CAROM::Vector point(2, false);
+    point.item(0) = 0.43;
+    point.item(1) = 0.61;
+    CAROM::Vector* result = interpolator.interpolate(&point);
+    for (int k = 0; k < dim; ++k)
+        EXPECT_NEAR(result->item(k), testFunction(&point, k), 1.0e-2);
+    delete result;
+
+    for (size_t i = 0; i < points.size(); ++i) {
+        delete points[i];
+        delete rotations[i];
+        delete vectors[i];
+    }
+}
+
+TEST(InterpolatorTest, Test_LS_weights_dense)
+{
+    constexpr int num_side = 5;
+    constexpr int num_rows = 2;
+    constexpr int num_cols = 3;
+    constexpr int ref_point = 7;
+    std::vector<CAROM::Vector*> points = gridPoints(num_side);
+    const int n = points.size();
+
+    CAROM::Vector point(2, false);
+    point.item(0) = 0.43;
+    point.item(1) = 0.61;
+
+    // Matrices and vectors of the same entries, with identity rotations.
+    std::vector<CAROM::Matrix*> matrices, matrix_rotations, vector_rotations;
+    std::vector<CAROM::Vector*> vectors;
+    for (auto p : points) {
+        CAROM::Matrix* matrix = new CAROM::Matrix(num_rows, num_cols, false);
+        CAROM::Vector* vector = new CAROM::Vector(num_rows * num_cols, false);
+        for (int k = 0; k < num_rows * num_cols; ++k)
+            matrix->getData()[k] = vector->item(k) = testFunction(p, k);
+        matrices.push_back(matrix);
+        vectors.push_back(vector);
+
+        CAROM::Matrix* matrix_rotation = new CAROM::Matrix(num_rows, num_rows, false);
+        for (int k = 0; k < num_rows; ++k)
+            matrix_rotation->item(k, k) = 1.0;
+        matrix_rotations.push_back(matrix_rotation);
+        CAROM::Matrix* vector_rotation = new CAROM::Matrix(num_rows * num_cols,
+                num_rows * num_cols, false);
+        for (int k = 0; k < num_rows * num_cols; ++k)
+            vector_rotation->item(k, k) = 1.0;
+        vector_rotations.push_back(vector_rotation);
+    }
+
+    std::vector<CAROM::Vector*> gammas;
+    for (auto vector : vectors)
+        gammas.push_back(vector->minus(*vectors[ref_point]));
+
+    for (const std::string rbf : {"G", "IQ"}) {
+        // The interpolant of the direct solve for lambda^T, applied to the
+        // RBF vector of the point.
+        double epsilon = CAROM::convertClosestRBFToEpsilon(points, rbf, 0.9);
+        CAROM::Matrix* lambda_T = CAROM::solveLinearSystem(points, gammas, "LS",
+                                  rbf, epsilon);
+        std::vector<double> rbf_point = CAROM::obtainRBFToTrainingPoints(points,
+                                        "LS", rbf, epsilon, &point);
+        CAROM::Vector* expected = CAROM::obtainInterpolatedVector(gammas, lambda_T,
+                                  "LS", rbf_point);
+        *expected += *vectors[ref_point];
+        const double scale = expected->inner_product(*expected);
+
+        CAROM::VectorInterpolator vector_interpolator(points, vector_rotations,
+                vectors, ref_point, rbf, "LS", 0.9);
+        CAROM::Vector* vector_result = vector_interpolator.interpolate(&point);
+
+        CAROM::MatrixInterpolator matrix_interpolator(points, matrix_rotations,
+                matrices, ref_point, "R", rbf, "LS", 0.9);
+        CAROM::Matrix* matrix_result = matrix_interpolator.interpolate(&point);
+
+        for (int k = 0; k < num_rows * num_cols; ++k) {
+            EXPECT_NEAR(vector_result->item(k), expected->item(k),
+                        1.0e-8 * std::sqrt(scale));
+            EXPECT_NEAR(matrix_result->getData()[k], expected->item(k),
+                        1.0e-8 * std::sqrt(scale));
+        }
+
+        delete lambda_T;
+        delete expected;
+        delete vector_result;
+        delete matrix_result;
+    }
+
+    for (int i = 0; i < n; ++i) {
+        delete points[i];
+        delete matrices[i];
+        delete vectors[i];
+        delete gammas[i];
+        delete matrix_rotations[i];
+        delete vector_rotations[i];
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    MPI_Init(&argc, &argv);
+    int result = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return result;
+}
+#else // #ifndef CAROM_HAS_GTEST
+int main()
+{
+    std::cout << "libROM was compiled without Google Test support, so unit "
+              << "tests have been disabled. To enable unit tests, compile "
+              << "libROM with Google Test support." << std::endl;
+}
+#endif // #endif CAROM_HAS_GTEST
@@ -13,12 +13,15 @@
 
 #include <iostream>
 #include <cmath>
+#include <algorithm>
 
 #ifdef CAROM_HAS_GTEST
 #include<gtest/gtest.h>
 #include <mpi.h>
 #include "linalg/Matrix.h"
 #include "utils/mpi_utils.h"
+#include "utils/AllreducePlan.h"
+#include "CAROM_config.h"
 
 /**
  * Simple smoke test to make sure Google Test is properly linked
@@ -605,6 +608,59 @@ TEST(MatrixSerialTest, Test_Matrix_orthogonalize5)
     EXPECT_TRUE(norm2 < abs_error) << norm2 << " > " << abs_error;
 }
 
+TEST(MatrixSerialTest, Test_Matrix_orthogonalize_weighted)
+{
+    // Matrix data to orthonormalize.
+    double d_mat[12] = {1.0, 0.5, 2.0,
+                        0.0, 1.0, -1.0,
+                        3.0, 0.0, 1.0,
+                        1.0, 2.0, 0.5
+                       };
+
+    // Symmetric positive definite weight.
+    double d_weight[16] = {2.0, -1.0, 0.0, 0.0,
+                           -1.0, 2.0, -1.0, 0.0,
+                           0.0, -1.0, 2.0, -1.0,
+                           0.0, 0.0, -1.0, 2.0
+                          };
+    CAROM::Matrix weight(d_weight, 4, 4, false);
+    CAROM::Vector diagonal(4, false);
+    for (int i = 0; i < 4; i++)
+        diagonal(i) = 1.0 + i;
+
+    constexpr double abs_error = 1.0e-14; // absolute error threshold
+
+    for (int diag = 0; diag < 2; diag++)
+    {
+        CAROM::Matrix matrix(d_mat, 4, 3, false);
+        if (diag)
+        {
+            matrix.orthogonalize(diagonal, true);
+            for (int i = 0; i < 4; i++)
+                for (int j = 0; j < 4; j++)
+                    weight(i, j) = i == j ? diagonal(i) : 0.0;
+        }
+        else
+        {
+            matrix.orthogonalize([&weight](const CAROM::Vector & v,
+                                           CAROM::Vector & Mv)
+            {
+                weight.mult(v, Mv);
+            }, true);
+        }
+
+        CAROM::Matrix MQ(4, 3, false);
+        weight.mult(matrix, MQ);
+        CAROM::Matrix result(3, 3, false);
+        matrix.transposeMult(MQ, result);
+
+        for (int i = 0; i < 3; i++)
+            for (int j = 0; j < 3; j++)
+                EXPECT_NEAR(result.item(i, j), i == j ? 1.0 : 0.0, abs_error) <<
+                        "(i, j) = (" << i << ", " << j << ")";
+    }
+}
+
 TEST(MatrixSerialTest, Test_Matrix_orthogonalize_last)
 {
     // Matrix data to orthonormalize.
@@ -1879,6 +1935,36 @@ TEST(IdentityMatrixFactorySerialTest, Test_3vector)
     EXPECT_DOUBLE_EQ(identityMatrix(2, 2), 1.0);
 }
 
+TEST(MatrixSerialTest, Test_large_storage)
+{
+    // Storage above the threshold for parallel first-touch initialization.
+    const int num_cols = 8;
+    const int num_rows = CAROM::first_touch_min_size() / num_cols + 3;
+    CAROM::Matrix A(num_rows, num_cols, false);
+    double max_abs = 0.0;
+    for (int i = 0; i < num_rows; i++)
+        for (int j = 0; j < num_cols; j++)
+            max_abs = std::max(max_abs, std::abs(A.item(i, j)));
+    EXPECT_EQ(max_abs, 0.0);
+
+    for (int i = 0; i < num_rows; i++)
+        for (int j = 0; j < num_cols; j++)
+            A.item(i, j) = i - 0.5 * j;
+    CAROM::Matrix B(A);
+    CAROM::Matrix C(1, 1, false);
+    C = A;
+    int num_differences = 0;
+    for (int i = 0; i < num_rows; i++)
+        for (int j = 0; j < num_cols; j++)
+            num_differences += (B.item(i, j) != A.item(i, j)) +
+                               (C.item(i, j) != A.item(i, j));
+    EXPECT_EQ(num_differences, 0);
+
+    CAROM::Vector v(num_rows * num_cols, false);
+    double norm = v.norm();
+    EXPECT_EQ(norm, 0.0);
+}
+
 TEST(MatrixParallelTest, Test_distribute_and_gather)
 {
     int is_mpi_initialized, is_mpi_finalized;
@@ -1918,6 +2004,327 @@ TEST(MatrixParallelTest, Test_distribute_and_gather)
 
 }
 
+TEST(MatrixParallelTest, Test_mult_distributed_distributed)
+{
+    int is_mpi_initialized, is_mpi_finalized;
+    MPI_Initialized(&is_mpi_initialized);
+    MPI_Finalized(&is_mpi_finalized);
+    if (!is_mpi_initialized) return;
+
+    const MPI_Comm my_comm = MPI_COMM_WORLD;
+    int my_rank = -1, num_procs = -1;
+    MPI_Comm_size(my_comm, &num_procs);
+    MPI_Comm_rank(my_comm, &my_rank);
+
+    // A is 7 x 5 and B is 5 x 3, both with rows spread over all processes.
+    const int a_rows = 7, inner = 5, b_cols = 3;
+    CAROM::Matrix a_full(a_rows, inner, false);
+    CAROM::Matrix b_full(inner, b_cols, false);
+    for (int i = 0; i < a_rows; i++)
+        for (int j = 0; j < inner; j++)
+            a_full.item(i, j) = static_cast<double> (i + 2 * j + 1);
+    for (int i = 0; i < inner; i++)
+        for (int j = 0; j < b_cols; j++)
+            b_full.item(i, j) = static_cast<double> (i * j - j + 3);
+
+    CAROM::Matrix answer(a_rows, b_cols, false);
+    a_full.mult(b_full, answer);
+
+    std::vector<int> a_offsets, b_offsets;
+    const int a_local_rows = CAROM::split_dimension(a_rows, MPI_COMM_WORLD);
+    const int b_local_rows = CAROM::split_dimension(inner, MPI_COMM_WORLD);
+    CAROM::get_global_offsets(a_local_rows, a_offsets, MPI_COMM_WORLD);
+    CAROM::get_global_offsets(b_local_rows, b_offsets, MPI_COMM_WORLD);
+
+    CAROM::Matrix a(a_full);
+    a.distribute(a_local_rows);
+    CAROM::Matrix b(b_full);
+    b.distribute(b_local_rows);
+
+    CAROM::Matrix* c = a.mult(b);
+    EXPECT_TRUE(c->distributed());
+    EXPECT_EQ(c->numRows(), a_local_rows);
+    EXPECT_EQ(c->numColumns(), b_cols);
+    for (int local_i = 0, global_i = a_offsets[my_rank];
+            local_i < a_local_rows; local_i++, global_i++)
+        for (int j = 0; j < b_cols; j++)
+            EXPECT_DOUBLE_EQ(c->item(local_i, j), answer.item(global_i, j));
+    delete c;
+
+    // Undistributed times distributed reduces to an undistributed product.
+    CAROM::Matrix at(inner, inner, false);
+    for (int i = 0; i < inner; i++)
+        for (int j = 0; j < inner; j++)
+            at.item(i, j) = static_cast<double> (i - j);
+    CAROM::Matrix at_answer(inner, b_cols, false);
+    at.mult(b_full, at_answer);
+
+    CAROM::Matrix d(inner, b_cols, false);
+    at.mult(b, d);
+    EXPECT_FALSE(d.distributed());
+    for (int i = 0; i < inner; i++)
+        for (int j = 0; j < b_cols; j++)
+            EXPECT_DOUBLE_EQ(d.item(i, j), at_answer.item(i, j));
+}
+
+TEST(MatrixParallelTest, Test_transposeMultDistributed)
+{
+    int is_mpi_initialized, is_mpi_finalized;
+    MPI_Initialized(&is_mpi_initialized);
+    MPI_Finalized(&is_mpi_finalized);
+    if (!is_mpi_initialized) return;
+
+    const MPI_Comm my_comm = MPI_COMM_WORLD;
+    int my_rank = -1, num_procs = -1;
+    MPI_Comm_size(my_comm, &num_procs);
+    MPI_Comm_rank(my_comm, &my_rank);
+
+    const int total_rows = 8, a_cols = 5, b_cols = 4;
+    CAROM::Matrix a_full(total_rows, a_cols, false);
+    CAROM::Matrix b_full(total_rows, b_cols, false);
+    for (int i = 0; i < total_rows; i++)
+    {
+        for (int j = 0; j < a_cols; j++)
+            a_full.item(i, j) = static_cast<double> (i * j + 1);
+        for (int j = 0; j < b_cols; j++)
+            b_full.item(i, j) = static_cast<double> (i - 2 * j);
+    }
+    CAROM::Matrix* answer = a_full.transposeMult(b_full);
+
+    const int local_rows = CAROM::split_dimension(total_rows, MPI_COMM_WORLD);
+    CAROM::Matrix a(a_full);
+    a.distribute(local_rows);
+    CAROM::Matrix b(b_full);
+    b.distribute(local_rows);
+
+    std::vector<int> result_offsets;
+    const int result_local_rows = CAROM::split_dimension(a_cols, MPI_COMM_WORLD);
+    CAROM::get_global_offsets(result_local_rows, result_offsets, MPI_COMM_WORLD);
+
+    CAROM::Matrix* c = a.transposeMultDistributed(b);
+    EXPECT_TRUE(c->distributed());
+    EXPECT_EQ(c->numRows(), result_local_rows);
+    EXPECT_EQ(c->numDistributedRows(), a_cols);
+    EXPECT_EQ(c->numColumns(), b_cols);
+    for (int local_i = 0, global_i = result_offsets[my_rank];
+            local_i < result_local_rows; local_i++, global_i++)
+        for (int j = 0; j < b_cols; j++)
+            EXPECT_DOUBLE_EQ(c->item(local_i, j), answer->item(global_i, j));
+
+    // The undistributed product should give the same blocks.
+    CAROM::Matrix d(1, 1, true);
+    a_full.transposeMultDistributed(b_full, d);
+    EXPECT_EQ(d.numRows(), result_local_rows);
+    for (int local_i = 0, global_i = result_offsets[my_rank];
+            local_i < result_local_rows; local_i++, global_i++)
+        for (int j = 0; j < b_cols; j++)
+            EXPECT_DOUBLE_EQ(d.item(local_i, j), answer->item(global_i, j));
+
+    delete c;
+    delete answer;
+}
+
+TEST(MatrixParallelTest, Test_qrcp_pivots_transpose_distributed)
+{
+    int is_mpi_initialized, is_mpi_finalized;
+    MPI_Initialized(&is_mpi_initialized);
+    MPI_Finalized(&is_mpi_finalized);
+    if (!is_mpi_initialized) return;
+
+    int my_rank = -1, num_procs = -1;
+    MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+
+    const int total_rows = 40, num_cols = 6;
+    CAROM::Matrix full(total_rows, num_cols, false);
+    for (int i = 0; i < total_rows; i++)
+        for (int j = 0; j < num_cols; j++)
+            full.item(i, j) = std::cos(0.9 * (i + 1) * (j + 1) + 0.3 * i * i);
+
+    // The serial LAPACK pivots are the reference.
+    std::vector<int> expected(num_cols), expected_owner(num_cols);
+    full.qrcp_pivots_transpose(expected.data(), expected_owner.data(),
+                               num_cols);
+
+    const int local_rows = CAROM::split_dimension(total_rows, MPI_COMM_WORLD);
+    std::vector<int> row_offsets;
+    CAROM::get_global_offsets(local_rows, row_offsets, MPI_COMM_WORLD);
+    CAROM::Matrix distributed(full);
+    distributed.distribute(local_rows);
+
+    std::vector<int> pivots(num_cols), owners(num_cols);
+    for (CAROM::QRCP_pivoting pivoting : {
+                CAROM::QRCP_pivoting::FULL, CAROM::QRCP_pivoting::TRUNCATED
+            }) {
+        distributed.qrcp_pivots_transpose(pivots.data(), owners.data(),
+                                          num_cols, pivoting);
+        if (my_rank == 0) {
+            for (int i = 0; i < num_cols; i++) {
+                EXPECT_EQ(pivots[i], expected[i]);
+                EXPECT_TRUE(row_offsets[owners[i]] <= pivots[i]
+                            && pivots[i] < row_offsets[owners[i] + 1]);
+            }
+        }
+    }
+
+    // Tournament pivoting selects distinct rows whose submatrix is
+    // nonsingular, and reduces to the truncated QRCP on one process.
+    // The pivots are the same as GlobalIndex.
+    std::vector<CAROM::GlobalIndex> global_pivots(num_cols);
+    distributed.qrcp_pivots_transpose(global_pivots.data(), owners.data(),
+                                      num_cols);
+    if (my_rank == 0) {
+        for (int i = 0; i < num_cols; i++)
+            EXPECT_EQ(global_pivots[i], expected[i]);
+    }
+
+    distributed.qrcp_pivots_transpose(pivots.data(), owners.data(), num_cols,
+                                      CAROM::QRCP_pivoting::TOURNAMENT);
+    if (my_rank == 0) {
+        CAROM::Matrix selected(num_cols, num_cols, false);
+        for (int i = 0; i < num_cols; i++) {
+            EXPECT_TRUE(row_offsets[owners[i]] <= pivots[i]
+                        && pivots[i] < row_offsets[owners[i] + 1]);
+            for (int j = 0; j < i; j++)
+                EXPECT_NE(pivots[i], pivots[j]);
+            for (int j = 0; j < num_cols; j++)
+                selected.item(i, j) = full.item(pivots[i], j);
+            if (num_procs == 1) {
+                EXPECT_EQ(pivots[i], expected[i]);
+            }
+        }
+
+        // The determinant of the selected rows, by Gaussian elimination
+        // with partial pivoting.
+        double det = 1.0;
+        for (int k = 0; k < num_cols; k++) {
+            int p = k;
+            for (int i = k + 1; i < num_cols; i++)
+                if (std::abs(selected.item(i, k)) > std::abs(selected.item(p, k)))
+                    p = i;
+            for (int j = 0; j < num_cols; j++)
+                std::swap(selected.item(k, j), selected.item(p, j));
+            det *= selected.item(k, k);
+            for (int i = k + 1; i < num_cols; i++) {
+                const double f = selected.item(i, k) / selected.item(k, k);
+                for (int j = k; j < num_cols; j++)
+                    selected.item(i, j) -= f * selected.item(k, j);
+            }
+        }
+        EXPECT_GT(std::abs(det), 1.0e-3);
+    }
+}
+
+TEST(MatrixParallelTest, Test_global_offsets_64bit)
+{
+    int is_mpi_initialized, is_mpi_finalized;
+    MPI_Initialized(&is_mpi_initialized);
+    MPI_Finalized(&is_mpi_finalized);
+    if (!is_mpi_initialized) return;
+
+    int my_rank = -1, num_procs = -1;
+    MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+
+    // Local dimensions that fit in an int, whose global sum does not on more
+    // than one process. No storage of that size is allocated.
+    const int local_dim = 1500000000;
+    std::vector<CAROM::GlobalIndex> offsets;
+    const CAROM::GlobalIndex dim = CAROM::get_global_offsets(local_dim, offsets,
+                                   MPI_COMM_WORLD);
+    EXPECT_EQ(dim, static_cast<CAROM::GlobalIndex>(local_dim) * num_procs);
+    EXPECT_EQ(offsets.size(), static_cast<size_t>(num_procs + 1));
+    for (int i = 0; i <= num_procs; i++)
+        EXPECT_EQ(offsets[i], static_cast<CAROM::GlobalIndex>(local_dim) * i);
+
+    // Split a global dimension beyond INT_MAX into local dimensions that
+    // each fit in an int.
+    const CAROM::GlobalIndex global_dim =
+        static_cast<CAROM::GlobalIndex>(2000000000) * num_procs + num_procs - 1;
+    const int split_dim = CAROM::split_dimension(global_dim, MPI_COMM_WORLD);
+    EXPECT_EQ(split_dim, my_rank < num_procs - 1 ? 2000000001 : 2000000000);
+    CAROM::GlobalIndex sum = split_dim;
+    MPI_Allreduce(MPI_IN_PLACE, &sum, 1, CAROM_MPI_GLOBAL_INDEX, MPI_SUM,
+                  MPI_COMM_WORLD);
+    EXPECT_EQ(sum, global_dim);
+
+    // A distributed Matrix reports its global number of rows as GlobalIndex.
+    CAROM::Matrix m(my_rank + 1, 2, true);
+    const CAROM::GlobalIndex num_rows = m.numDistributedRows();
+    EXPECT_EQ(num_rows, num_procs * (num_procs + 1) / 2);
+}
+
+TEST(MatrixParallelTest, Test_allreduce_plan)
+{
+    int is_mpi_initialized, is_mpi_finalized;
+    MPI_Initialized(&is_mpi_initialized);
+    MPI_Finalized(&is_mpi_finalized);
+    if (!is_mpi_initialized) return;
+
+    int my_rank = -1, num_procs = -1;
+    MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+
+    // A plan is reused for new data, as in an iterative loop.
+    CAROM::AllreducePlan sum_plan(3, MPI_DOUBLE, MPI_SUM);
+    CAROM::AllreducePlan max_plan(2, MPI_INT, MPI_MAX);
+    EXPECT_EQ(sum_plan.count(), 3);
+    EXPECT_EQ(sum_plan.persistent(), CAROM_USE_PERSISTENT_COLLECTIVES == 1);
+    for (int iter = 0; iter < 5; iter++)
+    {
+        double sums[3] = {1.0, (double) my_rank, (double) iter};
+        sum_plan.allreduce(sums);
+        EXPECT_DOUBLE_EQ(sums[0], num_procs);
+        EXPECT_DOUBLE_EQ(sums[1], num_procs * (num_procs - 1) / 2);
+        EXPECT_DOUBLE_EQ(sums[2], num_procs * iter);
+
+        int maxs[2] = {my_rank, iter - my_rank};
+        max_plan.allreduce(maxs);
+        EXPECT_EQ(maxs[0], num_procs - 1);
+        EXPECT_EQ(maxs[1], iter);
+    }
+
+    // More counts than allreduce_sum keeps plans for, each used twice, and
+    // counts too large to be planned.
+    std::vector<int> counts;
+    for (int count = 1; count <= 40; count++)
+        counts.push_back(count);
+    counts.push_back(1025);
+    counts.push_back(100000);
+    for (const int count : counts)
+    {
+        for (int rep = 0; rep < 2; rep++)
+        {
+            std::vector<double> data(count, my_rank + rep);
+            CAROM::allreduce_sum(data.data(), count);
+            for (int i = 0; i < count; i++)
+                EXPECT_DOUBLE_EQ(data[i], num_procs * (num_procs - 1) / 2 +
+                                 num_procs * rep);
+        }
+    }
+
+    // Plans are created again after they are freed.
+    CAROM::free_allreduce_plans();
+    double one = 1.0;
+    CAROM::allreduce_sum(&one, 1);
+    EXPECT_DOUBLE_EQ(one, num_procs);
+
+    // transposeMult reduces with allreduce_sum.
+    CAROM::Matrix a(2, 3, true), b(2, 2, true);
+    for (int i = 0; i < 2; i++)
+    {
+        for (int j = 0; j < 3; j++)
+            a(i, j) = my_rank + i + j;
+        for (int j = 0; j < 2; j++)
+            b(i, j) = 1.0;
+    }
+    CAROM::Matrix atb;
+    a.transposeMult(b, atb);
+    for (int j = 0; j < 3; j++)
+        for (int k = 0; k < 2; k++)
+            EXPECT_DOUBLE_EQ(atb(j, k), num_procs * (num_procs - 1) +
+                             num_procs * (2 * j + 1));
+}
 
 int main(int argc, char* argv[])
 {
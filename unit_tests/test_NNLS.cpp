@@ -223,6 +223,103 @@ TEST(NNLS, solve_with_L2)
         printf("maximum error: %.5e\n", max_error);
 }
 
+TEST(NNLS, solve_with_sketch)
+{
+    int nproc;
+    int rank;
+    MPI_Comm_size(MPI_COMM_WORLD, &nproc);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    // Many redundant constraints of low rank, as in EQP systems with many
+    // snapshots, which a small sketch captures.
+    const int nrow = 400;
+    const int ncol = 200;
+    const int rank_G = 10;
+    const int ncol_local = CAROM::split_dimension(ncol);
+    std::vector<int> row_offset(nproc + 1);
+    CAROM::get_global_offsets(ncol_local, row_offset, MPI_COMM_WORLD);
+    const double rel_tol = 0.05;
+    const double nnls_tol = 1.0e-11;
+    const int sketch_rows = 40;
+
+    std::default_random_engine generator;
+    generator.seed(
+        1234); // fix the seed to keep the same result for different nproc.
+    std::uniform_real_distribution<> uniform_distribution(0.0, 1.0);
+    std::normal_distribution<double> normal_distribution(0.0, 1.0);
+
+    // distribute from a global matrix to keep the same system for different nproc.
+    CAROM::Matrix U(nrow, rank_G, false);
+    CAROM::Matrix V(ncol, rank_G, false);
+    for (int i = 0; i < nrow; i++)
+        for (int j = 0; j < rank_G; j++)
+            U(i, j) = normal_distribution(generator);
+    for (int i = 0; i < ncol; i++)
+        for (int j = 0; j < rank_G; j++)
+            V(i, j) = abs(normal_distribution(generator));
+    CAROM::Matrix Gt(ncol, nrow, false);
+    for (int i = 0; i < ncol; i++)
+        for (int j = 0; j < nrow; j++)
+        {
+            Gt(i, j) = 0.0;
+            for (int l = 0; l < rank_G; l++)
+                Gt(i, j) += V(i, l) * U(j, l);
+        }
+    Gt.distribute(ncol_local);
+
+    CAROM::Vector fom_sol(ncol_local, true);
+    CAROM::Vector rom_sol(ncol_local, true);
+    CAROM::Vector rhs(nrow, false);
+
+    CAROM::Vector fom_sol_serial(ncol, false);
+    for (int c = 0; c < ncol; c++)
+        fom_sol_serial(c) = uniform_distribution(generator);
+    for (int c = 0; c < ncol_local; c++)
+        fom_sol(c) = fom_sol_serial(row_offset[rank] + c);
+
+    Gt.transposeMult(fom_sol, rhs);
+
+    CAROM::Vector rhs_lb(rhs);
+    CAROM::Vector rhs_ub(rhs);
+
+    for (int i = 0; i < rhs.dim(); ++i)
+    {
+        double delta = rel_tol * abs(rhs(i));
+        rhs_lb(i) -= delta;
+        rhs_ub(i) += delta;
+    }
+
+    const CAROM::NNLS_sketch sketches[2] = {CAROM::NNLS_sketch::GAUSSIAN,
+                                            CAROM::NNLS_sketch::SPARSE_SIGN
+                                           };
+    for (int t = 0; t < 2; ++t)
+    {
+        // Whatever the sketch, the verified solution satisfies the full
+        // system.
+        CAROM::NNLSSolver nnls(nnls_tol, 0, 0, 1);
+        nnls.set_sketch(sketches[t], sketch_rows);
+        rom_sol = 0.0;
+        nnls.solve_parallel_with_scalapack(Gt, rhs_lb, rhs_ub, rom_sol);
+
+        // The solution comes from a sketched system, not the fallback to
+        // the full one.
+        EXPECT_GE(nnls.getNumSolvedConstraints(), sketch_rows);
+        EXPECT_LT(nnls.getNumSolvedConstraints(), nrow);
+
+        CAROM::Vector res(Gt.numColumns(), false);
+        Gt.transposeMult(rom_sol, res);
+        res -= rhs;
+        for (int k = 0; k < res.dim(); k++)
+        {
+            EXPECT_TRUE(abs(res(k)) < rel_tol * abs(rhs(k)) + nnls_tol);
+        }
+        for (int i = 0; i < rom_sol.dim(); ++i)
+        {
+            EXPECT_GE(rom_sol(i), 0.0);
+        }
+    }
+}
+
 int main(int argc, char* argv[])
 {
     ::testing::InitGoogleTest(&argc, argv);
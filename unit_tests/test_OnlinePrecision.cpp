@@ -0,0 +1,156 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2013-2024, Lawrence Livermore National Security, LLC
+ * and other libROM project developers. See the top-level COPYRIGHT
+ * file for details.
+ *
+ * SPDX-License-Identifier: (Apache-2.0 OR MIT)
+ *
+ *****************************************************************************/
+
+#ifdef CAROM_HAS_GTEST
+
+#include<gtest/gtest.h>
+#include "linalg/OnlineLinearAlgebra.h"
+#include "linalg/Matrix.h"
+#include "linalg/Vector.h"
+#include "algo/DMD.h"
+#include "algo/DMDPredictor.h"
+#include "utils/SyntheticSnapshots.h"
+#include "utils/mpi_utils.h"
+#include "mpi.h"
+#include <cmath>
+#include <vector>
+
+/**
+ * Simple smoke test to make sure Google Test is properly linked
+ */
+TEST(GoogleTestFramework, GoogleTestFrameworkFound) {
+    SUCCEED();
+}
+
+namespace {
+
+// The relative 2-norm difference between an online vector and a Vector.
+template <class Scalar>
+double relativeError(const CAROM::OnlineVector<Scalar>& x,
+                     const CAROM::Vector& reference)
+{
+    double diff = 0.0;
+    for (int i = 0; i < reference.dim(); ++i)
+        diff += std::pow(x(i) - reference(i), 2);
+    if (reference.distributed())
+        MPI_Allreduce(MPI_IN_PLACE, &diff, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    return std::sqrt(diff) / reference.norm();
+}
+
+}
+
+TEST(OnlinePrecisionTest, Test_lift_restrict)
+{
+    constexpr int num_total_rows = 300;
+    constexpr int num_modes = 8;
+    const int dim = CAROM::split_dimension(num_total_rows, MPI_COMM_WORLD);
+    CAROM::Matrix* basis = CAROM::synthetic_spatial_modes(dim, num_modes, 3);
+
+    CAROM::Vector reduced(num_modes, false);
+    for (int j = 0; j < num_modes; ++j)
+        reduced(j) = std::cos(1.0 + j);
+    CAROM::Vector* full = basis->mult(reduced);
+    CAROM::Vector* restricted = basis->transposeMult(*full);
+
+    CAROM::OnlineMatrix<float> basis_f(*basis);
+    CAROM::OnlineMatrix<double> basis_d(*basis);
+    EXPECT_TRUE(basis_f.distributed());
+    EXPECT_EQ(basis_f.numRows(), dim);
+    EXPECT_EQ(basis_f.numColumns(), num_modes);
+
+    CAROM::OnlineVector<float> reduced_f(reduced), full_f, restricted_f;
+    basis_f.mult(reduced_f, full_f);
+    basis_f.transposeMult(full_f, restricted_f);
+    EXPECT_TRUE(full_f.distributed());
+    EXPECT_FALSE(restricted_f.distributed());
+    EXPECT_LT(relativeError(full_f, *full), 1.0e-6);
+    EXPECT_LT(relativeError(restricted_f, *restricted), 1.0e-6);
+    EXPECT_NEAR(full_f.norm(), full->norm(), 1.0e-5);
+
+    CAROM::OnlineVector<double> reduced_d(reduced), full_d, restricted_d;
+    basis_d.mult(reduced_d, full_d);
+    basis_d.transposeMult(full_d, restricted_d);
+    EXPECT_LT(relativeError(full_d, *full), 1.0e-14);
+    EXPECT_LT(relativeError(restricted_d, *restricted), 1.0e-14);
+
+    // Converting back to double keeps the float values.
+    CAROM::Matrix basis_back(dim, num_modes, true);
+    basis_f.copyTo(basis_back);
+    for (int i = 0; i < dim; ++i)
+        for (int j = 0; j < num_modes; ++j)
+            EXPECT_EQ(basis_back(i, j), basis_f(i, j));
+
+    delete basis;
+    delete full;
+    delete restricted;
+}
+
+TEST(OnlinePrecisionTest, Test_DMD_predict)
+{
+    constexpr int num_total_rows = 200;
+    constexpr int num_samples = 20;
+    const int dim = CAROM::split_dimension(num_total_rows, MPI_COMM_WORLD);
+    const std::vector<std::complex<double>> eigs = {
+        0.98, std::polar(0.97, 0.3), std::polar(0.99, 0.1)
+    };
+    CAROM::Matrix* snapshots = CAROM::synthetic_dmd_snapshots(dim, num_samples,
+                               eigs);
+
+    CAROM::DMD dmd(dim, 0.1);
+    std::vector<double> sample(dim);
+    for (int j = 0; j < num_samples; ++j) {
+        for (int i = 0; i < dim; ++i)
+            sample[i] = snapshots->item(i, j);
+        dmd.takeSample(sample.data(), 0.1 * j);
+    }
+    dmd.train(5);
+
+    CAROM::DMDPredictor<float> predictor_f(dmd);
+    CAROM::DMDPredictor<double> predictor_d(dmd);
+    EXPECT_EQ(predictor_f.getDimension(), dmd.getDimension());
+
+    CAROM::OnlineVector<float> x_f;
+    CAROM::OnlineVector<double> x_d;
+    for (double t : {0.0, 0.55, 1.9, 3.0}) {
+        CAROM::Vector* x = dmd.predict(t);
+        predictor_f.predict(t, x_f);
+        predictor_d.predict(t, x_d);
+        EXPECT_EQ(x_f.dim(), dim);
+        EXPECT_LT(relativeError(x_d, *x), 1.0e-12);
+        EXPECT_LT(relativeError(x_f, *x), 1.0e-5);
+        delete x;
+    }
+
+    CAROM::Vector* dx = dmd.predict(1.0, 1);
+    predictor_f.predict(1.0, x_f, 1);
+    EXPECT_LT(relativeError(x_f, *dx), 1.0e-5);
+    delete dx;
+    delete snapshots;
+}
+
+int main(int argc, char* argv[])
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    MPI_Init(&argc, &argv);
+    int result = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return result;
+}
+
+#else // #ifndef CAROM_HAS_GTEST
+
+int main()
+{
+    std::cout << "libROM was compiled without Google Test support, so unit "
+              << "tests have been disabled. To enable unit tests, compile "
+              << "libROM with Google Test support." << std::endl;
+}
+
+#endif // #endif CAROM_HAS_GTEST
@@ -19,9 +19,12 @@
 #include<gtest/gtest.h>
 #include <mpi.h>
 #include "linalg/BasisGenerator.h"
+#include "linalg/SVDSelection.h"
 #include "utils/mpi_utils.h"
 #define _USE_MATH_DEFINES
 #include <cmath>
+#include <cstdio>
+#include <fstream>
 
 /**
  * Simple smoke test to make sure Google Test is properly linked
@@ -349,6 +352,196 @@ TEST(RandomizedSVDTest, Test_RandomizedSVDTransposedSmallerSubspace)
     }
 }
 
+TEST(RandomizedSVDTest, Test_AutoSVDSelection)
+{
+    int d_rank, d_num_procs;
+    MPI_Comm_rank(MPI_COMM_WORLD, &d_rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &d_num_procs);
+
+    constexpr int num_total_rows = 1000;
+    constexpr int num_samples = 200;
+    int d_num_rows = CAROM::split_dimension(num_total_rows, MPI_COMM_WORLD);
+    std::vector<int> row_offset;
+    CAROM::get_global_offsets(d_num_rows, row_offset, MPI_COMM_WORLD);
+
+    // A small basis of a tall snapshot matrix favors RandomizedSVD.
+    CAROM::Options options(d_num_rows, num_samples);
+    options.setMaxBasisDimension(5);
+    options.setAutoSVD(true);
+    CAROM::Options selected = CAROM::selectSVDBackend(options, false);
+    EXPECT_TRUE(selected.randomized);
+    EXPECT_EQ(selected.randomized_subspace_dim, 15);
+    EXPECT_FALSE(selected.auto_svd);
+
+    // A basis as large as the number of samples leaves nothing to sketch.
+    options.setMaxBasisDimension(num_samples);
+    selected = CAROM::selectSVDBackend(options, false);
+    EXPECT_FALSE(selected.randomized);
+
+    selected = CAROM::selectSVDBackend(options, true);
+    EXPECT_TRUE(selected.fast_update_brand);
+
+    // Cached costs override the default cost model.
+    const std::string calibration_file = "svd_calibration_test.txt";
+    if (d_rank == 0)
+    {
+        std::ofstream file(calibration_file);
+        file << d_num_procs << " 1.0 100.0" << std::endl;
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+    options.setMaxBasisDimension(5);
+    options.setAutoSVD(true, calibration_file);
+    selected = CAROM::selectSVDBackend(options, false);
+    EXPECT_FALSE(selected.randomized);
+    MPI_Barrier(MPI_COMM_WORLD);
+    if (d_rank == 0)
+    {
+        std::remove(calibration_file.c_str());
+    }
+
+    // The selected backend recovers the singular values of a rank 3 matrix.
+    options.setAutoSVD(true);
+    CAROM::BasisGenerator auto_sampler(options, false);
+    CAROM::Options static_options(d_num_rows, num_samples);
+    static_options.setMaxBasisDimension(5);
+    CAROM::BasisGenerator static_sampler(static_options, false);
+    std::vector<double> sample(d_num_rows);
+    for (int j = 0; j < num_samples; j++)
+    {
+        for (int i = 0; i < d_num_rows; i++)
+        {
+            const double x = 0.01 * (row_offset[d_rank] + i);
+            const double t = 0.05 * j;
+            sample[i] = std::sin(x) * std::cos(t) + x * x * std::sin(2.0 * t)
+                        + std::exp(-x) * t;
+        }
+        auto_sampler.takeSample(sample.data());
+        static_sampler.takeSample(sample.data());
+    }
+    const CAROM::Vector* sv = auto_sampler.getSingularValues();
+    const CAROM::Vector* sv_static = static_sampler.getSingularValues();
+    for (int i = 0; i < 3; i++) {
+        EXPECT_NEAR(sv->item(i), sv_static->item(i), 1e-8 * sv_static->item(0));
+    }
+}
+
+TEST(RandomizedSVDTest, Test_AdaptiveRandomizedSVD)
+{
+    int d_rank, d_num_procs;
+    MPI_Comm_rank(MPI_COMM_WORLD, &d_rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &d_num_procs);
+
+    // Snapshot matrices of rank 5, tall and wide, with singular values
+    // spread over four orders of magnitude.
+    constexpr int rank = 5;
+    constexpr int block_size = 2;
+    for (const int num_total_rows : {400, 30})
+    {
+        const int num_samples = 60;
+        int d_num_rows = CAROM::split_dimension(num_total_rows, MPI_COMM_WORLD);
+        std::vector<int> row_offset;
+        CAROM::get_global_offsets(d_num_rows, row_offset, MPI_COMM_WORLD);
+
+        CAROM::Options options(d_num_rows, num_samples);
+        options.setAdaptiveRandomizedSVD(true, 1.0e-10, block_size);
+        EXPECT_TRUE(options.randomized);
+        CAROM::BasisGenerator adaptive_sampler(options, false);
+        CAROM::Options static_options(d_num_rows, num_samples);
+        CAROM::BasisGenerator static_sampler(static_options, false);
+        std::vector<double> sample(d_num_rows);
+        for (int j = 0; j < num_samples; j++)
+        {
+            for (int i = 0; i < d_num_rows; i++)
+            {
+                const int row = row_offset[d_rank] + i;
+                sample[i] = 0.0;
+                for (int r = 0; r < rank; r++)
+                    sample[i] += std::pow(0.1, r) * std::cos(0.3 * (r + 1) * row + r)
+                                 * std::sin(0.2 * (r + 1) * j + 0.5);
+            }
+            adaptive_sampler.takeSample(sample.data());
+            static_sampler.takeSample(sample.data());
+        }
+
+        // The subspace stops growing within a block of the rank.
+        const CAROM::Vector* sv = adaptive_sampler.getSingularValues();
+        const CAROM::Vector* sv_static = static_sampler.getSingularValues();
+        EXPECT_GE(sv->dim(), rank);
+        EXPECT_LE(sv->dim(), rank + block_size);
+        for (int i = 0; i < rank; i++) {
+            EXPECT_NEAR(sv->item(i), sv_static->item(i), 1e-8 * sv_static->item(0));
+        }
+        if (num_total_rows > num_samples) {
+            EXPECT_EQ(adaptive_sampler.getSpatialBasis()->numRows(), d_num_rows);
+        }
+    }
+
+    // A loose tolerance keeps only the dominant directions.
+    constexpr int num_total_rows = 400;
+    constexpr int num_samples = 60;
+    int d_num_rows = CAROM::split_dimension(num_total_rows, MPI_COMM_WORLD);
+    std::vector<int> row_offset;
+    CAROM::get_global_offsets(d_num_rows, row_offset, MPI_COMM_WORLD);
+    CAROM::Options options(d_num_rows, num_samples);
+    options.setAdaptiveRandomizedSVD(true, 0.05, 1);
+    CAROM::BasisGenerator sampler(options, false);
+    std::vector<double> sample(d_num_rows);
+    for (int j = 0; j < num_samples; j++)
+    {
+        for (int i = 0; i < d_num_rows; i++)
+        {
+            const int row = row_offset[d_rank] + i;
+            sample[i] = 0.0;
+            for (int r = 0; r < rank; r++)
+                sample[i] += std::pow(0.1, r) * std::cos(0.3 * (r + 1) * row + r)
+                             * std::sin(0.2 * (r + 1) * j + 0.5);
+        }
+        sampler.takeSample(sample.data());
+    }
+    EXPECT_LT(sampler.getSingularValues()->dim(), rank);
+
+    // Without randomized_tol, the subspace keeps every singular value above
+    // the singular value cutoff, as the static SVD does, even when the
+    // residual of the subspace without it is far below the cutoff times the
+    // Frobenius norm of the snapshots. The snapshots are orthonormal
+    // directions, the first num_equal of which appear again after a small
+    // multiple of the last one, so that the debug sketch of the identity
+    // spans the large directions before the small one.
+    constexpr int num_equal = 30;
+    const double pi = 4.0 * std::atan(1.0);
+    CAROM::Options cutoff_options(d_num_rows, num_samples);
+    cutoff_options.setSingularValueTol(5.0e-4);
+    cutoff_options.setDebugMode(true);
+    cutoff_options.setAdaptiveRandomizedSVD(true, -1.0, 1);
+    CAROM::BasisGenerator cutoff_sampler(cutoff_options, false);
+    CAROM::Options static_options(d_num_rows, num_samples);
+    static_options.setSingularValueTol(5.0e-4);
+    CAROM::BasisGenerator static_sampler(static_options, false);
+    for (int j = 0; j < num_samples; j++)
+    {
+        const int r = j < num_equal ? j + 1 :
+                      (j == num_equal ? num_equal + 1 : j - num_equal);
+        const double weight = j == num_equal ? 1.5e-3 : 1.0;
+        for (int i = 0; i < d_num_rows; i++)
+        {
+            const int row = row_offset[d_rank] + i;
+            sample[i] = weight * std::sqrt(2.0 / num_total_rows)
+                        * std::cos(pi * r * (row + 0.5) / num_total_rows);
+        }
+        cutoff_sampler.takeSample(sample.data());
+        static_sampler.takeSample(sample.data());
+    }
+
+    // The singular values are within the residual norm of the exact ones.
+    const CAROM::Vector* sv = cutoff_sampler.getSingularValues();
+    const CAROM::Vector* sv_static = static_sampler.getSingularValues();
+    EXPECT_EQ(sv_static->dim(), num_equal + 1);
+    EXPECT_EQ(sv->dim(), sv_static->dim());
+    for (int i = 0; i < std::min(sv->dim(), sv_static->dim()); i++) {
+        EXPECT_NEAR(sv->item(i), sv_static->item(i), 5.0e-4 * sv_static->item(0));
+    }
+}
+
 int main(int argc, char* argv[])
 {
     ::testing::InitGoogleTest(&argc, argv);
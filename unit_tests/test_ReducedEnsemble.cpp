@@ -0,0 +1,186 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2013-2024, Lawrence Livermore National Security, LLC
+ * and other libROM project developers. See the top-level COPYRIGHT
+ * file for details.
+ *
+ * SPDX-License-Identifier: (Apache-2.0 OR MIT)
+ *
+ *****************************************************************************/
+
+#ifdef CAROM_HAS_GTEST
+
+#include<gtest/gtest.h>
+#include "linalg/ReducedEnsemble.h"
+#include "linalg/Matrix.h"
+#include "linalg/Vector.h"
+#include "mpi.h"
+#include <cmath>
+#include <vector>
+
+/**
+ * Simple smoke test to make sure Google Test is properly linked
+ */
+TEST(GoogleTestFramework, GoogleTestFrameworkFound) {
+    SUCCEED();
+}
+
+namespace {
+
+// A reduced operator of member b, with a zero leading entry for odd members
+// so that their factorizations need pivoting.
+CAROM::Matrix memberOperator(int k, int b)
+{
+    CAROM::Matrix A(k, k, false);
+    for (int i = 0; i < k; ++i)
+        for (int j = 0; j < k; ++j)
+            A(i, j) = std::sin(1.0 + i + 2.0 * j + 0.3 * b) - (i == j ? 2.0 : 0.0);
+    if (b % 2 == 1) A(0, 0) = 0.0;
+    return A;
+}
+
+CAROM::Vector memberVector(int k, int b, double shift)
+{
+    CAROM::Vector x(k, false);
+    for (int i = 0; i < k; ++i)
+        x(i) = std::cos(shift + i + 0.7 * b);
+    return x;
+}
+
+}
+
+TEST(ReducedEnsembleTest, Test_mult_and_solve)
+{
+    constexpr int k = 6;
+    constexpr int num_members = 9;
+    CAROM::ReducedEnsemble ensemble(k, num_members);
+    std::vector<double> x(k * num_members), y(k * num_members);
+    for (int b = 0; b < num_members; ++b) {
+        ensemble.setOperator(b, memberOperator(k, b));
+        CAROM::Vector xb = memberVector(k, b, 0.0);
+        for (int i = 0; i < k; ++i)
+            x[i * num_members + b] = xb(i);
+    }
+
+    ensemble.mult(x.data(), y.data());
+    for (int b = 0; b < num_members; ++b) {
+        CAROM::Vector xb = memberVector(k, b, 0.0);
+        CAROM::Vector* yb = memberOperator(k, b).mult(xb);
+        for (int i = 0; i < k; ++i)
+            EXPECT_NEAR(y[i * num_members + b], yb->item(i), 1.0e-13);
+        delete yb;
+    }
+
+    // Solve (2 I + 0.5 A) z = y and compare with the dense inverse.
+    ensemble.factorShiftedOperator(2.0, 0.5);
+    std::vector<double> z = y;
+    ensemble.solveShifted(z.data());
+    for (int b = 0; b < num_members; ++b) {
+        CAROM::Matrix S = memberOperator(k, b);
+        for (int i = 0; i < k; ++i) {
+            for (int j = 0; j < k; ++j)
+                S(i, j) *= 0.5;
+            S(i, i) += 2.0;
+        }
+        CAROM::Vector yb(k, false);
+        for (int i = 0; i < k; ++i)
+            yb(i) = y[i * num_members + b];
+        S.inverse();
+        CAROM::Vector* zb = S.mult(yb);
+        for (int i = 0; i < k; ++i)
+            EXPECT_NEAR(z[i * num_members + b], zb->item(i), 1.0e-12);
+        delete zb;
+    }
+}
+
+TEST(ReducedEnsembleTest, Test_time_steps)
+{
+    constexpr int k = 4;
+    constexpr int num_members = 5;
+    constexpr double dt = 0.01;
+    constexpr int num_steps = 20;
+
+    // Affine operators A_b = A_0 + mu_b A_1.
+    CAROM::Matrix A0 = memberOperator(k, 0);
+    CAROM::Matrix A1(k, k, false);
+    for (int i = 0; i < k; ++i)
+        for (int j = 0; j < k; ++j)
+            A1(i, j) = (i == j) ? -1.0 : 0.1 * (i - j);
+    CAROM::Matrix coefficients(num_members, 2, false);
+    for (int b = 0; b < num_members; ++b) {
+        coefficients(b, 0) = 1.0;
+        coefficients(b, 1) = 0.25 * b;
+    }
+
+    CAROM::ReducedEnsemble explicit_ensemble(k, num_members);
+    CAROM::ReducedEnsemble implicit_ensemble(k, num_members);
+    explicit_ensemble.setAffineOperator({&A0, &A1}, coefficients);
+    implicit_ensemble.setAffineOperator({&A0, &A1}, coefficients);
+    for (int b = 0; b < num_members; ++b) {
+        explicit_ensemble.setState(b, memberVector(k, b, 0.0));
+        implicit_ensemble.setState(b, memberVector(k, b, 0.0));
+        explicit_ensemble.setForcing(b, memberVector(k, b, 1.0));
+        implicit_ensemble.setForcing(b, memberVector(k, b, 1.0));
+    }
+    for (int n = 0; n < num_steps; ++n) {
+        explicit_ensemble.forwardEulerStep(dt);
+        implicit_ensemble.backwardEulerStep(dt);
+    }
+
+    // Reference: the same steps on each member with Matrix and Vector.
+    for (int b = 0; b < num_members; ++b) {
+        CAROM::Matrix A(k, k, false);
+        CAROM::Matrix implicit_matrix(k, k, false);
+        for (int i = 0; i < k; ++i) {
+            for (int j = 0; j < k; ++j) {
+                A(i, j) = A0(i, j) + coefficients(b, 1) * A1(i, j);
+                implicit_matrix(i, j) = (i == j ? 1.0 : 0.0) - dt * A(i, j);
+            }
+        }
+        implicit_matrix.inverse();
+
+        CAROM::Vector f = memberVector(k, b, 1.0);
+        CAROM::Vector x_explicit = memberVector(k, b, 0.0);
+        CAROM::Vector x_implicit = memberVector(k, b, 0.0);
+        for (int n = 0; n < num_steps; ++n) {
+            CAROM::Vector* Ax = A.mult(x_explicit);
+            for (int i = 0; i < k; ++i)
+                x_explicit(i) += dt * (Ax->item(i) + f(i));
+            delete Ax;
+
+            for (int i = 0; i < k; ++i)
+                x_implicit(i) += dt * f(i);
+            CAROM::Vector* next = implicit_matrix.mult(x_implicit);
+            x_implicit = *next;
+            delete next;
+        }
+
+        CAROM::Vector x(k, false);
+        explicit_ensemble.getState(b, x);
+        for (int i = 0; i < k; ++i)
+            EXPECT_NEAR(x(i), x_explicit(i), 1.0e-12);
+        implicit_ensemble.getState(b, x);
+        for (int i = 0; i < k; ++i)
+            EXPECT_NEAR(x(i), x_implicit(i), 1.0e-12);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    MPI_Init(&argc, &argv);
+    int result = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return result;
+}
+
+#else // #ifndef CAROM_HAS_GTEST
+
+int main()
+{
+    std::cout << "libROM was compiled without Google Test support, so unit "
+              << "tests have been disabled. To enable unit tests, compile "
+              << "libROM with Google Test support." << std::endl;
+}
+
+#endif // #endif CAROM_HAS_GTEST
@@ -0,0 +1,214 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2013-2024, Lawrence Livermore National Security, LLC
+ * and other libROM project developers. See the top-level COPYRIGHT
+ * file for details.
+ *
+ * SPDX-License-Identifier: (Apache-2.0 OR MIT)
+ *
+ *****************************************************************************/
+
+#ifdef CAROM_HAS_GTEST
+
+#include<gtest/gtest.h>
+#include "hyperreduction/ReducedJacobian.h"
+#include "linalg/Matrix.h"
+#include "mpi.h"
+#include <cmath>
+#include <vector>
+
+/**
+ * Simple smoke test to make sure Google Test is properly linked
+ */
+TEST(GoogleTestFramework, GoogleTestFrameworkFound) {
+    SUCCEED();
+}
+
+namespace {
+
+// A CSR pattern with a 5-point stencil on a num_rows x num_cols grid of
+// indices, with columns wrapped into [0, num_cols).
+void stencilPattern(int num_rows, int num_cols, std::vector<int>& row_ptr,
+                    std::vector<int>& col_ind)
+{
+    row_ptr.assign(1, 0);
+    col_ind.clear();
+    for (int i = 0; i < num_rows; ++i) {
+        for (int offset : {0, -1, 1, -7, 7}) {
+            const int j = i + offset;
+            if (0 <= j && j < num_cols)
+                col_ind.push_back(j);
+        }
+        row_ptr.push_back(col_ind.size());
+    }
+}
+
+void fillValues(int seed, std::vector<double>& values)
+{
+    for (size_t e = 0; e < values.size(); ++e)
+        values[e] = std::sin(0.37 * e + seed) + (e % 5 == 0 ? 2.0 : 0.0);
+}
+
+void fillBasis(CAROM::Matrix& B, double shift)
+{
+    for (int i = 0; i < B.numRows(); ++i)
+        for (int j = 0; j < B.numColumns(); ++j)
+            B(i, j) = std::cos(0.13 * (i + 1) * (j + 1) + shift);
+}
+
+// Computes Bt^T J Bc densely, using only the rows and columns of J mapped to
+// rows of Bt and Bc.
+void denseProjection(int num_rows, int num_cols,
+                     const std::vector<int>& row_ptr,
+                     const std::vector<int>& col_ind,
+                     const std::vector<double>& values,
+                     const CAROM::Matrix& Bt, const std::vector<int>& row_map,
+                     const CAROM::Matrix& Bc, const std::vector<int>& col_map,
+                     CAROM::Matrix& result)
+{
+    CAROM::Matrix J(num_rows, num_cols, false);
+    J = 0.0;
+    for (int i = 0; i < num_rows; ++i)
+        for (int e = row_ptr[i]; e < row_ptr[i + 1]; ++e)
+            J(i, col_ind[e]) += values[e];
+
+    CAROM::Matrix Pt(num_rows, Bt.numColumns(), false);
+    Pt = 0.0;
+    for (int i = 0; i < num_rows; ++i) {
+        const int r = row_map.empty() ? i : row_map[i];
+        if (r >= 0)
+            for (int a = 0; a < Bt.numColumns(); ++a)
+                Pt(i, a) = Bt(r, a);
+    }
+    CAROM::Matrix Pc(num_cols, Bc.numColumns(), false);
+    Pc = 0.0;
+    for (int j = 0; j < num_cols; ++j) {
+        const int r = col_map.empty() ? j : col_map[j];
+        if (r >= 0)
+            for (int b = 0; b < Bc.numColumns(); ++b)
+                Pc(j, b) = Bc(r, b);
+    }
+
+    CAROM::Matrix* JPc = J.mult(Pc);
+    Pt.transposeMult(*JPc, result);
+    delete JPc;
+}
+
+void expectNear(const CAROM::Matrix& A, const CAROM::Matrix& B)
+{
+    ASSERT_EQ(A.numRows(), B.numRows());
+    ASSERT_EQ(A.numColumns(), B.numColumns());
+    for (int i = 0; i < A.numRows(); ++i)
+        for (int j = 0; j < A.numColumns(); ++j)
+            EXPECT_NEAR(A(i, j), B(i, j), 1.0e-10);
+}
+
+}
+
+TEST(ReducedJacobianTest, Test_same_basis)
+{
+    // More rows than one block of the kernel.
+    constexpr int num_dofs = 150;
+    constexpr int num_modes = 6;
+    std::vector<int> row_ptr, col_ind;
+    stencilPattern(num_dofs, num_dofs, row_ptr, col_ind);
+    std::vector<double> values(col_ind.size());
+    CAROM::Matrix Bsp(num_dofs, num_modes, false);
+    fillBasis(Bsp, 0.0);
+
+    CAROM::ReducedJacobian kernel(num_dofs, row_ptr, col_ind, Bsp);
+    EXPECT_EQ(kernel.numNonzeros(), col_ind.size());
+    EXPECT_EQ(kernel.numRetainedNonzeros(), col_ind.size());
+    EXPECT_EQ(kernel.numTestColumns(), num_modes);
+    EXPECT_EQ(kernel.numTrialColumns(), num_modes);
+
+    // The pattern is reused for new values, as in a Newton iteration.
+    CAROM::Matrix Jr, expected;
+    const std::vector<int> identity;
+    for (int seed = 0; seed < 3; ++seed) {
+        fillValues(seed, values);
+        kernel.project(values.data(), Jr);
+        denseProjection(num_dofs, num_dofs, row_ptr, col_ind, values, Bsp,
+                        identity, Bsp, identity, expected);
+        expectNear(Jr, expected);
+    }
+}
+
+TEST(ReducedJacobianTest, Test_dof_map)
+{
+    // DOFs are permuted onto the rows of Bsp, and every fourth DOF has no
+    // basis row, like an essential DOF.
+    constexpr int num_dofs = 90;
+    constexpr int num_modes = 5;
+    std::vector<int> row_ptr, col_ind;
+    stencilPattern(num_dofs, num_dofs, row_ptr, col_ind);
+    std::vector<double> values(col_ind.size());
+    fillValues(1, values);
+
+    std::vector<int> dof_to_row(num_dofs, -1);
+    int num_basis_rows = 0;
+    for (int i = num_dofs - 1; i >= 0; --i)
+        if (i % 4 != 0)
+            dof_to_row[i] = num_basis_rows++;
+    CAROM::Matrix Bsp(num_basis_rows, num_modes, false);
+    fillBasis(Bsp, 0.5);
+
+    CAROM::ReducedJacobian kernel(num_dofs, row_ptr, col_ind, Bsp, dof_to_row);
+    EXPECT_LT(kernel.numRetainedNonzeros(), kernel.numNonzeros());
+
+    CAROM::Matrix Jr, expected;
+    kernel.project(values.data(), Jr);
+    denseProjection(num_dofs, num_dofs, row_ptr, col_ind, values, Bsp,
+                    dof_to_row, Bsp, dof_to_row, expected);
+    expectNear(Jr, expected);
+}
+
+TEST(ReducedJacobianTest, Test_test_trial_bases)
+{
+    // A rectangular block of a mixed system, with different test and trial
+    // bases.
+    constexpr int num_rows = 70;
+    constexpr int num_cols = 100;
+    std::vector<int> row_ptr, col_ind;
+    stencilPattern(num_rows, num_cols, row_ptr, col_ind);
+    std::vector<double> values(col_ind.size());
+    fillValues(2, values);
+
+    CAROM::Matrix Bt(num_rows, 3, false);
+    CAROM::Matrix Bc(num_cols, 7, false);
+    fillBasis(Bt, 0.2);
+    fillBasis(Bc, 0.9);
+    std::vector<int> col_to_trial(num_cols);
+    for (int j = 0; j < num_cols; ++j)
+        col_to_trial[j] = (j * 37) % num_cols;
+
+    CAROM::ReducedJacobian kernel(num_rows, num_cols, row_ptr, col_ind,
+                                  Bt, std::vector<int>(), Bc, col_to_trial);
+    CAROM::Matrix Jr, expected;
+    kernel.project(values.data(), Jr);
+    EXPECT_EQ(Jr.numRows(), 3);
+    EXPECT_EQ(Jr.numColumns(), 7);
+    denseProjection(num_rows, num_cols, row_ptr, col_ind, values, Bt,
+                    std::vector<int>(), Bc, col_to_trial, expected);
+    expectNear(Jr, expected);
+}
+
+int main(int argc, char* argv[])
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    MPI_Init(&argc, &argv);
+    int result = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return result;
+}
+
+#else // #ifndef CAROM_HAS_GTEST
+
+int main()
+{
+    std::cout << "libROM was compiled without Google Test support, so unit "
+              << "tests have been disabled. To enable unit tests, compile "
+              << "libROM with Google Test support." << std::endl;
+}
+
+#endif // #endif CAROM_HAS_GTEST
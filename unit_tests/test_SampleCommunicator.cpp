@@ -0,0 +1,162 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2013-2024, Lawrence Livermore National Security, LLC
+ * and other libROM project developers. See the top-level COPYRIGHT
+ * file for details.
+ *
+ * SPDX-License-Identifier: (Apache-2.0 OR MIT)
+ *
+ *****************************************************************************/
+
+#ifdef CAROM_HAS_GTEST
+
+#include<gtest/gtest.h>
+#include "hyperreduction/SampleCommunicator.h"
+#include "linalg/Matrix.h"
+#include "linalg/Vector.h"
+#include "utils/mpi_utils.h"
+#include "mpi.h"
+#include <vector>
+
+/**
+ * Simple smoke test to make sure Google Test is properly linked
+ */
+TEST(GoogleTestFramework, GoogleTestFrameworkFound) {
+    SUCCEED();
+}
+
+TEST(SampleCommunicatorTest, Test_migrate_and_reduce)
+{
+    int rank, num_procs;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+
+    // Each rank owns a few rows of a distributed basis, with entries encoding
+    // their global row and column.
+    const int num_cols = 3;
+    const int num_local_rows = 4 + rank;
+    std::vector<int> row_offsets;
+    CAROM::get_global_offsets(num_local_rows, row_offsets);
+
+    CAROM::Matrix B(num_local_rows, num_cols, true);
+    for (int i = 0; i < num_local_rows; ++i) {
+        for (int j = 0; j < num_cols; ++j) {
+            B(i, j) = 10.0 * (row_offsets[rank] + i) + j;
+        }
+    }
+
+    // An uneven set of samples, empty on odd ranks.
+    std::vector<int> sampled_rows;
+    if (rank % 2 == 0) {
+        for (int i = 1; i < num_local_rows; i += 2) {
+            sampled_rows.push_back(i);
+        }
+    }
+    const int num_local_samples = static_cast<int>(sampled_rows.size());
+    std::vector<double> weights(num_local_samples);
+    std::vector<int> global_rows(num_local_samples);
+    for (int i = 0; i < num_local_samples; ++i) {
+        global_rows[i] = row_offsets[rank] + sampled_rows[i];
+        weights[i] = 0.5 * global_rows[i];
+    }
+
+    std::vector<int> sample_offsets;
+    const int num_samples = CAROM::get_global_offsets(num_local_samples,
+                            sample_offsets);
+
+    const int samples_per_proc = 2;
+    CAROM::SampleCommunicator comm(num_local_samples, samples_per_proc);
+    EXPECT_EQ(comm.numSamples(), num_samples);
+    const int num_active = std::min(num_procs,
+                                    (num_samples + samples_per_proc - 1) / samples_per_proc);
+    EXPECT_EQ(comm.getNumProcs(), num_active);
+    EXPECT_EQ(comm.isActive(), rank < num_active);
+
+    int total_local_samples = comm.numLocalSamples();
+    MPI_Allreduce(MPI_IN_PLACE, &total_local_samples, 1, MPI_INT, MPI_SUM,
+                  MPI_COMM_WORLD);
+    EXPECT_EQ(total_local_samples, num_samples);
+
+    CAROM::Matrix* B_sampled = comm.migrateRows(B, sampled_rows);
+    std::vector<double> migrated_weights;
+    std::vector<int> migrated_rows;
+    comm.migrateValues(weights, migrated_weights);
+    comm.migrateValues(global_rows, migrated_rows);
+
+    if (!comm.isActive()) {
+        EXPECT_TRUE(B_sampled == NULL);
+        EXPECT_EQ(migrated_weights.size(), 0);
+        EXPECT_EQ(migrated_rows.size(), 0);
+    }
+    else {
+        int comm_size;
+        MPI_Comm_size(comm.getComm(), &comm_size);
+        EXPECT_EQ(comm_size, num_active);
+
+        const int n = comm.numLocalSamples();
+        EXPECT_GT(n, 0);
+        ASSERT_TRUE(B_sampled != NULL);
+        EXPECT_FALSE(B_sampled->distributed());
+        EXPECT_EQ(B_sampled->numRows(), n);
+        EXPECT_EQ(B_sampled->numColumns(), num_cols);
+        ASSERT_EQ(migrated_rows.size(), n);
+        ASSERT_EQ(migrated_weights.size(), n);
+
+        // Samples arrive in global sample order, which is increasing in the
+        // global row for this sampling.
+        for (int i = 0; i < n; ++i) {
+            const int g = migrated_rows[i];
+            if (i > 0) {
+                EXPECT_LT(migrated_rows[i - 1], g);
+            }
+            EXPECT_DOUBLE_EQ(migrated_weights[i], 0.5 * g);
+            for (int j = 0; j < num_cols; ++j) {
+                EXPECT_DOUBLE_EQ(B_sampled->item(i, j), 10.0 * g + j);
+            }
+        }
+
+        // The reduced weighted sum agrees with the one on the original
+        // layout.
+        CAROM::Vector w(n, false);
+        for (int i = 0; i < n; ++i) {
+            w(i) = migrated_weights[i];
+        }
+        CAROM::Vector result;
+        comm.transposeMult(*B_sampled, w, result);
+        EXPECT_EQ(result.dim(), num_cols);
+
+        for (int j = 0; j < num_cols; ++j) {
+            double expected = 0.0;
+            for (int p = 0; p < num_procs; p += 2) {
+                const int rows_p = 4 + p;
+                for (int i = 1; i < rows_p; i += 2) {
+                    const int g = row_offsets[p] + i;
+                    expected += (10.0 * g + j) * 0.5 * g;
+                }
+            }
+            EXPECT_NEAR(result(j), expected, 1.0e-12 * std::abs(expected));
+        }
+    }
+
+    delete B_sampled;
+}
+
+int main(int argc, char* argv[])
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    MPI_Init(&argc, &argv);
+    int result = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return result;
+}
+
+#else // #ifndef CAROM_HAS_GTEST
+
+int main()
+{
+    std::cout << "libROM was compiled without Google Test support, so unit "
+              << "tests have been disabled. To enable unit tests, compile "
+              << "libROM with Google Test support." << std::endl;
+}
+
+#endif // #endif CAROM_HAS_GTEST
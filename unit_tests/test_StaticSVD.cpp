@@ -321,6 +321,76 @@ TEST(StaticSVDTest, Test_StaticSVDClass)
     }
 }
 
+TEST(StaticSVDTest, Test_StaticSVDWeighted)
+{
+    // Get the rank of this process, and the number of processors.
+    int mpi_init, d_rank, d_num_procs;
+    MPI_Initialized(&mpi_init);
+    if (mpi_init == 0) {
+        MPI_Init(nullptr, nullptr);
+    }
+
+    MPI_Comm_rank(MPI_COMM_WORLD, &d_rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &d_num_procs);
+
+    constexpr int num_total_rows = 5;
+    int d_num_rows = CAROM::split_dimension(num_total_rows, MPI_COMM_WORLD);
+    std::vector<int> row_offset(d_num_procs + 1);
+    const int total_rows = CAROM::get_global_offsets(d_num_rows, row_offset,
+                           MPI_COMM_WORLD);
+    EXPECT_EQ(total_rows, num_total_rows);
+
+    double samples[3][5] = {
+        {0.5377, 1.8339, -2.2588, 0.8622, 0.3188},
+        {-1.3077, -0.4336, 0.3426, 3.5784, 2.7694},
+        {-1.3499, 3.0349, 0.7254, -0.0631, 0.7147}
+    };
+    double weight[5] = {0.5, 2.0, 1.0, 3.0, 0.25};
+
+    std::vector<double> local_weight(weight + row_offset[d_rank],
+                                     weight + row_offset[d_rank + 1]);
+
+    CAROM::Options svd_options = CAROM::Options(d_num_rows, 3);
+    svd_options.setMaxBasisDimension(num_total_rows);
+    svd_options.setRandomizedSVD(false);
+    svd_options.setInnerProductWeight(local_weight);
+    CAROM::BasisGenerator sampler(svd_options, false);
+    for (int k = 0; k < 3; k++)
+        sampler.takeSample(&samples[k][row_offset[d_rank]]);
+
+    const CAROM::Matrix* d_basis = sampler.getSpatialBasis();
+    const CAROM::Matrix* d_basis_right = sampler.getTemporalBasis();
+    const CAROM::Vector* sv = sampler.getSingularValues();
+    EXPECT_EQ(d_basis->numRows(), d_num_rows);
+    EXPECT_EQ(d_basis->numColumns(), 3);
+
+    // The basis is orthonormal in the weighted inner product.
+    double gram[9];
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            gram[3 * i + j] = 0.0;
+            for (int r = 0; r < d_num_rows; r++)
+                gram[3 * i + j] += d_basis->item(r, i) * local_weight[r] *
+                                   d_basis->item(r, j);
+        }
+    }
+    MPI_Allreduce(MPI_IN_PLACE, gram, 9, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++)
+            EXPECT_NEAR(gram[3 * i + j], i == j ? 1.0 : 0.0, 1e-12);
+
+    // The basis, singular values and temporal basis reproduce the snapshots.
+    for (int r = 0; r < d_num_rows; r++) {
+        for (int k = 0; k < 3; k++) {
+            double val = 0.0;
+            for (int i = 0; i < 3; i++)
+                val += d_basis->item(r, i) * sv->item(i) *
+                       d_basis_right->item(k, i);
+            EXPECT_NEAR(val, samples[k][row_offset[d_rank] + r], 1e-10);
+        }
+    }
+}
+
 TEST(StaticSVDTest, Test_StaticSVDTranspose)
 {
     // Get the rank of this process, and the number of processors.
@@ -0,0 +1,159 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2013-2024, Lawrence Livermore National Security, LLC
+ * and other libROM project developers. See the top-level COPYRIGHT
+ * file for details.
+ *
+ * SPDX-License-Identifier: (Apache-2.0 OR MIT)
+ *
+ *****************************************************************************/
+
+#ifdef CAROM_HAS_GTEST
+
+#include<gtest/gtest.h>
+#include "utils/SyntheticSnapshots.h"
+#include "utils/mpi_utils.h"
+#include "linalg/BasisGenerator.h"
+#include "linalg/Matrix.h"
+#include "algo/DMD.h"
+#include "mpi.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+/**
+ * Simple smoke test to make sure Google Test is properly linked
+ */
+TEST(GoogleTestFramework, GoogleTestFrameworkFound) {
+    SUCCEED();
+}
+
+TEST(SyntheticSnapshotsTest, Test_counter_rng)
+{
+    EXPECT_EQ(CAROM::counter_uniform(7, 1, 12345),
+              CAROM::counter_uniform(7, 1, 12345));
+    EXPECT_NE(CAROM::counter_uniform(7, 1, 12345),
+              CAROM::counter_uniform(7, 2, 12345));
+    EXPECT_NE(CAROM::counter_uniform(7, 1, 12345),
+              CAROM::counter_uniform(8, 1, 12345));
+
+    constexpr int n = 200000;
+    double umin = 1.0, umax = 0.0, mean = 0.0, var = 0.0;
+    for (int i = 0; i < n; ++i) {
+        const double u = CAROM::counter_uniform(3, 0, i);
+        umin = std::min(umin, u);
+        umax = std::max(umax, u);
+        const double z = CAROM::counter_normal(3, 0, i);
+        mean += z;
+        var += z * z;
+    }
+    mean /= n;
+    var = var / n - mean * mean;
+    EXPECT_GT(umin, 0.0);
+    EXPECT_LT(umax, 1.0);
+    EXPECT_NEAR(mean, 0.0, 0.01);
+    EXPECT_NEAR(var, 1.0, 0.02);
+}
+
+TEST(SyntheticSnapshotsTest, Test_low_rank_snapshots)
+{
+    constexpr int num_total_rows = 60;
+    constexpr int num_samples = 20;
+    const int dim = CAROM::split_dimension(num_total_rows, MPI_COMM_WORLD);
+    const std::vector<double> sv = CAROM::geometric_singular_values(5, 0.5);
+
+    CAROM::Matrix* snapshots = CAROM::synthetic_low_rank_snapshots(dim,
+                               num_samples, sv);
+    EXPECT_EQ(snapshots->numRows(), dim);
+    EXPECT_EQ(snapshots->numColumns(), num_samples);
+
+    CAROM::Options options(dim, num_samples);
+    options.setMaxBasisDimension(num_samples);
+    CAROM::BasisGenerator generator(options, false);
+    std::vector<double> sample(dim);
+    for (int j = 0; j < num_samples; ++j) {
+        for (int i = 0; i < dim; ++i)
+            sample[i] = snapshots->item(i, j);
+        generator.takeSample(sample.data());
+    }
+    const CAROM::Vector* computed_sv = generator.getSingularValues();
+    for (int i = 0; i < 5; ++i)
+        EXPECT_NEAR(computed_sv->item(i), sv[i], 1.0e-12);
+    for (int i = 5; i < computed_sv->dim(); ++i)
+        EXPECT_NEAR(computed_sv->item(i), 0.0, 1.0e-12);
+    delete snapshots;
+
+    // Pure noise has the prescribed variance.
+    CAROM::Matrix* noise = CAROM::synthetic_low_rank_snapshots(dim, 50,
+                           std::vector<double>(), 0.1);
+    double sum2 = 0.0;
+    for (int i = 0; i < dim; ++i)
+        for (int j = 0; j < 50; ++j)
+            sum2 += noise->item(i, j) * noise->item(i, j);
+    MPI_Allreduce(MPI_IN_PLACE, &sum2, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    EXPECT_NEAR(sum2 / (num_total_rows * 50), 0.01, 0.001);
+    delete noise;
+}
+
+TEST(SyntheticSnapshotsTest, Test_dmd_snapshots)
+{
+    constexpr int num_total_rows = 40;
+    constexpr int num_samples = 12;
+    const int dim = CAROM::split_dimension(num_total_rows, MPI_COMM_WORLD);
+    const std::vector<std::complex<double>> eigs = {
+        0.9, std::polar(0.8, 0.5), std::polar(0.95, 0.2)
+    };
+
+    CAROM::Matrix* snapshots = CAROM::synthetic_dmd_snapshots(dim, num_samples,
+                               eigs);
+
+    CAROM::DMD dmd(dim, 1.0);
+    std::vector<double> sample(dim);
+    for (int j = 0; j < num_samples; ++j) {
+        for (int i = 0; i < dim; ++i)
+            sample[i] = snapshots->item(i, j);
+        dmd.takeSample(sample.data(), j);
+    }
+    dmd.train(5);
+
+    // The eigenvalues and their conjugates, sorted by real part.
+    std::vector<std::complex<double>> expected;
+    for (auto e : eigs) {
+        expected.push_back(e);
+        if (e.imag() > 0.0) expected.push_back(std::conj(e));
+    }
+    std::vector<std::complex<double>> computed = dmd.getEigs();
+    ASSERT_EQ(computed.size(), expected.size());
+    auto less = [](const std::complex<double>& a, const std::complex<double>& b) {
+        return a.real() < b.real() ||
+               (a.real() == b.real() && a.imag() < b.imag());
+    };
+    std::sort(expected.begin(), expected.end(), less);
+    std::sort(computed.begin(), computed.end(), less);
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_NEAR(computed[i].real(), expected[i].real(), 1.0e-10);
+        EXPECT_NEAR(std::abs(computed[i].imag()), std::abs(expected[i].imag()),
+                    1.0e-10);
+    }
+    delete snapshots;
+}
+
+int main(int argc, char* argv[])
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    MPI_Init(&argc, &argv);
+    int result = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return result;
+}
+
+#else // #ifndef CAROM_HAS_GTEST
+
+int main()
+{
+    std::cout << "libROM was compiled without Google Test support, so unit "
+              << "tests have been disabled. To enable unit tests, compile "
+              << "libROM with Google Test support." << std::endl;
+}
+
+#endif // #endif CAROM_HAS_GTEST
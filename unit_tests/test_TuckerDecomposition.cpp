@@ -0,0 +1,191 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2013-2024, Lawrence Livermore National Security, LLC
+ * and other libROM project developers. See the top-level COPYRIGHT
+ * file for details.
+ *
+ * SPDX-License-Identifier: (Apache-2.0 OR MIT)
+ *
+ *****************************************************************************/
+
+#ifdef CAROM_HAS_GTEST
+
+#include<gtest/gtest.h>
+#include "linalg/TuckerDecomposition.h"
+#include "linalg/Matrix.h"
+#include "utils/mpi_utils.h"
+#include "mpi.h"
+#include <cmath>
+#include <vector>
+
+/**
+ * Simple smoke test to make sure Google Test is properly linked
+ */
+TEST(GoogleTestFramework, GoogleTestFrameworkFound) {
+    SUCCEED();
+}
+
+TEST(TuckerDecompositionTest, Test_low_rank_tensor)
+{
+    int rank, num_procs;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+
+    constexpr int num_total_rows = 40;
+    constexpr int num_time_steps = 25;
+    constexpr int num_params = 6;
+    const int dim = CAROM::split_dimension(num_total_rows, MPI_COMM_WORLD);
+    std::vector<int> row_offsets;
+    CAROM::get_global_offsets(dim, row_offsets, MPI_COMM_WORLD);
+
+    // A tensor of multilinear rank (3, 2, 2). The first time step is zero.
+    auto f = [](int i, double x) {
+        return std::cos((i + 1) * x) + 0.1 * i * x;
+    };
+    auto h = [](int j, double t) {
+        return std::sin((j + 1) * t) * (1.0 + j * t);
+    };
+    auto q = [](int k, double mu) {
+        return k == 0 ? 1.0 + mu : mu * mu;
+    };
+    auto g = [](int i, int j, int k) {
+        return 1.0 / (1 + i + 2 * j + 3 * k);
+    };
+    auto X = [&](int row, int t, int p) {
+        const double x = 0.1 * row;
+        const double time = 0.05 * t;
+        const double mu = 0.3 * p;
+        double val = 0.0;
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 2; ++j)
+                for (int k = 0; k < 2; ++k)
+                    val += g(i, j, k) * f(i, x) * h(j, time) * q(k, mu);
+        return val;
+    };
+
+    CAROM::TuckerDecomposition tucker(dim, num_time_steps, 1.0e-10);
+    for (int p = 0; p < num_params; ++p) {
+        CAROM::Matrix snapshots(dim, num_time_steps, true);
+        for (int i = 0; i < dim; ++i)
+            for (int t = 0; t < num_time_steps; ++t)
+                snapshots(i, t) = X(row_offsets[rank] + i, t, p);
+        tucker.addParameterSnapshots(snapshots);
+    }
+    tucker.compute();
+
+    EXPECT_EQ(tucker.numParameters(), num_params);
+    const CAROM::Matrix* Us = tucker.getSpatialFactor();
+    const CAROM::Matrix* Ut = tucker.getTemporalFactor();
+    const CAROM::Matrix* Up = tucker.getParameterFactor();
+    EXPECT_EQ(Us->numColumns(), 3);
+    EXPECT_EQ(Ut->numColumns(), 2);
+    EXPECT_EQ(Up->numColumns(), 2);
+    EXPECT_EQ(Us->numRows(), dim);
+    EXPECT_EQ(Ut->numRows(), num_time_steps);
+    EXPECT_EQ(Up->numRows(), num_params);
+
+    // The decomposition reproduces the snapshots.
+    double err2 = 0.0, norm2 = 0.0;
+    for (int p = 0; p < num_params; ++p) {
+        CAROM::Matrix* approx = tucker.getParameterSnapshots(p);
+        for (int i = 0; i < dim; ++i) {
+            for (int t = 0; t < num_time_steps; ++t) {
+                const double x = X(row_offsets[rank] + i, t, p);
+                err2 += std::pow(approx->item(i, t) - x, 2);
+                norm2 += x * x;
+            }
+        }
+        delete approx;
+    }
+    MPI_Allreduce(MPI_IN_PLACE, &err2, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    MPI_Allreduce(MPI_IN_PLACE, &norm2, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    EXPECT_LT(std::sqrt(err2 / norm2), 1.0e-9);
+
+    // The space-time basis vectors are orthonormal space-time products.
+    CAROM::Matrix* s_basis = NULL;
+    CAROM::Matrix* t_basis = NULL;
+    tucker.getSpaceTimeBasis(4, s_basis, t_basis);
+    EXPECT_EQ(s_basis->numColumns(), 4);
+    EXPECT_EQ(t_basis->numColumns(), 4);
+    CAROM::Matrix* s_gram = s_basis->transposeMult(s_basis);
+    CAROM::Matrix* t_gram = t_basis->transposeMult(t_basis);
+    for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 4; ++j)
+            EXPECT_NEAR(s_gram->item(i, j) * t_gram->item(i, j),
+                        i == j ? 1.0 : 0.0, 1.0e-12);
+
+    delete s_gram;
+    delete t_gram;
+    delete s_basis;
+    delete t_basis;
+}
+
+TEST(TuckerDecompositionTest, Test_max_ranks)
+{
+    int rank, num_procs;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+
+    constexpr int num_total_rows = 30;
+    constexpr int num_time_steps = 8;
+    constexpr int num_params = 5;
+    const int dim = CAROM::split_dimension(num_total_rows, MPI_COMM_WORLD);
+    std::vector<int> row_offsets;
+    CAROM::get_global_offsets(dim, row_offsets, MPI_COMM_WORLD);
+
+    CAROM::TuckerDecomposition tucker(dim, num_time_steps, 0.0, 4, 3, 2);
+    for (int p = 0; p < num_params; ++p) {
+        CAROM::Matrix snapshots(dim, num_time_steps, true);
+        for (int i = 0; i < dim; ++i)
+            for (int t = 0; t < num_time_steps; ++t)
+                snapshots(i, t) = std::sin(0.7 * (row_offsets[rank] + i + 1) *
+                                           (t + 1) + 0.3 * p * p);
+        tucker.addParameterSnapshots(snapshots);
+    }
+    tucker.compute();
+
+    const CAROM::Matrix* Us = tucker.getSpatialFactor();
+    const CAROM::Matrix* Ut = tucker.getTemporalFactor();
+    const CAROM::Matrix* Up = tucker.getParameterFactor();
+    EXPECT_EQ(Us->numColumns(), 4);
+    EXPECT_EQ(Ut->numColumns(), 3);
+    EXPECT_EQ(Up->numColumns(), 2);
+
+    // The factors have orthonormal columns.
+    CAROM::Matrix* UsUs = Us->transposeMult(Us);
+    CAROM::Matrix* UtUt = Ut->transposeMult(Ut);
+    CAROM::Matrix* UpUp = Up->transposeMult(Up);
+    for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 4; ++j)
+            EXPECT_NEAR(UsUs->item(i, j), i == j ? 1.0 : 0.0, 1.0e-12);
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j)
+            EXPECT_NEAR(UtUt->item(i, j), i == j ? 1.0 : 0.0, 1.0e-12);
+    for (int i = 0; i < 2; ++i)
+        for (int j = 0; j < 2; ++j)
+            EXPECT_NEAR(UpUp->item(i, j), i == j ? 1.0 : 0.0, 1.0e-12);
+
+    delete UsUs;
+    delete UtUt;
+    delete UpUp;
+}
+
+int main(int argc, char* argv[])
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    MPI_Init(&argc, &argv);
+    int result = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return result;
+}
+
+#else // #ifndef CAROM_HAS_GTEST
+
+int main()
+{
+    std::cout << "libROM was compiled without Google Test support, so unit "
+              << "tests have been disabled. To enable unit tests, compile "
+              << "libROM with Google Test support." << std::endl;
+}
+
+#endif // #endif CAROM_HAS_GTEST
@@ -15,6 +15,7 @@
 //              dim * number of processors is constant.
 
 #include "linalg/BasisGenerator.h"
+#include "utils/SyntheticSnapshots.h"
 
 #include "mpi.h"
 
@@ -44,28 +45,18 @@ main(
         .setIncrementalSVD(1.0e-6, 1.0e-2, 1.0e-20, 10.001, true), true
     );
 
-    // Initialize random number generator.
-    srand(1);
-
     // Allocate an array for each sample.
     double** M = new double* [num_samples];
     for (int i = 0; i < num_samples; ++i) {
         M[i] = new double [dim];
     }
 
-    // Call the random number generator enough times so that this processor
-    // generates it's part of the global sample.
-    for (int i = 0; i < dim*num_samples*rank; ++i) {
-        double random = rand();
-        random = random/RAND_MAX;
-    }
-
-    // Fill in the samples.
+    // Fill in this processor's part of the global samples. The counter-based
+    // generator computes each entry from its global index directly.
     for (int i = 0; i < dim; ++i) {
         for (int j = 0; j < num_samples; ++j) {
-            double random = rand();
-            random = random/RAND_MAX;
-            M[j][i] = random;
+            M[j][i] = CAROM::counter_uniform(1, 0,
+                                             (static_cast<uint64_t>(rank) * dim + i) * num_samples + j);
         }
     }
 